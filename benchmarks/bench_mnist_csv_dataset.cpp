@@ -0,0 +1,139 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <shared_mutex>
+#include <string>
+
+#include "include/mnistcsvdataset.hpp"
+#include "include/syntheticmnist.hpp"
+
+namespace {
+
+constexpr char kCsvPath[] = "bench_mnist_dataset.csv";
+constexpr size_t kEntries = 10000;
+// Overrides kEntries, e.g. to load millions of rows
+constexpr char kEntriesVariable[] = "BENCH_MNIST_ROWS";
+
+// A synthetic data set and its cache, written once per run and removed
+// again at exit
+const MnistCsvDataSet& dataset() {
+    static const MnistCsvDataSet instance = [] {
+        syntheticmnist::Options options;
+        options.rows = kEntries;
+        if (const char* rows = std::getenv(kEntriesVariable)) {
+            options.rows = std::strtoull(rows, nullptr, 10);
+        }
+        syntheticmnist::writeCsv(kCsvPath, options);
+        syntheticmnist::writeCache(kCsvPath, options);
+        return MnistCsvDataSet(kCsvPath, 0);
+    }();
+    static const struct Cleanup {
+        ~Cleanup() {
+            std::remove(kCsvPath);
+            std::remove(MnistCsvDataSet::cachePath(kCsvPath).c_str());
+        }
+    } cleanup;
+
+    return instance;
+}
+
+// The accessors as they were before the data set became immutable: a
+// shared lock per call, i.e. two atomic read-modify-writes on one shared
+// cache line
+class LockedReader {
+ public:
+    explicit LockedReader(const MnistCsvDataSet& aDataSet)
+        : m_dataSet(aDataSet) {}
+
+    size_t size() const {
+        std::shared_lock lock(m_mutex);
+        return m_dataSet.size();
+    }
+
+    const MnistCsvDataSet::Entry_t& operator[](size_t aIndex) const {
+        std::shared_lock lock(m_mutex);
+        return m_dataSet[aIndex];
+    }
+
+ private:
+    const MnistCsvDataSet& m_dataSet;
+    mutable std::shared_mutex m_mutex;
+};
+
+// Touches every entry the way a training epoch does
+template <typename Reader>
+void readAll(benchmark::State& aState, const Reader& aReader) {
+    for (auto _ : aState) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < aReader.size(); ++i) {
+            const auto& entry = aReader[i];
+            sum += entry.first + entry.second[i % entry.second.size()];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    aState.SetItemsProcessed(aState.iterations() * aReader.size());
+}
+
+// Parses the whole file on aState.range(0) threads; the bytes processed
+// give the load speed per MB
+void BM_Load(benchmark::State& aState) {
+    dataset();  // Writes the file
+    const size_t threads = static_cast<size_t>(aState.range(0));
+    const auto bytes = std::filesystem::file_size(kCsvPath);
+
+    for (auto _ : aState) {
+        const MnistCsvDataSet loaded(kCsvPath, threads);
+        if (!loaded.isLoaded()) {
+            aState.SkipWithError("Unable to load the data set");
+            break;
+        }
+        benchmark::DoNotOptimize(loaded.size());
+    }
+    aState.SetBytesProcessed(aState.iterations() * bytes);
+}
+
+// Maps the binary cache instead of parsing the file
+void BM_LoadCached(benchmark::State& aState) {
+    dataset();  // Writes the files
+    const auto bytes = std::filesystem::file_size(kCsvPath);
+
+    for (auto _ : aState) {
+        const MnistCsvDataSet loaded(kCsvPath, 1, true);
+        if (!loaded.isCached()) {
+            aState.SkipWithError("Unable to load the cache");
+            break;
+        }
+        benchmark::DoNotOptimize(loaded.size());
+    }
+    aState.SetBytesProcessed(aState.iterations() * bytes);
+}
+
+void BM_ReadLockFree(benchmark::State& aState) {
+    readAll(aState, dataset());
+}
+
+void BM_ReadSharedLock(benchmark::State& aState) {
+    static const LockedReader reader(dataset());
+    readAll(aState, reader);
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_Load)
+    ->ArgName("threads")
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_LoadCached)->UseRealTime();
+BENCHMARK(BM_ReadLockFree)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ReadSharedLock)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "include/mnistcsvdataset.hpp"
+#include "include/mnistimage.hpp"
+
+namespace {
+
+// A light drawing with a dark stroke off its center, aScale pixels of it
+// per MNIST pixel like the canvas of DrawWidget
+std::vector<uint8_t> drawing(size_t aScale) {
+    const size_t side = aScale * mnistimage::kSide;
+    std::vector<uint8_t> pixels(side * side, 255);
+    for (size_t y = side / 5; y < side * 3 / 5; ++y) {
+        for (size_t x = side / 4; x < side / 4 + side / 10; ++x) {
+            pixels[y * side + x] = 0;
+        }
+    }
+    return pixels;
+}
+
+// aState.range(0) is the scale; DrawWidget draws at 10
+void BM_Downsample(benchmark::State& aState) {
+    const size_t scale = static_cast<size_t>(aState.range(0));
+    const size_t side = scale * mnistimage::kSide;
+    const std::vector<uint8_t> pixels = drawing(scale);
+    MnistCsvDataSet::Image_t image{};
+
+    for (auto _ : aState) {
+        mnistimage::downsample(pixels.data(), side, side, side, image);
+        benchmark::DoNotOptimize(image.data());
+    }
+    aState.SetBytesProcessed(aState.iterations() * pixels.size());
+}
+
+// Downsampling followed by centering, as done for every recognized drawing
+void BM_DownsampleAndCenter(benchmark::State& aState) {
+    const size_t scale = static_cast<size_t>(aState.range(0));
+    const size_t side = scale * mnistimage::kSide;
+    const std::vector<uint8_t> pixels = drawing(scale);
+    MnistCsvDataSet::Image_t image{};
+
+    for (auto _ : aState) {
+        mnistimage::downsample(pixels.data(), side, side, side, image);
+        mnistimage::centerByMass(image);
+        benchmark::DoNotOptimize(image.data());
+    }
+    aState.SetBytesProcessed(aState.iterations() * pixels.size());
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_Downsample)->ArgName("scale")->Arg(1)->Arg(10)->Arg(20);
+BENCHMARK(BM_DownsampleAndCenter)->ArgName("scale")->Arg(10);
+
+BENCHMARK_MAIN();
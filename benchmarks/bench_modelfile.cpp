@@ -0,0 +1,110 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#include "include/floatperceptron.hpp"
+#include "include/mnistcsvdataset.hpp"
+#include "include/modelfile.hpp"
+#include "include/perceptron.hpp"
+
+namespace {
+
+constexpr char kModelPath[] = "bench_model.bin";
+constexpr size_t kImageSize = MnistCsvDataSet::kMnistImageSize;
+
+// Indexed by the benchmark argument: the GUI default and a large network
+const std::vector<std::vector<size_t>> kArchitectures = {
+    {kImageSize, 64, 10},
+    {kImageSize, 512, 256, 10},
+};
+
+const Perceptron& network(size_t aIndex) {
+    static const std::vector<Perceptron> networks = [] {
+        std::vector<Perceptron> result;
+        for (const auto& layers : kArchitectures) {
+            result.emplace_back(layers, Neuron::ActivationFunction::SIGMOID,
+                                42);
+        }
+        return result;
+    }();
+    static const struct Cleanup {
+        ~Cleanup() { std::remove(kModelPath); }
+    } cleanup;
+
+    return networks[aIndex];
+}
+
+// Saving never overwrites a file, so a fresh one is written every time
+bool saveModel(size_t aIndex) {
+    std::remove(kModelPath);
+    return modelfile::save(kModelPath, network(aIndex));
+}
+
+void BM_Save(benchmark::State& aState) {
+    for (auto _ : aState) {
+        aState.PauseTiming();
+        std::remove(kModelPath);
+        aState.ResumeTiming();
+        if (!modelfile::save(kModelPath, network(aState.range(0)))) {
+            aState.SkipWithError("Unable to save the model");
+            return;
+        }
+    }
+    aState.SetBytesProcessed(aState.iterations() *
+                             std::filesystem::file_size(kModelPath));
+}
+
+// Mapping only, or mapping and verifying the checksum of every weight
+void BM_Load(benchmark::State& aState) {
+    if (!saveModel(aState.range(0))) {
+        aState.SkipWithError("Unable to save the model");
+        return;
+    }
+    const bool verify = aState.range(1) != 0;
+
+    for (auto _ : aState) {
+        Perceptron loaded;
+        if (!modelfile::load(kModelPath, loaded, verify)) {
+            aState.SkipWithError("Unable to load the model");
+            break;
+        }
+        benchmark::DoNotOptimize(loaded.layers().data());
+    }
+    aState.SetBytesProcessed(aState.iterations() *
+                             std::filesystem::file_size(kModelPath));
+}
+
+// A double file converted to floats, the way the GUI loads models
+void BM_LoadAsFloat(benchmark::State& aState) {
+    if (!saveModel(aState.range(0))) {
+        aState.SkipWithError("Unable to save the model");
+        return;
+    }
+
+    for (auto _ : aState) {
+        FloatPerceptron loaded;
+        if (!modelfile::load(kModelPath, loaded)) {
+            aState.SkipWithError("Unable to load the model");
+            break;
+        }
+        benchmark::DoNotOptimize(loaded.layers().data());
+    }
+    aState.SetBytesProcessed(aState.iterations() *
+                             std::filesystem::file_size(kModelPath));
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_Save)->ArgName("model")->DenseRange(0, 1);
+BENCHMARK(BM_Load)
+    ->ArgNames({"model", "verify"})
+    ->ArgsProduct({{0, 1}, {0, 1}});
+BENCHMARK(BM_LoadAsFloat)->ArgName("model")->DenseRange(0, 1);
+
+BENCHMARK_MAIN();
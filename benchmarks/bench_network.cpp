@@ -0,0 +1,170 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "include/mnistcsvdataset.hpp"
+#include "include/neuron.hpp"
+#include "include/perceptron.hpp"
+#include "include/trainingdata.hpp"
+#include "include/trainingoptions.hpp"
+
+namespace {
+
+constexpr size_t kImageSize = MnistCsvDataSet::kMnistImageSize;
+constexpr size_t kClasses = 10;
+constexpr uint32_t kSeed = 42;
+
+// Indexed by the benchmark argument, so the names stay short
+const std::vector<std::vector<size_t>> kArchitectures = {
+    {kImageSize, 16, kClasses},
+    {kImageSize, 64, kClasses},
+    {kImageSize, 128, 64, kClasses},
+    {kImageSize, 256, 128, kClasses},
+};
+
+std::string architectureName(const std::vector<size_t>& aLayers) {
+    std::string name;
+    for (size_t size : aLayers) {
+        name += (name.empty() ? "" : "-") + std::to_string(size);
+    }
+    return name;
+}
+
+// Built once, so that the repeated runs of a benchmark share them
+const Perceptron& network(size_t aIndex) {
+    static const std::vector<Perceptron> networks = [] {
+        std::vector<Perceptron> result;
+        for (const auto& layers : kArchitectures) {
+            result.emplace_back(layers, Neuron::ActivationFunction::SIGMOID,
+                                kSeed);
+        }
+        return result;
+    }();
+
+    return networks[aIndex];
+}
+
+std::vector<double> randomValues(size_t aCount, std::mt19937& aEngine) {
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<double> values(aCount);
+    for (auto& value : values) {
+        value = distribution(aEngine);
+    }
+    return values;
+}
+
+// MNIST-sized samples with one-hot targets, the same on every run
+struct SyntheticData {
+    explicit SyntheticData(size_t aSamples) {
+        std::mt19937 engine(kSeed);
+        for (size_t i = 0; i < aSamples; ++i) {
+            inputs.push_back(randomValues(kImageSize, engine));
+            targets.emplace_back(kClasses, 0.0);
+            targets.back()[i % kClasses] = 1.0;
+        }
+    }
+
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+};
+
+void BM_NeuronOutput(benchmark::State& aState) {
+    const size_t inputs = static_cast<size_t>(aState.range(0));
+    std::mt19937 engine(kSeed);
+    Neuron neuron(static_cast<int>(inputs),
+                  Neuron::ActivationFunction::SIGMOID);
+    neuron.weights() = randomValues(inputs, engine);
+    const std::vector<double> input = randomValues(inputs, engine);
+
+    for (auto _ : aState) {
+        benchmark::DoNotOptimize(neuron.output(input));
+    }
+    aState.SetItemsProcessed(aState.iterations() * inputs);
+}
+
+// Every layer returned, as the training loop used to need it
+void BM_PerceptronForward(benchmark::State& aState) {
+    const Perceptron& model = network(aState.range(0));
+    std::mt19937 engine(kSeed);
+    const std::vector<double> input = randomValues(kImageSize, engine);
+
+    for (auto _ : aState) {
+        benchmark::DoNotOptimize(model.forward(input));
+    }
+    aState.SetItemsProcessed(aState.iterations());
+    aState.SetLabel(architectureName(kArchitectures[aState.range(0)]));
+}
+
+// Inference only, one image after another on every thread, all threads
+// sharing one network
+void BM_PerceptronInfer(benchmark::State& aState) {
+    const Perceptron& model = network(1);
+    std::mt19937 engine(kSeed + aState.thread_index());
+    const std::vector<double> input = randomValues(kImageSize, engine);
+    std::vector<double> output;
+
+    for (auto _ : aState) {
+        model.infer(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    aState.SetItemsProcessed(aState.iterations());
+}
+
+// aState.range(0) images at once
+void BM_PerceptronForwardBatch(benchmark::State& aState) {
+    const size_t batchSize = static_cast<size_t>(aState.range(0));
+    const Perceptron& model = network(1);
+    std::mt19937 engine(kSeed);
+    const std::vector<double> inputs =
+        randomValues(batchSize * kImageSize, engine);
+
+    for (auto _ : aState) {
+        benchmark::DoNotOptimize(model.forwardBatch(inputs, batchSize));
+    }
+    aState.SetItemsProcessed(aState.iterations() * batchSize);
+}
+
+// One epoch per iteration, with aState.range(0) threads and batches of
+// aState.range(1) samples
+void BM_TrainEpoch(benchmark::State& aState) {
+    static const SyntheticData data(1024);
+    const VectorTrainingData samples(data.inputs, data.targets);
+
+    TrainingOptions options;
+    options.epochs = 1;
+    options.learningRate = 0.1;
+    options.threads = static_cast<size_t>(aState.range(0));
+    options.batchSize = static_cast<size_t>(aState.range(1));
+
+    Perceptron trained(kArchitectures[1],
+                       Neuron::ActivationFunction::SIGMOID, kSeed);
+    for (auto _ : aState) {
+        trained.train(samples, options);
+    }
+    if (!trained.isTrained()) {
+        aState.SkipWithError("Training failed");
+    }
+    aState.SetItemsProcessed(aState.iterations() * samples.size());
+    aState.SetLabel(architectureName(kArchitectures[1]));
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_NeuronOutput)->Arg(16)->Arg(64)->Arg(kImageSize);
+BENCHMARK(BM_PerceptronForward)->DenseRange(0, kArchitectures.size() - 1);
+BENCHMARK(BM_PerceptronInfer)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_PerceptronForwardBatch)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(BM_TrainEpoch)
+    ->ArgNames({"threads", "batch"})
+    ->ArgsProduct({{1, 2, 4}, {1, 16, 64}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+"""Flags benchmark regressions against a stored baseline.
+
+Compares the JSON results of Google Benchmark (--benchmark_out_format=json,
+as written by the run_benchmarks target) with a baseline of earlier
+results. BASELINE and CURRENT are either result files or directories of
+them, matched by file name. A benchmark is a regression when its real
+time per iteration grew by more than --threshold percent; the script then
+exits with 1.
+
+With --benchmark_repetitions the median of the repetitions is compared,
+which is less noisy than any single run.
+
+No baseline is committed: baselines are only comparable on the machine
+they were recorded on. To store one, run the benchmarks and copy the
+results:
+
+    cmake --build build --target run_benchmarks
+    mkdir -p benchmarks/baseline
+    cp build/benchmarks/results/*.json benchmarks/baseline/
+
+Until then the compare_benchmarks target passes --skip-without-baseline
+and only says that there is nothing to compare.
+"""
+
+import argparse
+import json
+import sys
+from pathlib import Path
+
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_times(path):
+    """Real time per iteration in ns of every benchmark in a result file."""
+    with open(path, encoding="utf-8") as result:
+        benchmarks = json.load(result)["benchmarks"]
+
+    medians = {}
+    times = {}
+    for benchmark in benchmarks:
+        if benchmark.get("error_occurred"):
+            continue
+        time = benchmark["real_time"] * TIME_UNITS[benchmark["time_unit"]]
+        if benchmark.get("run_type") == "aggregate":
+            if benchmark.get("aggregate_name") == "median":
+                medians[benchmark["run_name"]] = time
+        else:
+            times.setdefault(benchmark["name"], time)
+
+    times.update(medians)
+    return times
+
+
+def result_pairs(baseline, current):
+    """(name, baseline file, current file or None) of every baseline file.
+
+    Two files are compared with each other, directories by file name.
+    """
+    baseline, current = Path(baseline), Path(current)
+    if baseline.is_file() and current.is_file():
+        return [(baseline.name, baseline, current)]
+
+    baseline_files = [baseline] if baseline.is_file() \
+        else sorted(baseline.glob("*.json"))
+    current_dir = current.parent if current.is_file() else current
+    pairs = []
+    for file in baseline_files:
+        match = current_dir / file.name
+        pairs.append((file.name, file, match if match.is_file() else None))
+    return pairs
+
+
+def compare(baseline, current, threshold):
+    """Prints the comparison, returns the number of regressions."""
+    regressions = 0
+    for name in sorted(set(baseline) | set(current)):
+        if name not in current:
+            print(f"  missing   {name}")
+            continue
+        if name not in baseline:
+            print(f"  new       {name}")
+            continue
+
+        change = (current[name] / baseline[name] - 1.0) * 100.0
+        if change > threshold:
+            status = "REGRESSED"
+            regressions += 1
+        elif change < -threshold:
+            status = "improved"
+        else:
+            status = "ok"
+        print(f"  {status:<9} {name}: {baseline[name]:.0f} ns -> "
+              f"{current[name]:.0f} ns ({change:+.1f}%)")
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__.splitlines()[0],
+        epilog="Exits with 1 if any benchmark regressed, 2 on bad input.")
+    parser.add_argument("baseline", help="baseline result file or directory")
+    parser.add_argument("current", help="current result file or directory")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="slowdown in percent that is a regression "
+                             "(default: %(default)s)")
+    parser.add_argument("--skip-without-baseline", action="store_true",
+                        help="exit with 0 instead of 2 when there are no "
+                             "baseline results yet")
+    args = parser.parse_args()
+
+    pairs = result_pairs(args.baseline, args.current)
+    if not pairs:
+        print(f"No baseline results in {args.baseline}", file=sys.stderr)
+        if args.skip_without_baseline:
+            print("Nothing to compare. Copy the results of run_benchmarks "
+                  "there to record a baseline, see benchmarks/compare.py.")
+            return 0
+        return 2
+
+    regressions = 0
+    for name, baseline_file, current_file in pairs:
+        print(name)
+        if current_file is None:
+            print("  no current results")
+            regressions += 1
+            continue
+        try:
+            regressions += compare(load_times(baseline_file),
+                                   load_times(current_file),
+                                   args.threshold)
+        except (OSError, KeyError, ValueError) as error:
+            print(f"Unable to read the results: {error}", file=sys.stderr)
+            return 2
+
+    if regressions:
+        print(f"{regressions} regression(s) over {args.threshold:g}%")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -3,11 +3,16 @@
 #ifndef CMD_INCLUDE_APPLICATION_HPP_
 #define CMD_INCLUDE_APPLICATION_HPP_
 
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "include/floatperceptron.hpp"
 #include "include/perceptron.hpp"
 #include "include/mnistcsvdataset.hpp"
+#include "include/recognitionserver.hpp"
 
 namespace boost {
 namespace program_options {
@@ -31,29 +36,86 @@ class Application {
     Application& operator=(Application&&) = delete;
 
  private:
+    // Numeric type the network computes in
+    enum class Precision {
+        FLOAT,
+        DOUBLE,
+        INT8  // Recognition only, quantized from a double model
+    };
+
+    struct RecognitionOptions {
+        Precision precision = Precision::FLOAT;
+        // Images calibrating the int8 ranges, the data file when empty
+        std::string calibrationFile;
+        size_t threads = 0;  // Inference workers, 0 for all hardware ones
+        size_t batchSize = 256;
+    };
+
+    struct ServeOptions {
+        Precision precision = Precision::FLOAT;
+        std::string calibrationFile;  // Required for INT8
+        // Unix domain socket, the localhost TCP port when empty
+        std::string socketPath;
+        uint16_t port = 0;
+        RecognitionServer::Format format = RecognitionServer::Format::CSV;
+        size_t threads = 1;     // Batches scored at once
+        size_t batchSize = 64;  // Largest batch
+        std::chrono::microseconds latencyBudget{0};
+    };
+
     std::string version() const;
 
     void parseCommandLine(const int aArgc, const char* const aArgv[]) const;
     void initTrainingMode(const po::variables_map& aVm) const;
     void initRecognitionMode(const po::variables_map& aVm) const;
+    void initServeMode(const po::variables_map& aVm) const;
 
     void handleTrainingMode(
         const std::string& aMnistTrainFile,
         const std::string& aMnistTestFile,
         const std::string& aOutputModelFile,
         const std::vector<size_t>& aLayers,
-        const int aEpochs,
-        const double aLearningRate) const;
+        const TrainingOptions& aOptions,
+        std::optional<uint32_t> aSeed,
+        Precision aPrecision,
+        bool aStream,
+        const std::string& aMetricsFile) const;
 
     void handleRecognitionMode(
         const std::string& aDataFile,
         const std::string& aModelFile,
-        const std::string& aResultFile) const;
+        const std::string& aResultFile,
+        const RecognitionOptions& aOptions) const;
+
+    // Loads the model once and answers requests on a socket until SIGINT
+    // or SIGTERM
+    void handleServeMode(
+        const std::string& aModelFile,
+        const ServeOptions& aOptions) const;
+
+    // Binary model for *.bin files, JSON otherwise. A float binary model
+    // is written when aPrecision is FLOAT; JSON models are always double.
+    bool saveModel(
+        const std::string& aFileName,
+        const Perceptron& aNetwork,
+        Precision aPrecision = Precision::DOUBLE) const;
+
+    // Binary or JSON model, whichever aFileName holds
+    bool loadModel(
+        const std::string& aFileName,
+        Perceptron& aNetwork) const;  // NOLINT(runtime/references)
+    bool loadModel(
+        const std::string& aFileName,
+        FloatPerceptron& aNetwork) const;  // NOLINT(runtime/references)
 
     bool saveModelToJson(
         const std::string& aFileName,
         const Perceptron& aNetwork) const;
 
+    bool saveMetricsToJson(
+        const std::string& aFileName,
+        const TrainingMetrics& aMetrics) const;
+
     bool loadModelFromJson(
         const std::string& aFileName,
         Perceptron& aNetwork) const;  // NOLINT(runtime/references)
@@ -63,6 +125,9 @@ class Application {
         // NOLINTNEXTLINE(runtime/references)
         T& aOut, const std::string& aLabel) const;
 
+    // "float", "double" or "int8"; nullopt for anything else
+    std::optional<Precision> parsePrecision(const std::string& aInput) const;
+
     std::vector<size_t> parseLayersString(
         const std::string& aInput,
         size_t aImageSize = kImageSize,
@@ -71,11 +136,6 @@ class Application {
     std::string vectorToString(const std::vector<size_t>& aVector,
                                char delimiter = ',') const;
 
-    std::vector<double> toOneHot(uint8_t aLabel, size_t aNumClasses = 10) const;
-
-    std::vector<double> normalizeImage(
-        const MnistCsvDataSet::Image_t& image) const;
-
     static constexpr int kNumClasses = 10;      // Numbers from 0 to 9
     static constexpr int kImageSize = 28 * 28;  // Images 28 px x 28 px
 };
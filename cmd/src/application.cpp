@@ -3,9 +3,13 @@
 #include "include/application.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
 #include <iostream>  // For help and version output
 #include <filesystem>  // NOLINT(build/c++17)
 #include <fstream>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -19,6 +23,13 @@
 
 #include "include/logger.hpp"
 #include "include/mnistcsvdataset.hpp"
+#include "include/mnistcsvreader.hpp"
+#include "include/mnisttrainingdata.hpp"
+#include "include/modelfile.hpp"
+#include "include/optimizer.hpp"
+#include "include/quantizedperceptron.hpp"
+#include "include/recognitionpipeline.hpp"
+#include "include/recognitionserver.hpp"
 
 
 // Unnamed namespace to restrict the scope of constants to this translation unit
@@ -27,6 +38,189 @@ constexpr char kDefaultHiddenLayers[] = "512";
 constexpr int kDefaultEpochs = 40;
 constexpr double kDefaultLearningRate = 0.001;
 constexpr char kMnistCsvDelimeter = ',';
+constexpr size_t kForwardBatchSize = 256;
+constexpr size_t kCalibrationSamples = 1000;
+constexpr size_t kResultBufferSize = 1 << 20;
+constexpr int kDefaultThreads = 1;
+// One recognition worker per hardware thread
+constexpr int kDefaultRecognitionThreads = 0;
+constexpr int kMaxThreads = 256;
+constexpr int kDefaultBatchSize = 1;
+constexpr int kMaxBatchSize = 4096;
+// Mini-batch split between the threads when training runs in parallel
+// and no batch size is given
+constexpr size_t kParallelBatchSize = 64;
+constexpr char kDefaultOptimizer[] = "sgd";
+constexpr char kBinaryModelExtension[] = ".bin";
+constexpr char kDefaultTrainingPrecision[] = "double";
+constexpr char kDefaultRecognitionPrecision[] = "float";
+constexpr char kDefaultRequestFormat[] = "csv";
+// Microseconds. Without a budget a free worker takes whatever is queued,
+// so batches still grow with the load, without adding any latency.
+constexpr int kDefaultLatencyBudget = 0;
+constexpr int kMaxLatencyBudget = 1000000;
+constexpr int kDefaultServeThreads = 1;
+constexpr int kDefaultServeBatchSize = 64;
+constexpr int kMaxPort = 65535;
+
+// Network inputs of one image: normalized pixels
+template <typename T>
+void toInputs(const MnistCsvDataSet::Image_t& aImage, T* aInputs) {
+    MnistTrainingData::normalize(aImage, aInputs);
+}
+
+// Raw pixels for the int8 engine, which takes them as they are
+void toInputs(const MnistCsvDataSet::Image_t& aImage, uint8_t* aInputs) {
+    std::copy(aImage.begin(), aImage.end(), aInputs);
+}
+
+// Inputs of aCount images into one contiguous batch, aImageAt(i) is the
+// i-th image
+template <typename T, typename ImageAt>
+void fillBatch(size_t aCount, ImageAt aImageAt,
+               std::vector<T>& aBatch) {  // NOLINT(runtime/references)
+    constexpr size_t kInputs = MnistCsvDataSet::kMnistImageSize;
+    aBatch.resize(aCount * kInputs);
+    for (size_t i = 0; i < aCount; ++i) {
+        toInputs(aImageAt(i), aBatch.data() + i * kInputs);
+    }
+}
+
+template <typename T>
+size_t argmax(const std::vector<T>& aValues) {
+    return std::distance(aValues.begin(),
+                         std::max_element(aValues.begin(), aValues.end()));
+}
+
+// Pipeline classifier running aNetwork on inputs of type T. Every worker
+// thread reuses its own input buffer.
+template <typename T, typename Network>
+RecognitionPipeline::Classifier classifierFor(const Network& aNetwork) {
+    return [&aNetwork](const RecognitionPipeline::Entries& aEntries,
+                       RecognitionPipeline::Predictions& aPredictions) {
+        thread_local std::vector<T> batch;
+        fillBatch(aEntries.size(), [&aEntries](size_t aIndex) -> const auto& {
+            return aEntries[aIndex].second;
+        }, batch);
+
+        const auto outputs = aNetwork.forwardBatch(batch, aEntries.size());
+        for (size_t k = 0; k < outputs.size(); ++k) {
+            aPredictions[k] =
+                static_cast<MnistCsvDataSet::Label_t>(argmax(outputs[k]));
+        }
+    };
+}
+
+// Server scorer running aNetwork on inputs of type T, see classifierFor
+template <typename T, typename Network>
+MicroBatcher::Scorer scorerFor(const Network& aNetwork) {
+    return [&aNetwork](const std::vector<MicroBatcher::Image>& aImages) {
+        thread_local std::vector<T> batch;
+        fillBatch(aImages.size(), [&aImages](size_t aIndex) -> const auto& {
+            return aImages[aIndex];
+        }, batch);
+
+        const auto outputs = aNetwork.forwardBatch(batch, aImages.size());
+        std::vector<MicroBatcher::Scores> scores;
+        scores.reserve(outputs.size());
+        for (const auto& output : outputs) {
+            scores.emplace_back(output.begin(), output.end());
+        }
+        return scores;
+    };
+}
+
+struct RecognitionStats {
+    size_t count = 0;
+    size_t matches = 0;
+    double seconds = 0.0;  // Parsing included, it overlaps the inference
+};
+
+// Streams aDataFile (MnistCsvReader::kStandardInput for the standard
+// input) through aNetwork. Every result is written to aResults unless it
+// is null, one batch per write.
+template <typename T, typename Network>
+std::optional<RecognitionStats> recognize(const Network& aNetwork,
+    const std::string& aDataFile, size_t aThreads, size_t aBatchSize,
+    std::ostream* aResults) {
+    MnistCsvReader reader(aDataFile);
+    if (!reader.isOpen()) {
+        LOG_ERROR << reader.lastError();
+        return std::nullopt;
+    }
+
+    RecognitionStats stats;
+    std::string lines;
+    RecognitionPipeline pipeline(aThreads, aBatchSize);
+    const auto start = std::chrono::steady_clock::now();
+    const bool ok = pipeline.run(reader, classifierFor<T>(aNetwork),
+        [&](const RecognitionPipeline::Entries& aEntries,
+            const RecognitionPipeline::Predictions& aPredictions) {
+            lines.clear();
+            for (size_t k = 0; k < aEntries.size(); ++k) {
+                const int expected = aEntries[k].first;
+                const int predicted = aPredictions[k];
+                stats.matches += expected == predicted;
+
+                lines += "Expected: ";
+                lines += std::to_string(expected);
+                lines += "\tPredicted: ";
+                lines += std::to_string(predicted);
+                lines += '\n';
+            }
+
+            if (aResults) {
+                aResults->write(lines.data(), lines.size());
+            }
+        });
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    if (!ok) {
+        LOG_ERROR << aDataFile << ": " << pipeline.lastError();
+        return std::nullopt;
+    }
+
+    stats.count = pipeline.processed();
+    stats.seconds = elapsed.count();
+    return stats;
+}
+
+bool isStandardInput(const std::string& aPath) {
+    return aPath == MnistCsvReader::kStandardInput;
+}
+
+double throughput(const RecognitionStats& aStats) {
+    return aStats.seconds > 0.0 ? aStats.count / aStats.seconds : 0.0;
+}
+
+// Quantizes aNetwork with the ranges of the first images of
+// aCalibrationFile
+bool quantize(const Perceptron& aNetwork, const std::string& aCalibrationFile,
+              QuantizedPerceptron& aQuantized) {  // NOLINT
+    MnistCsvReader reader(aCalibrationFile);
+    MnistCsvReader::Entries entries;
+    if (reader.read(entries, kCalibrationSamples) == 0 || reader.failed()) {
+        if (reader.failed()) {
+            LOG_ERROR << aCalibrationFile << ": " << reader.lastError();
+        }
+        LOG_ERROR << "Unable to load calibration data from file "
+                  << aCalibrationFile;
+        return false;
+    }
+
+    const MnistTrainingData calibration(entries.data(), entries.size());
+    return aQuantized.quantize(aNetwork, calibration, calibration.size());
+}
+
+// Server that SIGINT and SIGTERM stop
+std::atomic<RecognitionServer*> stoppableServer{nullptr};
+
+void stopServer(int) {
+    if (RecognitionServer* server = stoppableServer.load()) {
+        server->stop();
+    }
+}
 }
 
 std::string Application::version() const {
@@ -67,6 +261,20 @@ std::vector<size_t> Application::parseLayersString(const std::string& aInput,
     return result;
 }
 
+std::optional<Application::Precision> Application::parsePrecision(
+    const std::string& aInput) const {
+    if (aInput == "float") {
+        return Precision::FLOAT;
+    }
+    if (aInput == "double") {
+        return Precision::DOUBLE;
+    }
+    if (aInput == "int8") {
+        return Precision::INT8;
+    }
+    return std::nullopt;
+}
+
 std::string Application::vectorToString(const std::vector<size_t>& aVector,
                            char aDelimiter) const {
     std::ostringstream oss;
@@ -79,23 +287,6 @@ std::string Application::vectorToString(const std::vector<size_t>& aVector,
     return oss.str();
 }
 
-std::vector<double> Application::toOneHot(
-    uint8_t aLabel, size_t aNumClasses) const {
-    std::vector<double> vec(aNumClasses, 0.0);
-    vec[aLabel] = 1.0;
-    return vec;
-}
-
-std::vector<double> Application::normalizeImage(
-    const MnistCsvDataSet::Image_t& image) const {
-    std::vector<double> result(image.size());
-
-    std::transform(image.begin(), image.end(), result.begin(),
-                   [](uint8_t px) { return static_cast<double>(px) / 255.0; });
-
-    return result;
-}
-
 void Application::parseCommandLine(const int aArgc,
                                    const char* const aArgv[]) const {
     std::string taskType;
@@ -105,16 +296,33 @@ void Application::parseCommandLine(const int aArgc,
         ("help,h", "Show help message")
         ("version,v", "Show version")
         ("mode,m", po::value<std::string>(&taskType)->required(),
-            "Select mode: training, recognition");
+            "Select mode: training, recognition, serve")
+        ("precision", po::value<std::string>(),
+            "Numeric type of the network: float, double, int8 "
+            "(recognition only). Defaults to double for training and "
+            "float for recognition. Training always runs in double; "
+            "float only changes the saved binary model")
+        ("threads,j", po::value<int>(),
+            "Number of worker threads (Supported values: 1 - 256). "
+            "Training splits every mini-batch between them, so more than "
+            "one needs a batch size above 1, and defaults to 1. "
+            "Recognition classifies batches on them and defaults to "
+            "0, one per hardware thread")
+        ("batch-size,b", po::value<int>(),
+            "Training: samples per weight update (Supported values: "
+            "1 - 4096), defaults to 1, or to 64 with more than one thread. "
+            "Recognition: images per inference batch, defaults to 256");
 
     po::options_description trainDesc("Training options:");
     trainDesc.add_options()
         ("train-data,t", po::value<std::string>(),
-            "Path to train csv file (mnist_train.csv)")
+            "Path to train csv file (mnist_train.csv), - for the standard "
+            "input (streamed, one epoch only)")
         ("test-data,c", po::value<std::string>(),
             "Path to data file csv (mnist_test.csv)")
         ("output-model,o", po::value<std::string>(),
-            "Output file with trained model and network configuration")
+            "Output file with trained model and network configuration. "
+            "Files ending with .bin get the binary model format")
         ("epochs,e", po::value<int>()->default_value(kDefaultEpochs),
             "Number of epochs to learning (Supported values: 1 - 100)")
         ("learning-rate,l",
@@ -122,18 +330,55 @@ void Application::parseCommandLine(const int aArgc,
             "Learning rate for optimizer. Typical values: 0.1–0.001")
         ("hidden-layers,s",
             po::value<std::string>()->default_value(kDefaultHiddenLayers),
-            "Comma-separated list of hidden layer sizes, e.g., 768,512,256,10");
+            "Comma-separated list of hidden layer sizes, e.g., 768,512,256,10")
+        ("optimizer",
+            po::value<std::string>()->default_value(kDefaultOptimizer),
+            "Weight update rule: sgd, momentum, adam. "
+            "Adam works best with learning rates around 0.001")
+        ("seed", po::value<uint32_t>(),
+            "Seed for the initial weights. With the same seed and thread "
+            "count training gives the same model")
+        ("stream",
+            "Read the train data in one pass per epoch instead of loading "
+            "it, for files larger than memory. Gives the same model")
+        ("metrics-out", po::value<std::string>(),
+            "Write the training metrics (phase times, samples/s, FLOPs per "
+            "layer, allocations) as JSON to this file. Needs a build with "
+            "-DRECOGNITION_METRICS=ON");
 
     po::options_description recDesc("Recognition options");
     recDesc.add_options()
         ("data,d", po::value<std::string>(),
-            "Path to file with data to recognize")
+            "Path to file with data to recognize, - for the standard input")
         ("model,p", po::value<std::string>(),
-            "Path to file with learned model")
+            "Path to file with learned model (JSON or binary)")
         ("result,r", po::value<std::string>(),
-            "Output file with recognition results");
-
-    mainDesc.add(trainDesc).add(recDesc);
+            "Output file with recognition results")
+        ("calibration-data", po::value<std::string>(),
+            "MNIST csv file whose first images calibrate the int8 "
+            "activation ranges. Defaults to the data to recognize");
+
+    po::options_description serveDesc("Serve options (with --model, "
+        "--precision and --calibration-data)");
+    serveDesc.add_options()
+        ("socket", po::value<std::string>(),
+            "Unix domain socket to listen on")
+        ("port", po::value<int>(),
+            "Localhost TCP port to listen on, instead of --socket")
+        ("request-format",
+            po::value<std::string>()->default_value(kDefaultRequestFormat),
+            "raw: 784 pixel bytes per request, answered by 10 float scores "
+            "(native byte order). csv: a line of pixels or a MNIST csv "
+            "line per request, answered by a line digit,score0,...,score9")
+        ("latency-budget",
+            po::value<int>()->default_value(kDefaultLatencyBudget),
+            "Microseconds a request may wait for others to share its "
+            "batch (Supported values: 0 - 1000000). With 0 a batch is "
+            "whatever queued up while the previous one was scored. "
+            "--batch-size is the largest batch (default 64), --threads "
+            "the number of batches scored at once (default 1)");
+
+    mainDesc.add(trainDesc).add(recDesc).add(serveDesc);
 
     po::variables_map vm;
     try {
@@ -160,9 +405,11 @@ void Application::parseCommandLine(const int aArgc,
         initTrainingMode(vm);
     } else if (taskType == "recognition") {
         initRecognitionMode(vm);
+    } else if (taskType == "serve") {
+        initServeMode(vm);
     } else {
-        LOG_ERROR << "Unknown mode. Valid modes are 'training'"
-            << " and 'recognition'.";
+        LOG_ERROR << "Unknown mode. Valid modes are 'training',"
+            << " 'recognition' and 'serve'.";
     }
 }
 
@@ -173,22 +420,101 @@ void Application::initTrainingMode(const po::variables_map& aVm) const {
     std::vector<size_t> layers;
     int epochs;
     double learningRate;
+    int threads = kDefaultThreads;
+    int batchSize = kDefaultBatchSize;
+    std::string optimizerString;
     std::string hiddenLayersString;
+    std::string metricsFile;
+    std::optional<uint32_t> seed;
 
     if (!getValue(aVm, "train-data", trainFile, "--train-data")      ||
         !getValue(aVm, "test-data", testFile, "--test-data")         ||
         !getValue(aVm, "output-model", outputFile, "--output-model") ||
         !getValue(aVm, "epochs", epochs, "--epochs")                 ||
         !getValue(aVm, "learning-rate", learningRate, "--learning-rate") ||
+        !getValue(aVm, "optimizer", optimizerString, "--optimizer")  ||
         !getValue(aVm, "hidden-layers", hiddenLayersString,
                   "--hidden-layers")) {
         return;
     }
 
+    if ((aVm.count("threads") &&
+         !getValue(aVm, "threads", threads, "--threads")) ||
+        (aVm.count("batch-size") &&
+         !getValue(aVm, "batch-size", batchSize, "--batch-size"))) {
+        return;
+    }
+
+    if (aVm.count("metrics-out")) {
+        if (!getValue(aVm, "metrics-out", metricsFile, "--metrics-out")) {
+            return;
+        }
+        if (!TrainingMetrics::kEnabled) {
+            LOG_ERROR << "--metrics-out needs a build with "
+                      << "-DRECOGNITION_METRICS=ON";
+            return;
+        }
+    }
+
+    if (aVm.count("seed")) {
+        uint32_t value = 0;
+        if (!getValue(aVm, "seed", value, "--seed")) {
+            return;
+        }
+        seed = value;
+    }
+
+    if (threads < 1 || threads > kMaxThreads) {
+        LOG_ERROR << "Threads value wrong: " << threads;
+        return;
+    }
+
+    if (batchSize < 1 || batchSize > kMaxBatchSize) {
+        LOG_ERROR << "Batch size value wrong: " << batchSize;
+        return;
+    }
+
+    // A batch of one sample runs on one thread, the others would idle
+    if (threads > 1 && batchSize == 1 && aVm.count("batch-size")) {
+        LOG_ERROR << "--threads " << threads
+                  << " needs a --batch-size above 1";
+        return;
+    }
+
+    const auto optimizer = optimizerFromName(optimizerString);
+    if (!optimizer) {
+        LOG_ERROR << "Unknown optimizer: " << optimizerString;
+        return;
+    }
+
+    std::string precisionString = kDefaultTrainingPrecision;
+    if (aVm.count("precision") &&
+        !getValue(aVm, "precision", precisionString, "--precision")) {
+        return;
+    }
+
+    const auto precision = parsePrecision(precisionString);
+    if (!precision || *precision == Precision::INT8) {
+        LOG_ERROR << "Unsupported training precision: " << precisionString;
+        return;
+    }
+
     layers = parseLayersString(hiddenLayersString);
 
+    TrainingOptions options;
+    options.epochs = epochs;
+    options.learningRate = learningRate;
+    options.threads = static_cast<size_t>(threads);
+    options.batchSize = static_cast<size_t>(batchSize);
+    if (threads > 1 && !aVm.count("batch-size")) {
+        options.batchSize = kParallelBatchSize;
+    }
+    options.optimizer = *optimizer;
+
     handleTrainingMode(trainFile, testFile, outputFile,
-                       layers, epochs, learningRate);
+                       layers, options, seed, *precision,
+                       aVm.count("stream") || isStandardInput(trainFile),
+                       metricsFile);
 }
 
 void Application::initRecognitionMode(const po::variables_map& aVm) const {
@@ -202,12 +528,195 @@ void Application::initRecognitionMode(const po::variables_map& aVm) const {
         return;
     }
 
+    std::string precisionString = kDefaultRecognitionPrecision;
+    if (aVm.count("precision") &&
+        !getValue(aVm, "precision", precisionString, "--precision")) {
+        return;
+    }
+
+    const auto precision = parsePrecision(precisionString);
+    if (!precision) {
+        LOG_ERROR << "Unknown precision: " << precisionString;
+        return;
+    }
+
+    RecognitionOptions options;
+    options.precision = *precision;
+    if (aVm.count("calibration-data") &&
+        !getValue(aVm, "calibration-data", options.calibrationFile,
+                  "--calibration-data")) {
+        return;
+    }
+
+    int threads = kDefaultRecognitionThreads;
+    int batchSize = static_cast<int>(kForwardBatchSize);
+    if ((aVm.count("threads") &&
+         !getValue(aVm, "threads", threads, "--threads")) ||
+        (aVm.count("batch-size") &&
+         !getValue(aVm, "batch-size", batchSize, "--batch-size"))) {
+        return;
+    }
+
+    if (threads < 0 || threads > kMaxThreads) {
+        LOG_ERROR << "Threads value wrong: " << threads;
+        return;
+    }
+
+    if (batchSize < 1 || batchSize > kMaxBatchSize) {
+        LOG_ERROR << "Batch size value wrong: " << batchSize;
+        return;
+    }
+    options.threads = static_cast<size_t>(threads);
+    options.batchSize = static_cast<size_t>(batchSize);
+
     LOG_INFO << "Recognition mode parameters:" << "\n"
              << "\tData file:\t" << dataFile << "\n"
              << "\tModel file:\t" << modelFile << "\n"
-             << "\tResult file:\t" << resultFile;
+             << "\tResult file:\t" << resultFile << "\n"
+             << "\tPrecision:\t" << precisionString << "\n"
+             << "\tThreads:\t" << threads << "\n"
+             << "\tBatch size:\t" << batchSize;
 
-    handleRecognitionMode(dataFile, modelFile, resultFile);
+    handleRecognitionMode(dataFile, modelFile, resultFile, options);
+}
+
+void Application::initServeMode(const po::variables_map& aVm) const {
+    std::string modelFile;
+    std::string formatString;
+    int latencyBudget = kDefaultLatencyBudget;
+    if (!getValue(aVm, "model", modelFile, "--model") ||
+        !getValue(aVm, "request-format", formatString, "--request-format") ||
+        !getValue(aVm, "latency-budget", latencyBudget,
+                  "--latency-budget")) {
+        return;
+    }
+
+    ServeOptions options;
+    std::string precisionString = kDefaultRecognitionPrecision;
+    if (aVm.count("precision") &&
+        !getValue(aVm, "precision", precisionString, "--precision")) {
+        return;
+    }
+
+    const auto precision = parsePrecision(precisionString);
+    if (!precision) {
+        LOG_ERROR << "Unknown precision: " << precisionString;
+        return;
+    }
+    options.precision = *precision;
+
+    if (aVm.count("calibration-data") &&
+        !getValue(aVm, "calibration-data", options.calibrationFile,
+                  "--calibration-data")) {
+        return;
+    }
+
+    if (options.precision == Precision::INT8 &&
+        options.calibrationFile.empty()) {
+        LOG_ERROR << "--calibration-data is required to serve in int8";
+        return;
+    }
+
+    if (formatString == "raw") {
+        options.format = RecognitionServer::Format::RAW;
+    } else if (formatString == "csv") {
+        options.format = RecognitionServer::Format::CSV;
+    } else {
+        LOG_ERROR << "Unknown request format: " << formatString;
+        return;
+    }
+
+    int port = 0;
+    if ((aVm.count("socket") &&
+         !getValue(aVm, "socket", options.socketPath, "--socket")) ||
+        (aVm.count("port") && !getValue(aVm, "port", port, "--port"))) {
+        return;
+    }
+
+    if (options.socketPath.empty() == !aVm.count("port")) {
+        LOG_ERROR << "Either --socket or --port is required";
+        return;
+    }
+
+    if (aVm.count("port") && (port < 1 || port > kMaxPort)) {
+        LOG_ERROR << "Port value wrong: " << port;
+        return;
+    }
+    options.port = static_cast<uint16_t>(port);
+
+    int threads = kDefaultServeThreads;
+    int batchSize = kDefaultServeBatchSize;
+    if ((aVm.count("threads") &&
+         !getValue(aVm, "threads", threads, "--threads")) ||
+        (aVm.count("batch-size") &&
+         !getValue(aVm, "batch-size", batchSize, "--batch-size"))) {
+        return;
+    }
+
+    if (threads < 1 || threads > kMaxThreads) {
+        LOG_ERROR << "Threads value wrong: " << threads;
+        return;
+    }
+
+    if (batchSize < 1 || batchSize > kMaxBatchSize) {
+        LOG_ERROR << "Batch size value wrong: " << batchSize;
+        return;
+    }
+
+    if (latencyBudget < 0 || latencyBudget > kMaxLatencyBudget) {
+        LOG_ERROR << "Latency budget value wrong: " << latencyBudget;
+        return;
+    }
+    options.threads = static_cast<size_t>(threads);
+    options.batchSize = static_cast<size_t>(batchSize);
+    options.latencyBudget = std::chrono::microseconds(latencyBudget);
+
+    LOG_INFO << "Serve mode parameters:" << "\n"
+             << "\tModel file:\t" << modelFile << "\n"
+             << "\tPrecision:\t" << precisionString << "\n"
+             << "\tRequests:\t" << formatString << "\n"
+             << "\tThreads:\t" << threads << "\n"
+             << "\tBatch size:\t" << batchSize << "\n"
+             << "\tLatency budget:\t" << latencyBudget << " us";
+
+    handleServeMode(modelFile, options);
+}
+
+bool Application::saveModel(const std::string& aFileName,
+    const Perceptron& aNetwork, Precision aPrecision) const {
+    if (std::filesystem::path(aFileName).extension() ==
+            kBinaryModelExtension) {
+        if (aPrecision == Precision::FLOAT) {
+            return modelfile::save(aFileName, FloatPerceptron(aNetwork));
+        }
+        return modelfile::save(aFileName, aNetwork);
+    }
+
+    return saveModelToJson(aFileName, aNetwork);
+}
+
+bool Application::loadModel(const std::string& aFileName,
+    Perceptron& aNetwork) const {
+    if (modelfile::isModelFile(aFileName)) {
+        return modelfile::load(aFileName, aNetwork);
+    }
+
+    return loadModelFromJson(aFileName, aNetwork);
+}
+
+bool Application::loadModel(const std::string& aFileName,
+    FloatPerceptron& aNetwork) const {
+    if (modelfile::isModelFile(aFileName)) {
+        return modelfile::load(aFileName, aNetwork);
+    }
+
+    Perceptron network;
+    if (!loadModelFromJson(aFileName, network)) {
+        return false;
+    }
+
+    aNetwork = FloatPerceptron(network);
+    return true;
 }
 
 bool Application::saveModelToJson(const std::string& aFileName,
@@ -300,6 +809,53 @@ bool Application::saveModelToJson(const std::string& aFileName,
     return true;
 }
 
+bool Application::saveMetricsToJson(const std::string& aFileName,
+    const TrainingMetrics& aMetrics) const {
+    boost::json::object jsonMetrics;
+    jsonMetrics["epochs"] = aMetrics.epochs;
+    jsonMetrics["samples"] = aMetrics.samples;
+    jsonMetrics["batches"] = aMetrics.batches;
+    jsonMetrics["seconds"] = aMetrics.seconds;
+    jsonMetrics["samples_per_second"] = aMetrics.samplesPerSecond;
+
+    boost::json::object jsonPhases;
+    jsonPhases["data"] = aMetrics.dataSeconds;
+    jsonPhases["forward"] = aMetrics.forwardSeconds;
+    jsonPhases["backward"] = aMetrics.backwardSeconds;
+    jsonPhases["update"] = aMetrics.updateSeconds;
+    jsonMetrics["phase_seconds"] = jsonPhases;
+
+    boost::json::array jsonLayers;
+    for (const auto& layer : aMetrics.layers) {
+        boost::json::object jsonLayer;
+        jsonLayer["inputs"] = layer.inputs;
+        jsonLayer["neurons"] = layer.neurons;
+        jsonLayer["forward_flops"] = layer.forwardFlops;
+        jsonLayer["backward_flops"] = layer.backwardFlops;
+        jsonLayer["update_flops"] = layer.updateFlops;
+        jsonLayers.emplace_back(jsonLayer);
+    }
+    jsonMetrics["layers"] = jsonLayers;
+
+    jsonMetrics["allocations"] = aMetrics.allocations;
+    jsonMetrics["allocated_bytes"] = aMetrics.allocatedBytes;
+
+    std::ofstream file(aFileName);
+    if (!file.is_open()) {
+        LOG_ERROR << "Unable to open file " << aFileName;
+        return false;
+    }
+
+    file << boost::json::serialize(jsonMetrics) << std::endl;
+    if (!file) {
+        LOG_ERROR << "Unable to write the file " << aFileName;
+        return false;
+    }
+
+    LOG_INFO << "Training metrics saved to " << aFileName;
+    return true;
+}
+
 bool Application::loadModelFromJson(const std::string& aFileName,
     Perceptron& aNetwork) const {
     if (aFileName.empty()) {
@@ -420,9 +976,13 @@ void Application::handleTrainingMode(const std::string& aMnistTrainFile,
                                      const std::string& aMnistTestFile,
                                      const std::string& aOutputModelFile,
                                      const std::vector<size_t>& aLayers,
-                                     const int aEpochs,
-                                     const double aLearningRate) const {
-    if (!std::filesystem::exists(aMnistTrainFile)) {
+                                     const TrainingOptions& aOptions,
+                                     std::optional<uint32_t> aSeed,
+                                     Precision aPrecision,
+                                     bool aStream,
+                                     const std::string& aMetricsFile) const {
+    if (!isStandardInput(aMnistTrainFile) &&
+        !std::filesystem::exists(aMnistTrainFile)) {
         LOG_ERROR<< "Train file " << aMnistTrainFile << " does not exist";
         return;
     }
@@ -442,15 +1002,21 @@ void Application::handleTrainingMode(const std::string& aMnistTrainFile,
         return;
     }
 
-    if (aEpochs <= 0 || aEpochs > 100) {
+    if (aOptions.epochs <= 0 || aOptions.epochs > 100) {
         LOG_ERROR << "Epochs value wrong on not effective: "
-                  << aEpochs;
+                  << aOptions.epochs;
         return;
     }
 
-    if (aLearningRate >= 0.5 || aLearningRate < 0.00001) {
+    if (aOptions.learningRate >= 0.5 || aOptions.learningRate < 0.00001) {
         LOG_ERROR << "Learning rate value wrong on not effective: "
-                  << aLearningRate;
+                  << aOptions.learningRate;
+        return;
+    }
+
+    if (isStandardInput(aMnistTrainFile) && aOptions.epochs != 1) {
+        LOG_ERROR << "The standard input can be trained on for one epoch "
+                  << "only, epochs: " << aOptions.epochs;
         return;
     }
 
@@ -461,87 +1027,79 @@ void Application::handleTrainingMode(const std::string& aMnistTrainFile,
              << "\tTest file\t:\t" << aMnistTestFile << "\n"
              << "\tModel file\t:\t" << aOutputModelFile << "\n"
              << "\tLayers model\t:\t" << layersStr << "\n"
-             << "\tEpochs num\t:\t" << aEpochs << "\n"
-             << "\tLearning rate\t:\t" << aLearningRate;
+             << "\tEpochs num\t:\t" << aOptions.epochs << "\n"
+             << "\tLearning rate\t:\t" << aOptions.learningRate << "\n"
+             << "\tBatch size\t:\t" << aOptions.batchSize << "\n"
+             << "\tOptimizer\t:\t" << optimizerName(aOptions.optimizer)
+             << "\n"
+             << "\tThreads\t\t:\t" << aOptions.threads << "\n"
+             << "\tStreamed\t:\t" << (aStream ? "yes" : "no");
 
     auto function = Neuron::ActivationFunction::SIGMOID;
-    Perceptron network(aLayers, function);
+    Perceptron network(aLayers, function, aSeed);
 
-    // Load train data
-    std::vector<std::vector<double>> trainInputs;
-    std::vector<std::vector<double>> trainTargets;
-    {
-        MnistCsvDataSet trainSet(aMnistTrainFile);
-        if (!trainSet.isLoaded()) {
-            LOG_ERROR
-                << "Unable to load MNIST data from file "
-                << aMnistTrainFile;
+    if (aStream) {
+        // Only a chunk of the train data is in memory at a time
+        MnistCsvReader trainReader(aMnistTrainFile);
+        if (!trainReader.isOpen()) {
+            LOG_ERROR << trainReader.lastError();
             return;
         }
 
-        trainInputs.resize(trainSet.size());
-        trainTargets.resize(trainSet.size());
-        for (size_t i = 0; i < trainSet.size(); ++i) {
-            trainTargets[i] = toOneHot(trainSet[i].first);
-            trainInputs[i] = normalizeImage(trainSet[i].second);
+        LOG_INFO << "Training started...";
+        MnistTrainingStream trainStream(trainReader);
+        network.train(trainStream, aOptions);
+        if (trainReader.failed()) {
+            LOG_ERROR << aMnistTrainFile << ": " << trainReader.lastError();
         }
-    }
-
-    // Train model
-    LOG_INFO << "Training started...";
-    network.train(trainInputs, trainTargets, aEpochs, aLearningRate);
-    LOG_INFO << "Training finished";
-
-    // Load test data
-    std::vector<std::vector<double>> testInputs;
-    std::vector<std::vector<double>> testTargets;
-    {
-        MnistCsvDataSet testSet(aMnistTestFile);
-        if (!testSet.isLoaded()) {
+    } else {
+        // Load train data. Images stay uint8 in the data set and are
+        // normalized sample by sample while training.
+        MnistCsvDataSet trainSet(aMnistTrainFile, aOptions.threads, true);
+        if (!trainSet.isLoaded()) {
             LOG_ERROR
                 << "Unable to load MNIST data from file "
                 << aMnistTrainFile;
             return;
         }
 
-        testInputs.resize(testSet.size());
-        testTargets.resize(testSet.size());
-        for (size_t i = 0; i < testSet.size(); ++i) {
-            testTargets[i] = toOneHot(testSet[i].first);
-            testInputs[i] = normalizeImage(testSet[i].second);
-        }
+        LOG_INFO << "Training started...";
+        network.train(MnistTrainingData(trainSet), aOptions);
     }
 
-    int correct = 0;
-    for (size_t i = 0; i < testInputs.size(); ++i) {
-        std::vector<double> output =
-            network.forward(testInputs[i]).back();
+    if (!network.isTrained()) {
+        LOG_ERROR << "Training failed";
+        return;
+    }
+    LOG_INFO << "Training finished";
 
-        // Get predicted number (Max number from predicted)
-        int predicted = std::distance(output.begin(),
-            std::max_element(output.begin(), output.end()));
-        int actual = std::distance(testTargets[i].begin(),
-            std::max_element(testTargets[i].begin(),
-            testTargets[i].end()));
+    if (!aMetricsFile.empty() &&
+        !saveMetricsToJson(aMetricsFile, network.trainingMetrics())) {
+        LOG_ERROR << "Unable to save training metrics to " << aMetricsFile;
+    }
 
-        if (predicted == actual) {
-            ++correct;
-        }
+    // Test the model on the streamed test data
+    const auto stats = recognize<double>(network, aMnistTestFile,
+        aOptions.threads, kForwardBatchSize, nullptr);
+    if (!stats || stats->count == 0) {
+        LOG_ERROR
+            << "Unable to load MNIST data from file "
+            << aMnistTestFile;
+        return;
     }
 
-    LOG_INFO << "Accuracy: " << (correct * 100.0 / testInputs.size()) << "%";
+    LOG_INFO << "Accuracy: " << (stats->matches * 100.0 / stats->count)
+             << "%";
 
-    // Save model to JSON
-    if (!saveModelToJson(aOutputModelFile, network)) {
-        LOG_ERROR << "Unable to save model to JSON";
-    } else {
-        LOG_INFO << "Model saved to model.json";
+    // Save model
+    if (!saveModel(aOutputModelFile, network, aPrecision)) {
+        LOG_ERROR << "Unable to save model to " << aOutputModelFile;
     }
 }
 
 void Application::handleRecognitionMode(const std::string& aDataFile,
-                                        const std::string& aModelFile,
-                                        const std::string& aResultFile) const {
+    const std::string& aModelFile, const std::string& aResultFile,
+    const RecognitionOptions& aOptions) const {
     LOG_INFO << "Recognition started...";
 
     if (!std::filesystem::exists(aModelFile)) {
@@ -549,80 +1107,172 @@ void Application::handleRecognitionMode(const std::string& aDataFile,
         return;
     }
 
-    if (!std::filesystem::exists(aDataFile)) {
+    if (!isStandardInput(aDataFile) && !std::filesystem::exists(aDataFile)) {
         LOG_ERROR << "Data file " << aDataFile << " does not exist";
         return;
     }
 
-    // Load model
-    Perceptron network;
-    if (!loadModelFromJson(aModelFile, network)) {
-        LOG_ERROR << "Failed to load model from " << aModelFile;
+    // The standard input can be read once only: for the results
+    if (isStandardInput(aDataFile) && aOptions.precision == Precision::INT8
+        && aOptions.calibrationFile.empty()) {
+        LOG_ERROR << "--calibration-data is required to recognize the "
+                  << "standard input in int8";
+        return;
+    }
+
+    // Results are written a batch at a time through this buffer
+    std::vector<char> resultBuffer(kResultBufferSize);
+    std::ofstream resultFile;
+    resultFile.rdbuf()->pubsetbuf(resultBuffer.data(), resultBuffer.size());
+    resultFile.open(aResultFile);
+    if (!resultFile.is_open()) {
+        LOG_ERROR << "Unable to create result file " << aResultFile;
         return;
     }
 
-    // Load data
-    std::vector<std::vector<double>> inputData;
-    std::vector<std::vector<double>> dummyTarget;
-    {
-        MnistCsvDataSet testSet(aDataFile);
-        if (!testSet.isLoaded()) {
-            LOG_ERROR << "Unable to load MNIST data from file " << aDataFile;
+    // Recognize. The data file is streamed through the pipeline, the
+    // threads parse, classify and write at the same time.
+    std::optional<RecognitionStats> stats;
+    if (aOptions.precision == Precision::FLOAT) {
+        FloatPerceptron network;
+        if (!loadModel(aModelFile, network)) {
+            LOG_ERROR << "Failed to load model from " << aModelFile;
             return;
         }
+        stats = recognize<float>(network, aDataFile, aOptions.threads,
+                                 aOptions.batchSize, &resultFile);
+    } else {
+        Perceptron network;
+        if (!loadModel(aModelFile, network)) {
+            LOG_ERROR << "Failed to load model from " << aModelFile;
+            return;
+        }
+
+        if (aOptions.precision == Precision::INT8) {
+            const std::string& calibrationFile =
+                aOptions.calibrationFile.empty()
+                    ? aDataFile : aOptions.calibrationFile;
+            QuantizedPerceptron quantized;
+            if (!quantize(network, calibrationFile, quantized)) {
+                LOG_ERROR << "Unable to quantize model " << aModelFile;
+                return;
+            }
 
-        inputData.resize(testSet.size());
-        dummyTarget.resize(testSet.size());
-        for (size_t i = 0; i < testSet.size(); ++i) {
-            dummyTarget[i] = toOneHot(testSet[i].first);
-            inputData[i] = normalizeImage(testSet[i].second);
+            stats = recognize<uint8_t>(quantized, aDataFile,
+                aOptions.threads, aOptions.batchSize, &resultFile);
+
+            // fp64 reference run, its results are not written anywhere.
+            // The standard input is gone by now, so it has none.
+            const auto reference = stats && !isStandardInput(aDataFile)
+                ? recognize<double>(network, aDataFile, aOptions.threads,
+                                    aOptions.batchSize, nullptr)
+                : std::nullopt;
+            if (reference && reference->count != 0) {
+                LOG_INFO << "fp64 accuracy: "
+                         << (reference->matches * 100.0 / reference->count)
+                         << "%, throughput: " << throughput(*reference)
+                         << " images/s";
+                LOG_INFO << "int8 accuracy delta: "
+                         << ((static_cast<double>(stats->matches) -
+                              reference->matches) * 100.0 / stats->count)
+                         << " percentage points, speedup: "
+                         << (throughput(*stats) / throughput(*reference))
+                         << "x";
+            }
+        } else {
+            stats = recognize<double>(network, aDataFile, aOptions.threads,
+                                      aOptions.batchSize, &resultFile);
         }
     }
 
-    double minPixel =
-        *std::min_element(inputData[0].begin(), inputData[0].end());
-    double maxPixel =
-        *std::max_element(inputData[0].begin(), inputData[0].end());
-    LOG_INFO << "Pixel value range: [" << minPixel << ", " << maxPixel << "]";
+    if (!stats) {
+        LOG_ERROR << "Recognition of " << aDataFile << " failed";
+        return;
+    }
 
-    std::ofstream resultFile(aResultFile);
-    if (!resultFile.is_open()) {
-        LOG_ERROR << "Unable to create result file " << aResultFile;
+    if (stats->count == 0) {
+        LOG_ERROR << "No MNIST data in file " << aDataFile;
         return;
     }
 
-    // Recognize
-    size_t matches = 0;
-    for (size_t i = 0; i < inputData.size(); ++i) {
-        std::vector<double> output = network.forward(inputData[i]).back();
-
-        auto maxPredictElementIter =
-            std::max_element(output.begin(), output.end());
-        int predictedClass =
-            std::distance(output.begin(), maxPredictElementIter);
-
-        int expectedClass = -1;
-        if (!dummyTarget[i].empty()) {
-            auto maxExpectedElementIter =
-                std::max_element(dummyTarget[i].begin(), dummyTarget[i].end());
-            expectedClass =
-                std::distance(dummyTarget[i].begin(), maxExpectedElementIter);
+    resultFile.flush();
+    if (!resultFile) {
+        LOG_ERROR << "Unable to write results to " << aResultFile;
+        return;
+    }
+
+    LOG_INFO << "Matches: " << stats->matches << " of " << stats->count;
+    LOG_INFO << "Recognition accuracy: " <<
+        (stats->matches * 100.0 / stats->count) << "%";
+    LOG_INFO << "Throughput: " << throughput(*stats) << " images/s";
+    LOG_INFO << "Recognition completed. Result saved to file " << aResultFile;
+}
+
+void Application::handleServeMode(const std::string& aModelFile,
+                                  const ServeOptions& aOptions) const {
+    if (!std::filesystem::exists(aModelFile)) {
+        LOG_ERROR << "Model file " << aModelFile << " does not exist";
+        return;
+    }
+
+    // The model is loaded once and shared by every request of the session
+    FloatPerceptron floatNetwork;
+    Perceptron network;
+    QuantizedPerceptron quantized;
+    MicroBatcher::Scorer scorer;
+    if (aOptions.precision == Precision::FLOAT) {
+        if (!loadModel(aModelFile, floatNetwork)) {
+            LOG_ERROR << "Failed to load model from " << aModelFile;
+            return;
+        }
+        scorer = scorerFor<float>(floatNetwork);
+    } else {
+        if (!loadModel(aModelFile, network)) {
+            LOG_ERROR << "Failed to load model from " << aModelFile;
+            return;
+        }
+
+        if (aOptions.precision == Precision::INT8) {
+            if (!quantize(network, aOptions.calibrationFile, quantized)) {
+                LOG_ERROR << "Unable to quantize model " << aModelFile;
+                return;
+            }
+            scorer = scorerFor<uint8_t>(quantized);
         } else {
-            LOG_ERROR << "Empty target at index " << i;
-            continue;
+            scorer = scorerFor<double>(network);
         }
+    }
 
-        // Write result to file
-        resultFile << "Expected: " << expectedClass
-            << "\tPredicted: " << predictedClass << std::endl;
+    MicroBatcher batcher(std::move(scorer), aOptions.batchSize,
+                         aOptions.latencyBudget, aOptions.threads);
+    RecognitionServer server(batcher, aOptions.format);
+    const bool isListening = aOptions.socketPath.empty()
+        ? server.listenTcp(aOptions.port)
+        : server.listenUnix(aOptions.socketPath);
+    if (!isListening) {
+        LOG_ERROR << server.lastError();
+        return;
+    }
 
-        if (expectedClass == predictedClass) {
-            ++matches;
-        }
+    LOG_INFO << "Serving on "
+             << (aOptions.socketPath.empty()
+                    ? "127.0.0.1:" + std::to_string(server.port())
+                    : aOptions.socketPath)
+             << ", stop with Ctrl+C";
+
+    stoppableServer = &server;
+    const auto previousInt = std::signal(SIGINT, stopServer);
+    const auto previousTerm = std::signal(SIGTERM, stopServer);
+    const bool isServed = server.serve();
+    std::signal(SIGINT, previousInt);
+    std::signal(SIGTERM, previousTerm);
+    stoppableServer = nullptr;
+
+    if (!isServed) {
+        LOG_ERROR << server.lastError();
     }
 
-    LOG_INFO << "Matches: " << matches << " of " << inputData.size();
-    LOG_INFO << "Recognition accuracy: " <<
-        (matches * 100.0 / inputData.size()) << "%";
-    LOG_INFO << "Recognition completed. Result saved to file " << aResultFile;
+    LOG_INFO << "Served " << batcher.images() << " images in "
+             << batcher.batches() << " batches over "
+             << server.connections() << " connections";
 }
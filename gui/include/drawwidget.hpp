@@ -9,8 +9,11 @@
 #include <QPaintEvent>
 #include <QMouseEvent>
 #include <QString>
+#include <QTimer>
 
-#include <vector>
+#include <chrono>  // NOLINT(build/c++11)
+
+#include "include/mnistcsvdataset.hpp"
 
 class DrawWidget final : public QWidget {
     Q_OBJECT
@@ -19,20 +22,42 @@ class DrawWidget final : public QWidget {
     explicit DrawWidget(QWidget *parent = nullptr);
     virtual ~DrawWidget() {}
 
-    // NOLINTNEXTLINE(runtime/references)
-    void getMnistCsvValues(std::vector<double>& aOutput) const;
+    const QImage& image() const;
+
+    // Downsamples aImage, e.g. one passed by imageDrawn(), into a MNIST
+    // image, centered by its center of mass if aCenter is set. Safe to
+    // call from any thread.
+    static bool getMnistImage(const QImage& aImage, bool aCenter,
+                              // NOLINTNEXTLINE(runtime/references)
+                              MnistCsvDataSet::Image_t& aOutput);
+
+    // Time between two frames of the screen the widget is on
+    std::chrono::microseconds frameInterval() const;
 
  public slots:
     void clear();
 
+ signals:
+    // The drawing changed. Emitted at most once per frame while drawing,
+    // the last stroke of a frame is passed on with the next one.
+    void imageDrawn(const QImage& aImage);
+
  protected:
     void paintEvent(QPaintEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
 
+ private:
+    void onFrameTimeout();
+    // Passes the drawing on and starts a new frame
+    void emitImage();
+
  private:
     QImage m_image;
     QPoint m_lastPoint;
+
+    QTimer *m_frameTimer = nullptr;
+    bool m_isFrameDirty = false;  // Drawn since imageDrawn() was emitted
 };
 
 #endif  // GUI_INCLUDE_DRAWWIDGET_HPP_
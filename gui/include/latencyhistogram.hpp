@@ -0,0 +1,41 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef GUI_INCLUDE_LATENCYHISTOGRAM_HPP_
+#define GUI_INCLUDE_LATENCYHISTOGRAM_HPP_
+
+#include <array>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <string>
+
+// Counts latencies in power of two buckets from 0.25 ms up, and how many
+// of them took longer than a budget, for the debug overlay of live
+// recognition
+class LatencyHistogram final {
+ public:
+    explicit LatencyHistogram(std::chrono::microseconds aBudget);
+
+    void add(std::chrono::microseconds aLatency);
+    void reset();
+
+    std::chrono::microseconds budget() const noexcept;
+    size_t count() const noexcept;
+    size_t countOverBudget() const noexcept;
+    std::chrono::microseconds max() const noexcept;
+
+    // The totals followed by one line per bucket with a bar of its share
+    std::string format() const;
+
+ private:
+    // Upper bounds of all buckets but the last one, which is open
+    static constexpr std::array<std::chrono::microseconds::rep, 8>
+        kBounds = {250, 500, 1000, 2000, 4000, 8000, 16000, 32000};
+
+    const std::chrono::microseconds m_budget;
+    std::array<size_t, kBounds.size() + 1> m_counts = {};
+    size_t m_count = 0;
+    size_t m_overBudget = 0;
+    std::chrono::microseconds m_max{0};
+};
+
+#endif  // GUI_INCLUDE_LATENCYHISTOGRAM_HPP_
@@ -3,12 +3,23 @@
 #ifndef GUI_INCLUDE_MAINWINDOW_HPP_
 #define GUI_INCLUDE_MAINWINDOW_HPP_
 
+#include <QAction>
+#include <QFileSystemWatcher>
+#include <QFuture>
+#include <QImage>
+#include <QLabel>
 #include <QMainWindow>
 #include <QProgressBar>
 #include <QPushButton>
 #include <QString>
+#include <QTimer>
 
-#include "include/perceptron.hpp"
+#include <chrono>  // NOLINT(build/c++11)
+#include <memory>
+#include <vector>
+
+#include "include/floatperceptron.hpp"
+#include "include/latencyhistogram.hpp"
 
 class DrawWidget;
 
@@ -17,22 +28,48 @@ class MainWindow final : public QMainWindow {
 
  public:
     explicit MainWindow(QWidget *parent = nullptr);
-    virtual ~MainWindow() {}
+    // Waits for a model that is still loading and a recognition that is
+    // still running
+    virtual ~MainWindow();
 
  private slots:
     // Main menu
     void onModelFileOpen();
     void onLearnModel();
+    void onLatencyOverlay(bool aIsShown);
     void onAbout();
 
     // Buttons
     void onRecognizeButtonClick();
     void onClearButtonClick();
 
+    // Model file watcher
+    void onModelFileChanged(const QString& aFileName);
+
+    // Recognizes the drawing as it is drawn
+    void onImageDrawn(const QImage& aImage);
+
  private:
+    // Loads m_modelFileName in the background, once the load running
+    // now (if any) is done
+    void loadModel();
+    void onModelLoaded(const QString& aFileName,
+                       std::shared_ptr<const FloatPerceptron> aNetwork);
+
+    // Runs a live recognition of aImage in the background
+    void recognizeLive(const QImage& aImage,
+                       std::chrono::steady_clock::time_point aDrawn);
+    void onLiveRecognized(const std::vector<float>& aScores,
+                          std::chrono::steady_clock::time_point aDrawn,
+                          unsigned aDrawing);
+
+    void showScores(const std::vector<float>& aScores);
+    void updateLatencyOverlay();
+
+    // Called from the loading thread, must not touch the window
     bool loadModelFromJson(const QString& aFileName,
                            // NOLINTNEXTLINE(runtime/references)
-                           Perceptron& aNetwork) const;
+                           FloatPerceptron& aNetwork) const;
 
  private:
     static constexpr int kNumberClasses = 10;  // numbers from 0 to 9
@@ -40,8 +77,30 @@ class MainWindow final : public QMainWindow {
     DrawWidget *m_drawWidget = nullptr;
     QPushButton *m_recButton = nullptr;
     QPushButton *m_clearButton = nullptr;
+    QAction *m_centerAction = nullptr;
+
+    QProgressBar *m_loadProgressBar = nullptr;
 
     QString m_modelFileName;
+    // Loaded once per file (change), every recognition reuses it
+    std::shared_ptr<const FloatPerceptron> m_network;
+    QFileSystemWatcher *m_modelWatcher = nullptr;
+    QTimer *m_reloadTimer = nullptr;  // Waits for a file write to settle
+    QFuture<void> m_loadFuture;
+    bool m_isLoading = false;
+    bool m_isReloadPending = false;  // The file changed while loading
+
+    // Live recognition runs one image at a time. Only the latest image
+    // drawn meanwhile waits, the ones before it are dropped.
+    QFuture<void> m_recognizeFuture;
+    bool m_isRecognizing = false;
+    QImage m_pendingImage;
+    std::chrono::steady_clock::time_point m_pendingDrawn;
+    unsigned m_drawing = 0;  // Counts clears, results of older ones are late
+
+    // Time from drawing to the scores on screen
+    std::unique_ptr<LatencyHistogram> m_latencies;
+    QLabel *m_latencyOverlay = nullptr;
 };
 
 #endif  // GUI_INCLUDE_MAINWINDOW_HPP_
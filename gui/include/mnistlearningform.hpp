@@ -3,13 +3,22 @@
 #ifndef GUI_INCLUDE_MNISTLEARNINGFORM_HPP_
 #define GUI_INCLUDE_MNISTLEARNINGFORM_HPP_
 
+#include <QComboBox>
 #include <QDialog>
+#include <QDoubleSpinBox>
+#include <QFuture>
+#include <QLabel>
 #include <QLineEdit>
+#include <QProgressBar>
 #include <QPushButton>
+#include <QSpinBox>
 
+#include <atomic>
 #include <string>
 #include <vector>
 
+#include "include/trainingoptions.hpp"
+
 class Perceptron;
 
 class MnistLearningForm final : public QDialog {
@@ -17,22 +26,40 @@ class MnistLearningForm final : public QDialog {
 
  public:
     explicit MnistLearningForm(QWidget *parent = nullptr);
+    // Stops training in progress and waits for it
      virtual ~MnistLearningForm();
 
  private slots:
     void onTrainFileButtonClick();
     void onOutputFileFuttonClick();
     void onTrainButtonClick();
+    void onCancelButtonClick();
     void OnTextEdit();
+    void onOptimizerChanged(int aIndex);
 
  private:
     bool saveModelToJson(const std::string& aFileName,
                          const Perceptron& aNetwork) const;
 
+    void showProgress(const TrainingProgress& aProgress);
+    // Back to the idle state after training ended for whatever reason
+    void finishTraining();
+
  private:
     QLineEdit *m_trainFileEdit = nullptr;
     QLineEdit *m_outputFileEdit = nullptr;
     QPushButton *m_trainButton = nullptr;
+    QSpinBox *m_epochsEdit = nullptr;
+    QSpinBox *m_batchSizeEdit = nullptr;
+    QComboBox *m_optimizerBox = nullptr;
+    QDoubleSpinBox *m_learningRateEdit = nullptr;
+
+    QProgressBar *m_progressBar = nullptr;
+    QLabel *m_progressLabel = nullptr;
+    QPushButton *m_cancelButton = nullptr;
+
+    QFuture<void> m_trainingFuture;
+    std::atomic<bool> m_stopTraining{false};  // Stop token of the training
 };
 
 #endif  // GUI_INCLUDE_MNISTLEARNINGFORM_HPP_
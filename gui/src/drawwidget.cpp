@@ -3,21 +3,44 @@
 #include "include/drawwidget.hpp"
 
 #include <QPainter>
+#include <QScreen>
+
+#include <cstdint>
+
+#include "include/mnistimage.hpp"
 
 namespace {
-static constexpr int kMnistImageWidth = 28;
-static constexpr int kMnistImageHeight = 28;
+// Drawing pixels averaged into one MNIST pixel along each side
+static constexpr int kDrawingScale = 10;
+static constexpr double kDefaultRefreshRate = 60.0;  // Hz
 }
 
 DrawWidget::DrawWidget(QWidget *parent)
     : QWidget(parent)
-    , m_image(280, 280, QImage::Format_Grayscale8) {
+    , m_image(kDrawingScale * mnistimage::kSide,
+              kDrawingScale * mnistimage::kSide,
+              QImage::Format_Grayscale8) {
     m_image.fill(Qt::white);
     setFixedSize(m_image.size());
+
+    m_frameTimer = new QTimer(this);
+    m_frameTimer->setSingleShot(true);
+    m_frameTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_frameTimer, &QTimer::timeout,
+            this, &DrawWidget::onFrameTimeout);
+}
+
+std::chrono::microseconds DrawWidget::frameInterval() const {
+    double refreshRate = screen() ? screen()->refreshRate() : 0.0;
+    if (refreshRate <= 0.0) {
+        refreshRate = kDefaultRefreshRate;
+    }
+    return std::chrono::microseconds(static_cast<int64_t>(1e6 / refreshRate));
 }
 
 void DrawWidget::clear() {
     m_image.fill(Qt::white);
+    m_isFrameDirty = false;
     update();
 }
 
@@ -41,21 +64,47 @@ void DrawWidget::mouseMoveEvent(QMouseEvent *event) {
         m_lastPoint = event->pos();
 
         update();
+
+        // The first stroke of a frame goes out right away, the others
+        // wait for the frame to end
+        if (m_frameTimer->isActive()) {
+            m_isFrameDirty = true;
+        } else {
+            emitImage();
+        }
     }
 }
 
-void DrawWidget::getMnistCsvValues(std::vector<double>& aOutput) const {
-    aOutput.clear();
+void DrawWidget::onFrameTimeout() {
+    if (m_isFrameDirty) {
+        emitImage();
+    }
+}
 
-    QImage scaled = m_image.scaled(28, 28,
-        Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-    aOutput.reserve(kMnistImageWidth * kMnistImageHeight);
+void DrawWidget::emitImage() {
+    m_isFrameDirty = false;
+    emit imageDrawn(m_image);
+    m_frameTimer->start(std::chrono::duration_cast<
+        std::chrono::milliseconds>(frameInterval()));
+}
 
-    for (int y = 0; y < kMnistImageHeight; ++y) {
-        for (int x = 0; x < kMnistImageWidth; ++x) {
-            double pixel = qGray(scaled.pixel(x, y));
-            pixel = 255 - pixel;  // MNIST: 0 = background, 255 = black
-            aOutput.emplace_back(pixel);
-        }
+const QImage& DrawWidget::image() const {
+    return m_image;
+}
+
+bool DrawWidget::getMnistImage(const QImage& aImage, bool aCenter,
+                               MnistCsvDataSet::Image_t& aOutput) {
+    // Rows are read straight from the image, which is kept grayscale
+    const QImage image = aImage.format() == QImage::Format_Grayscale8
+        ? aImage : aImage.convertToFormat(QImage::Format_Grayscale8);
+    if (!mnistimage::downsample(image.constBits(), image.width(),
+                                image.height(), image.bytesPerLine(),
+                                aOutput)) {
+        return false;
+    }
+
+    if (aCenter) {
+        mnistimage::centerByMass(aOutput);
     }
+    return true;
 }
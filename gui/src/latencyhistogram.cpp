@@ -0,0 +1,83 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/latencyhistogram.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+
+namespace {
+constexpr size_t kBarWidth = 20;
+
+std::string milliseconds(std::chrono::microseconds::rep aMicroseconds) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.2f ms", aMicroseconds / 1000.0);
+    return text;
+}
+}  // namespace
+
+
+LatencyHistogram::LatencyHistogram(std::chrono::microseconds aBudget)
+    : m_budget(aBudget) {
+}
+
+void LatencyHistogram::add(std::chrono::microseconds aLatency) {
+    const auto bucket = std::upper_bound(kBounds.begin(), kBounds.end(),
+                                         aLatency.count());
+    ++m_counts[std::distance(kBounds.begin(), bucket)];
+    ++m_count;
+    m_overBudget += aLatency > m_budget;
+    m_max = std::max(m_max, aLatency);
+}
+
+void LatencyHistogram::reset() {
+    m_counts.fill(0);
+    m_count = 0;
+    m_overBudget = 0;
+    m_max = std::chrono::microseconds::zero();
+}
+
+std::chrono::microseconds LatencyHistogram::budget() const noexcept {
+    return m_budget;
+}
+
+size_t LatencyHistogram::count() const noexcept {
+    return m_count;
+}
+
+size_t LatencyHistogram::countOverBudget() const noexcept {
+    return m_overBudget;
+}
+
+std::chrono::microseconds LatencyHistogram::max() const noexcept {
+    return m_max;
+}
+
+std::string LatencyHistogram::format() const {
+    std::string text = std::to_string(m_count) + " frames, max " +
+        milliseconds(m_max.count()) + ", " +
+        std::to_string(m_overBudget) + " over " +
+        milliseconds(m_budget.count()) + "\n";
+
+    const size_t largest = *std::max_element(m_counts.begin(),
+                                             m_counts.end());
+    for (size_t i = 0; i < m_counts.size(); ++i) {
+        char label[32];
+        if (i < kBounds.size()) {
+            std::snprintf(label, sizeof(label), "<%6.2f ms ",
+                          kBounds[i] / 1000.0);
+        } else {
+            std::snprintf(label, sizeof(label), ">%6.2f ms ",
+                          kBounds.back() / 1000.0);
+        }
+
+        const size_t width = largest ? m_counts[i] * kBarWidth / largest : 0;
+        text += label;
+        text += std::string(width, '#');
+        text += std::string(kBarWidth - width, ' ');
+        text += " " + std::to_string(m_counts[i]) + "\n";
+    }
+    text.pop_back();  // No newline after the last bucket
+    return text;
+}
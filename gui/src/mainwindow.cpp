@@ -12,10 +12,19 @@
 #include <QAction>
 #include <QMessageBox>
 #include <QFileDialog>
-
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QFontDatabase>
+#include <QKeySequence>
+#include <QStatusBar>
+#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
+#include <array>
 #include <string>
 #include <filesystem>  // NOLINT(build/c++17)
 #include <fstream>
+#include <utility>
 #include <vector>
 
 #include <boost/json.hpp>
@@ -25,6 +34,35 @@
 
 #include "include/drawwidget.hpp"
 #include "include/mnistlearningform.hpp"
+#include "include/mnisttrainingdata.hpp"
+#include "include/modelfile.hpp"
+
+namespace {
+// Editors write a file in several steps, the model is reloaded once the
+// file has not changed for that long
+constexpr int kReloadDelayMs = 200;
+
+// Scores of the digit drawn in aImage. False if the model does not fit
+// MNIST images.
+bool recognize(const FloatPerceptron& aNetwork, const QImage& aImage,
+               bool aCenter,
+               std::vector<float>& aScores) {  // NOLINT(runtime/references)
+    MnistCsvDataSet::Image_t image;
+    if (aNetwork.inputSize() != image.size() ||
+        !DrawWidget::getMnistImage(aImage, aCenter, image)) {
+        return false;
+    }
+
+    // Normalized just like the training data
+    std::array<float, MnistCsvDataSet::kMnistImageSize> input;
+    MnistTrainingData::normalize(image, input.data());
+
+    FloatPerceptron::Workspace workspace(aNetwork);
+    aScores.resize(aNetwork.outputSize());
+    return aNetwork.infer(input.data(), aScores.data(), workspace);
+}
+}  // namespace
+
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent) {
@@ -73,6 +111,31 @@ MainWindow::MainWindow(QWidget *parent)
     vMainLayout->addWidget(resultBox);
     centralWidget->setLayout(vMainLayout);
 
+    // Debug overlay over the drawing, the time every live recognition took
+    // from drawing to the scores shown against the frame interval
+    m_latencies = std::make_unique<LatencyHistogram>(
+        m_drawWidget->frameInterval());
+    m_latencyOverlay = new QLabel(m_drawWidget);
+    m_latencyOverlay->setFont(
+        QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    m_latencyOverlay->setStyleSheet(
+        "background-color: rgba(255, 255, 224, 200); padding: 2px;");
+    m_latencyOverlay->setAttribute(Qt::WA_TransparentForMouseEvents);
+    m_latencyOverlay->move(0, 0);
+    m_latencyOverlay->hide();
+
+    // Busy indicator shown while a model is loading
+    m_loadProgressBar = new QProgressBar(this);
+    m_loadProgressBar->setRange(0, 0);
+    m_loadProgressBar->setMaximumWidth(150);
+    m_loadProgressBar->hide();
+    statusBar()->addPermanentWidget(m_loadProgressBar);
+
+    m_modelWatcher = new QFileSystemWatcher(this);
+    m_reloadTimer = new QTimer(this);
+    m_reloadTimer->setSingleShot(true);
+    m_reloadTimer->setInterval(kReloadDelayMs);
+
     // Create main menu
     // Create File menu
     QMenu *fileMenu = menuBar()->addMenu("&File");
@@ -86,7 +149,19 @@ MainWindow::MainWindow(QWidget *parent)
     // Create model menu
     QMenu *modelMenu = menuBar()->addMenu("&Model");
     QAction *learnModelAction = new QAction("Learn model");
+    m_centerAction = new QAction("&Center drawings like MNIST", this);
+    m_centerAction->setCheckable(true);
+    m_centerAction->setChecked(true);
     modelMenu->addAction(learnModelAction);
+    modelMenu->addSeparator();
+    modelMenu->addAction(m_centerAction);
+
+    // Create View menu
+    QMenu *viewMenu = menuBar()->addMenu("&View");
+    QAction *latencyOverlayAction = new QAction("&Latency overlay");
+    latencyOverlayAction->setCheckable(true);
+    latencyOverlayAction->setShortcut(QKeySequence(Qt::Key_F12));
+    viewMenu->addAction(latencyOverlayAction);
 
     // Create Help menu
     QMenu *helpMenu = menuBar()->addMenu("&Help");
@@ -105,53 +180,257 @@ MainWindow::MainWindow(QWidget *parent)
     connect(openModelFileAction, SIGNAL(triggered()), this,
             SLOT(onModelFileOpen()));
     connect(learnModelAction, SIGNAL(triggered()), this, SLOT(onLearnModel()));
+    connect(latencyOverlayAction, SIGNAL(toggled(bool)), this,
+            SLOT(onLatencyOverlay(bool)));
     connect(aboutAction, SIGNAL(triggered()), this, SLOT(onAbout()));
+
+    // Model file
+    connect(m_modelWatcher, SIGNAL(fileChanged(QString)), this,
+            SLOT(onModelFileChanged(QString)));
+    connect(m_reloadTimer, &QTimer::timeout, this, &MainWindow::loadModel);
+
+    // Live recognition
+    connect(m_drawWidget, &DrawWidget::imageDrawn,
+            this, &MainWindow::onImageDrawn);
+}
+
+MainWindow::~MainWindow() {
+    // The threads post their results to this window
+    m_loadFuture.waitForFinished();
+    m_recognizeFuture.waitForFinished();
 }
 
 void MainWindow::onRecognizeButtonClick() {
-    if (m_modelFileName.isEmpty()) {
+    if (!m_network) {
+        if (m_isLoading) {
+            QMessageBox::information(this,
+                                     "Recognition",
+                                     "The model is still loading.");
+            return;
+        }
+
         QMessageBox::warning(this,
                              "Recognition warning",
-                             "Unable to recognize the number without"
+                             "Unable to recognize the number without "
                              "a learned model.\n\n"
                                    "Please, select model file.");
         return;
     }
 
-    Perceptron network{};
-    if (!loadModelFromJson(m_modelFileName, network)) {
+    std::vector<float> recResult;
+    if (!recognize(*m_network, m_drawWidget->image(),
+                   m_centerAction->isChecked(), recResult)) {
         QMessageBox::warning(this,
-                             "Training model warning",
-                             "Unable to load model");
+                             "Recognition warning",
+                             "The model does not fit the image");
         return;
     }
 
-    std::vector<double> imagePixels;
-    m_drawWidget->getMnistCsvValues(imagePixels);
+    showScores(recResult);
+}
+
+void MainWindow::onClearButtonClick() {
+    m_drawWidget->clear();
 
-    std::vector<double> recResult = network.forward(imagePixels).back();
+    // Recognitions of the cleared drawing must not show up any more
+    ++m_drawing;
+    m_pendingImage = QImage();
 
     for (int i = 0; i < kNumberClasses; ++i) {
-        m_progressBars[i]->setValue(static_cast<int>(recResult[i] * 100));
+        m_progressBars[i]->setValue(0);
+    }
+}
+
+void MainWindow::onImageDrawn(const QImage& aImage) {
+    // Without a model there is nothing to show, Recognize tells why
+    if (!m_network) {
+        return;
+    }
+
+    const auto drawn = std::chrono::steady_clock::now();
+    if (m_isRecognizing) {
+        // Replaces an image that has been waiting, its scores would be
+        // outdated before they were shown
+        m_pendingImage = aImage;
+        m_pendingDrawn = drawn;
+        return;
     }
 
-    return;
+    recognizeLive(aImage, drawn);
 }
 
-void MainWindow::onClearButtonClick() {
-    m_drawWidget->clear();
+void MainWindow::recognizeLive(
+    const QImage& aImage, std::chrono::steady_clock::time_point aDrawn) {
+    m_isRecognizing = true;
+
+    // The thread keeps the model alive even if another one is loaded
+    const std::shared_ptr<const FloatPerceptron> network = m_network;
+    const unsigned drawing = m_drawing;
+    const bool isCentered = m_centerAction->isChecked();
+    m_recognizeFuture = QtConcurrent::run([=]() {
+        std::vector<float> scores;
+        if (!recognize(*network, aImage, isCentered, scores)) {
+            scores.clear();
+        }
 
-    for (int i = 0; i < kNumberClasses; ++i) {
-        m_progressBars[i]->setValue(0);
+        QMetaObject::invokeMethod(this, [=]() {
+            onLiveRecognized(scores, aDrawn, drawing);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::onLiveRecognized(
+    const std::vector<float>& aScores,
+    std::chrono::steady_clock::time_point aDrawn, unsigned aDrawing) {
+    m_isRecognizing = false;
+
+    if (aDrawing == m_drawing && !aScores.empty()) {
+        showScores(aScores);
+        m_latencies->add(std::chrono::duration_cast<
+            std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - aDrawn));
+        updateLatencyOverlay();
     }
+
+    if (!m_pendingImage.isNull() && m_network) {
+        const QImage image = m_pendingImage;
+        m_pendingImage = QImage();
+        recognizeLive(image, m_pendingDrawn);
+    }
+}
+
+void MainWindow::showScores(const std::vector<float>& aScores) {
+    const int count = std::min(kNumberClasses,
+                               static_cast<int>(aScores.size()));
+    for (int i = 0; i < count; ++i) {
+        m_progressBars[i]->setValue(static_cast<int>(aScores[i] * 100));
+    }
+}
+
+void MainWindow::onLatencyOverlay(bool aIsShown) {
+    m_latencyOverlay->setVisible(aIsShown);
+    updateLatencyOverlay();
+}
+
+void MainWindow::updateLatencyOverlay() {
+    if (!m_latencyOverlay->isVisible()) {
+        return;
+    }
+
+    m_latencyOverlay->setText(QString::fromStdString(m_latencies->format()));
+    m_latencyOverlay->adjustSize();
 }
 
 void MainWindow::onModelFileOpen() {
-    m_modelFileName = QFileDialog::getOpenFileName(
+    const QString fileName = QFileDialog::getOpenFileName(
         this,
         "Select model file",
         QString(),
-        "All files (*);;JSON file (*.json)");
+        "All files (*);;JSON file (*.json);;Binary model (*.bin)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    if (!m_modelWatcher->files().isEmpty()) {
+        m_modelWatcher->removePaths(m_modelWatcher->files());
+    }
+    m_modelFileName = fileName;
+    m_modelWatcher->addPath(m_modelFileName);
+
+    // The previous model must not answer for the new file
+    m_network.reset();
+    m_reloadTimer->stop();
+    loadModel();
+}
+
+void MainWindow::onModelFileChanged(const QString& aFileName) {
+    if (aFileName != m_modelFileName) {
+        return;
+    }
+
+    // A file replaced by a rename drops out of the watcher
+    if (!m_modelWatcher->files().contains(aFileName) &&
+        QFileInfo::exists(aFileName)) {
+        m_modelWatcher->addPath(aFileName);
+    }
+    m_reloadTimer->start();
+}
+
+void MainWindow::loadModel() {
+    if (m_isLoading) {
+        m_isReloadPending = true;
+        return;
+    }
+
+    if (!QFileInfo::exists(m_modelFileName)) {
+        m_loadProgressBar->hide();
+        statusBar()->showMessage("Model file " + m_modelFileName +
+                                 " does not exist");
+        return;
+    }
+
+    statusBar()->showMessage("Loading model " + m_modelFileName + "...");
+    m_loadProgressBar->show();
+    m_isLoading = true;
+
+    const QString fileName = m_modelFileName;
+    m_loadFuture = QtConcurrent::run([this, fileName]() {
+        // Recognition runs in float, converted from a double model if
+        // needed. A model file is mapped into memory and may be rewritten
+        // while the model is in use, so its layers are copied into
+        // weights of their own.
+        auto network = std::make_shared<FloatPerceptron>();
+        const std::string modelFile = fileName.toStdString();
+        bool isLoaded = false;
+        if (modelfile::isModelFile(modelFile)) {
+            FloatPerceptron mapped{};
+            isLoaded = modelfile::load(modelFile, mapped) &&
+                network->initializeNetwork(mapped.layers());
+        } else {
+            isLoaded = loadModelFromJson(fileName, *network);
+        }
+        if (!isLoaded) {
+            network.reset();
+        }
+
+        QMetaObject::invokeMethod(this, [=]() {
+            onModelLoaded(fileName, network);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::onModelLoaded(
+    const QString& aFileName,
+    std::shared_ptr<const FloatPerceptron> aNetwork) {
+    m_isLoading = false;
+    if (m_isReloadPending) {
+        m_isReloadPending = false;
+        loadModel();
+        return;
+    }
+
+    m_loadProgressBar->hide();
+    // Another file was opened in the meantime
+    if (aFileName != m_modelFileName) {
+        return;
+    }
+
+    if (!aNetwork) {
+        statusBar()->clearMessage();
+        QMessageBox::warning(this,
+                             "Training model warning",
+                             "Unable to load model " + aFileName +
+                             (m_network ? "\n\nThe previous version of "
+                                          "the model stays in use."
+                                        : ""));
+        return;
+    }
+
+    m_network = std::move(aNetwork);
+    // Latencies of the previous model say nothing about this one
+    m_latencies->reset();
+    updateLatencyOverlay();
+    statusBar()->showMessage("Model " + aFileName + " loaded");
 }
 
 void MainWindow::onLearnModel() {
@@ -172,7 +451,7 @@ void MainWindow::onAbout() {
 }
 
 bool MainWindow::loadModelFromJson(const QString& aFileName,
-                                    Perceptron& aNetwork) const {
+                                    FloatPerceptron& aNetwork) const {
     std::string fileName = aFileName.toStdString();
 
     if (aFileName.isEmpty()) {
@@ -199,6 +478,10 @@ bool MainWindow::loadModelFromJson(const QString& aFileName,
         return false;
     }
 
+    if (!parsedJson.is_object()) {
+        return false;
+    }
+
     boost::json::object jsonModel = parsedJson.as_object();
     // Check if JSON has required fields and types
     if (!jsonModel.contains("architecture") ||
@@ -227,43 +510,49 @@ bool MainWindow::loadModelFromJson(const QString& aFileName,
         return false;
     }
 
-    // Set architecture
-    if (!aNetwork.initializeNetwork(architecture)) {
-        return false;
-    }
-
     const auto& jsonLayers = jsonModel["layers"].as_array();
     if (jsonLayers.size() != architecture.size() - 1) {
         return false;
     }
 
-    // Read weights and biases
+    // Read weights and biases straight into the layers, without drawing
+    // random initial weights first
+    std::vector<FloatLayer> layers;
     try {
+        layers.reserve(jsonLayers.size());
         for (size_t layerIndex = 0; layerIndex < jsonLayers.size();
              ++layerIndex) {
-            const auto& jsonLayer = jsonLayers[layerIndex];
-            for (size_t neuronIndex = 0;
-                 neuronIndex <
-                 jsonLayer.at("neurons").as_array().size();
+            FloatLayer& layer = layers.emplace_back(
+                architecture[layerIndex], architecture[layerIndex + 1],
+                FloatLayer::ActivationFunction::SIGMOID);
+
+            const auto& jsonNeurons =
+                jsonLayers[layerIndex].at("neurons").as_array();
+            if (jsonNeurons.size() != layer.size()) {
+                return false;
+            }
+
+            for (size_t neuronIndex = 0; neuronIndex < jsonNeurons.size();
                  ++neuronIndex) {
-                const auto& neuronJson =
-                    jsonLayer.at("neurons").as_array()[neuronIndex];
+                const auto& neuronJson = jsonNeurons[neuronIndex];
 
                 const auto& weightsJson =
                     neuronJson.at("weights").as_array();
-                std::vector<double> weights;
-                for (const auto& weight : weightsJson) {
-                    weights.emplace_back(weight.as_double());
+                if (weightsJson.size() != layer.inputs()) {
+                    return false;
                 }
 
-                aNetwork.setNeuronWeights(layerIndex, neuronIndex, weights);
-                aNetwork.setNeuronBias(layerIndex, neuronIndex,
-                                       neuronJson.at("bias").as_double());
+                float* weights = layer.row(neuronIndex);
+                for (const auto& weight : weightsJson) {
+                    *weights++ = static_cast<float>(weight.as_double());
+                }
+                layer.biases()[neuronIndex] = static_cast<float>(
+                    neuronJson.at("bias").as_double());
             }
         }
     } catch (const std::exception& e) {
         return false;
     }
 
-    return true;
+    return aNetwork.initializeNetwork(std::move(layers));
 }
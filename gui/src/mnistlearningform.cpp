@@ -10,17 +10,26 @@
 #include <QtConcurrent/QtConcurrent>
 #include <QMetaObject>
 #include <QMessageBox>
+#include <QProgressBar>
 
 #include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <filesystem>  // NOLINT(build/c++17)
+#include <fstream>
+#include <iterator>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 #include <utility>
 
 #include <boost/json.hpp>
 
+#include "include/modelfile.hpp"
+#include "include/optimizer.hpp"
 #include "include/perceptron.hpp"
 #include "include/logger.hpp"
 #include <include/mnistcsvdataset.hpp>
+#include <include/mnisttrainingdata.hpp>
 
 // Unnamed namespace to restrict the scope of constants to this translation unit
 namespace {
@@ -29,22 +38,31 @@ constexpr char kDelimeter = ',';
 constexpr int kNumClasses = 10;      // Numbers from 0 to 9
 constexpr int kImageSize = 28 * 28;  // Images 28 px x 28 px
 
-static inline std::vector<double> ToOneHot(uint8_t aLabel,
-            size_t aNumClasses = 10) {
-    std::vector<double> vec(aNumClasses, 0.0);
-    vec[aLabel] = 1.0;
-    return vec;
-}
-
-static inline std::vector<double> NormalizeImage(
-    const MnistCsvDataSet::Image_t& image) {
-    std::vector<double> result(image.size());
-
-    std::transform(image.begin(), image.end(), result.begin(),
-        [](uint8_t px) { return static_cast<double>(px) / 255.0; });
-
-    return result;
-}
+constexpr char kJsonModelFilter[] = "MNIST Trained model file (*.json)";
+constexpr char kBinaryModelFilter[] = "MNIST Binary model file (*.bin)";
+
+constexpr int kDefaultEpochs = 10;
+constexpr int kMaxEpochs = 100;
+constexpr int kDefaultBatchSize = 32;
+constexpr int kMaxBatchSize = 4096;
+
+// Progress is shown that often at most, and at the end of every epoch
+constexpr auto kProgressInterval = std::chrono::milliseconds(100);
+// Steps of the progress bar per epoch
+constexpr int kProgressSteps = 1000;
+
+// Optimizers offered by the form with a learning rate that suits each one
+struct OptimizerChoice {
+    OptimizerType type;
+    const char* label;
+    double learningRate;
+};
+
+constexpr OptimizerChoice kOptimizers[] = {
+    {OptimizerType::ADAM, "Adam", 0.001},
+    {OptimizerType::MOMENTUM, "Momentum", 0.05},
+    {OptimizerType::SGD, "SGD", 0.1},
+};
 }  // namespace
 
 MnistLearningForm::MnistLearningForm(QWidget *parent)
@@ -74,18 +92,72 @@ MnistLearningForm::MnistLearningForm(QWidget *parent)
     QGroupBox *inputBox = new QGroupBox(this);
     inputBox->setLayout(inputFilesLayout);
 
+    // Training parameters block
+    QGridLayout *parametersLayout = new QGridLayout(this);
+
+    m_epochsEdit = new QSpinBox(this);
+    m_epochsEdit->setRange(1, kMaxEpochs);
+    m_epochsEdit->setValue(kDefaultEpochs);
+    parametersLayout->addWidget(new QLabel("Epochs: ", this), 0, 0,
+                                Qt::AlignRight);
+    parametersLayout->addWidget(m_epochsEdit, 0, 1);
+
+    m_batchSizeEdit = new QSpinBox(this);
+    m_batchSizeEdit->setRange(1, kMaxBatchSize);
+    m_batchSizeEdit->setValue(kDefaultBatchSize);
+    parametersLayout->addWidget(new QLabel("Batch size: ", this), 1, 0,
+                                Qt::AlignRight);
+    parametersLayout->addWidget(m_batchSizeEdit, 1, 1);
+
+    m_optimizerBox = new QComboBox(this);
+    for (const auto& choice : kOptimizers) {
+        m_optimizerBox->addItem(choice.label);
+    }
+    parametersLayout->addWidget(new QLabel("Optimizer: ", this), 2, 0,
+                                Qt::AlignRight);
+    parametersLayout->addWidget(m_optimizerBox, 2, 1);
+
+    m_learningRateEdit = new QDoubleSpinBox(this);
+    m_learningRateEdit->setDecimals(5);
+    m_learningRateEdit->setRange(0.00001, 0.5);
+    m_learningRateEdit->setSingleStep(0.0005);
+    m_learningRateEdit->setValue(kOptimizers[0].learningRate);
+    parametersLayout->addWidget(new QLabel("Learning rate: ", this), 3, 0,
+                                Qt::AlignRight);
+    parametersLayout->addWidget(m_learningRateEdit, 3, 1);
+
+    QGroupBox *parametersBox = new QGroupBox("Training parameters", this);
+    parametersBox->setLayout(parametersLayout);
+
+    // Progress block
+    QVBoxLayout *progressLayout = new QVBoxLayout();
+    m_progressBar = new QProgressBar(this);
+    m_progressBar->setRange(0, kProgressSteps);
+    m_progressBar->setValue(0);
+    m_progressLabel = new QLabel("Not started", this);
+    progressLayout->addWidget(m_progressBar);
+    progressLayout->addWidget(m_progressLabel);
+
+    QGroupBox *progressBox = new QGroupBox("Progress", this);
+    progressBox->setLayout(progressLayout);
+
     // Buttons layout
     QHBoxLayout *buttonsLayout = new QHBoxLayout(this);
 
     m_trainButton = new QPushButton("Train model", this);
     m_trainButton->setEnabled(false);
+    m_cancelButton = new QPushButton("Cancel training", this);
+    m_cancelButton->setEnabled(false);
     QPushButton *closeButton = new QPushButton("Close", this);
 
     buttonsLayout->addStretch();
     buttonsLayout->addWidget(m_trainButton);
+    buttonsLayout->addWidget(m_cancelButton);
     buttonsLayout->addWidget(closeButton);
 
     mainLayout->addWidget(inputBox);
+    mainLayout->addWidget(parametersBox);
+    mainLayout->addWidget(progressBox);
     mainLayout->addLayout(buttonsLayout);
     setLayout(mainLayout);
 
@@ -99,11 +171,19 @@ MnistLearningForm::MnistLearningForm(QWidget *parent)
     connect(m_outputFileEdit, SIGNAL(textChanged(QString)),
             this, SLOT(OnTextEdit()));
 
+    connect(m_optimizerBox, SIGNAL(currentIndexChanged(int)),
+            this, SLOT(onOptimizerChanged(int)));
+
     connect(m_trainButton, SIGNAL(clicked()), this, SLOT(onTrainButtonClick()));
+    connect(m_cancelButton, SIGNAL(clicked()),
+            this, SLOT(onCancelButtonClick()));
     connect(closeButton, SIGNAL(clicked()), this, SLOT(close()));
 }
 
 MnistLearningForm::~MnistLearningForm() {
+    // The training thread posts its progress to this form
+    m_stopTraining = true;
+    m_trainingFuture.waitForFinished();
 }
 
 void MnistLearningForm::onTrainFileButtonClick() {
@@ -115,11 +195,19 @@ void MnistLearningForm::onTrainFileButtonClick() {
 }
 
 void MnistLearningForm::onOutputFileFuttonClick() {
+    QString selectedFilter;
     QString path = QFileDialog::getSaveFileName(this,
         "Save model file", QString(),
-        "MNIST Trained model file (.json)");
+        QString(kJsonModelFilter) + ";;" + kBinaryModelFilter,
+        &selectedFilter);
+
+    const QString extension =
+        selectedFilter == kBinaryModelFilter ? ".bin" : ".json";
+    if (!path.isEmpty() && !path.endsWith(extension)) {
+        path += extension;
+    }
 
-    m_outputFileEdit->setText(path.isEmpty() ? path : path + ".json");
+    m_outputFileEdit->setText(path);
 }
 
 void MnistLearningForm::OnTextEdit() {
@@ -132,6 +220,14 @@ void MnistLearningForm::OnTextEdit() {
     }
 }
 
+void MnistLearningForm::onOptimizerChanged(int aIndex) {
+    if (aIndex < 0 || aIndex >= static_cast<int>(std::size(kOptimizers))) {
+        return;
+    }
+
+    m_learningRateEdit->setValue(kOptimizers[aIndex].learningRate);
+}
+
 bool MnistLearningForm::saveModelToJson(const std::string& aFileName,
                                         const Perceptron& aNetwork) const {
     if (aFileName.empty()) {
@@ -224,52 +320,92 @@ bool MnistLearningForm::saveModelToJson(const std::string& aFileName,
 
 void MnistLearningForm::onTrainButtonClick() {
     m_trainButton->setEnabled(false);
+    m_cancelButton->setEnabled(true);
+    m_progressBar->setValue(0);
+    m_progressLabel->setText("Loading MNIST data...");
+    m_stopTraining = false;
 
     const std::string trainFile = m_trainFileEdit->text().toStdString();
     const std::string outputFile = m_outputFileEdit->text().toStdString();
 
-    QFuture<void> future = QtConcurrent::run([=]() {
-        std::vector<std::vector<double>> trainInputs;
-        std::vector<std::vector<double>> trainTargets;
+    TrainingOptions options;
+    options.epochs = m_epochsEdit->value();
+    options.batchSize = static_cast<size_t>(m_batchSizeEdit->value());
+    options.optimizer = kOptimizers[std::max(0,
+        m_optimizerBox->currentIndex())].type;
+    options.learningRate = m_learningRateEdit->value();
+    options.threads = std::max(1u, std::thread::hardware_concurrency());
+    options.stopToken = &m_stopTraining;
+
+    // Runs on the training thread after every batch, so only a report
+    // every kProgressInterval is passed on to the form
+    auto lastReport = std::chrono::steady_clock::time_point();
+    options.onProgress = [this, lastReport](
+            const TrainingProgress& aProgress) mutable {
+        const auto now = std::chrono::steady_clock::now();
+        if (!aProgress.isEpochDone && now - lastReport < kProgressInterval) {
+            return;
+        }
 
-        LOG_INFO << "Loading MNIST data...";
-        {
-            MnistCsvDataSet trainSet(trainFile);
-            if (!trainSet.isLoaded()) {
-                QMetaObject::invokeMethod(this, [=]() {
-                    QMessageBox::critical(this,
-                        "Error", "Failed to load training data");
-                    m_trainButton->setEnabled(true);
-                }, Qt::QueuedConnection);
-                return;
-            }
+        lastReport = now;
+        QMetaObject::invokeMethod(this, [this, aProgress]() {
+            showProgress(aProgress);
+        }, Qt::QueuedConnection);
+    };
 
-            trainInputs.resize(trainSet.size());
-            trainTargets.resize(trainSet.size());
-            for (size_t i = 0; i < trainSet.size(); ++i) {
-                trainTargets[i] = ToOneHot(trainSet[i].first);
-                trainInputs[i] = NormalizeImage(trainSet[i].second);
-            }
+    m_trainingFuture = QtConcurrent::run([=]() {
+        // Images stay uint8 and are normalized while training
+        LOG_INFO << "Loading MNIST data...";
+        MnistCsvDataSet trainSet(trainFile, options.threads, true);
+        if (!trainSet.isLoaded()) {
+            QMetaObject::invokeMethod(this, [=]() {
+                QMessageBox::critical(this,
+                    "Error", "Failed to load training data");
+                finishTraining();
+            }, Qt::QueuedConnection);
+            return;
         }
 
         LOG_INFO << "Training started...";
         Perceptron network({kImageSize, 256, 128, kNumClasses},
                            Neuron::ActivationFunction::SIGMOID);
         try {
-            network.train(trainInputs, trainTargets, 10, 0.0075);
+            network.train(MnistTrainingData(trainSet), options);
         } catch (const std::exception& e) {
+            const QString error = e.what();
             QMetaObject::invokeMethod(this, [=]() {
-                QMessageBox::critical(this, "Training Error", e.what());
-                m_trainButton->setEnabled(true);
+                QMessageBox::critical(this, "Training Error", error);
+                finishTraining();
+            }, Qt::QueuedConnection);
+            return;
+        }
+
+        // A cancel that comes after the last batch does not stop the
+        // training, the model is saved as usual then
+        if (!network.isTrained()) {
+            const bool isCancelled = m_stopTraining;
+            QMetaObject::invokeMethod(this, [=]() {
+                if (isCancelled) {
+                    m_progressLabel->setText("Training cancelled, the model "
+                                             "was not saved");
+                } else {
+                    QMessageBox::critical(this, "Training Error",
+                                          "Training failed");
+                }
+                finishTraining();
             }, Qt::QueuedConnection);
             return;
         }
 
         LOG_INFO << "Saving model...";
-        if (!saveModelToJson(outputFile, network)) {
+        const bool saved =
+            std::filesystem::path(outputFile).extension() == ".bin"
+            ? modelfile::save(outputFile, network)
+            : saveModelToJson(outputFile, network);
+        if (!saved) {
             QMetaObject::invokeMethod(this, [=]() {
                 QMessageBox::critical(this, "Error", "Failed to save model");
-                m_trainButton->setEnabled(true);
+                finishTraining();
             }, Qt::QueuedConnection);
             return;
         }
@@ -277,7 +413,42 @@ void MnistLearningForm::onTrainButtonClick() {
         QMetaObject::invokeMethod(this, [=] () {
             QMessageBox::information(this,
                 "Success", "Model saved successfully!");
-            m_trainButton->setEnabled(true);
+            finishTraining();
         }, Qt::QueuedConnection);
     });
 }
+
+void MnistLearningForm::onCancelButtonClick() {
+    // Takes effect after the batch in progress
+    m_stopTraining = true;
+    m_cancelButton->setEnabled(false);
+    m_progressLabel->setText("Cancelling...");
+}
+
+void MnistLearningForm::showProgress(const TrainingProgress& aProgress) {
+    // A cancelled training may still report its last batch
+    if (m_stopTraining) {
+        return;
+    }
+
+    // Until the first epoch is done the stream size is not known
+    const double epochShare = aProgress.epochSamples
+        ? static_cast<double>(aProgress.samples) / aProgress.epochSamples
+        : 0.0;
+    const double done = (aProgress.epoch - 1 + epochShare) /
+                        std::max(aProgress.epochs, 1);
+    m_progressBar->setValue(static_cast<int>(done * kProgressSteps));
+
+    m_progressLabel->setText(
+        QString("Epoch %1/%2: %3 samples, %4 samples/s, loss %5")
+            .arg(aProgress.epoch)
+            .arg(aProgress.epochs)
+            .arg(aProgress.samples)
+            .arg(aProgress.samplesPerSecond, 0, 'f', 0)
+            .arg(aProgress.loss, 0, 'f', 5));
+}
+
+void MnistLearningForm::finishTraining() {
+    m_cancelButton->setEnabled(false);
+    m_trainButton->setEnabled(true);
+}
@@ -0,0 +1,85 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_BOUNDEDQUEUE_HPP_
+#define LIB_INCLUDE_BOUNDEDQUEUE_HPP_
+
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <deque>
+#include <mutex>  // NOLINT(build/c++11)
+#include <optional>
+#include <utility>
+
+// Blocking multi-producer, multi-consumer FIFO of at most capacity()
+// items. A full queue blocks its producers, which keeps the memory of a
+// pipeline flat however fast its first stage is. close() ends the
+// stream: producers fail from then on, consumers drain what is left and
+// then get nullopt.
+template <typename T>
+class BoundedQueue final {
+ public:
+    explicit BoundedQueue(size_t aCapacity)
+        : m_capacity(aCapacity == 0 ? 1 : aCapacity) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    BoundedQueue(BoundedQueue&&) = delete;
+    BoundedQueue& operator=(BoundedQueue&&) = delete;
+
+    size_t capacity() const noexcept {
+        return m_capacity;
+    }
+
+    // Waits for room, returns false (dropping aItem) once closed
+    bool push(T aItem) {
+        std::unique_lock lock(m_mutex);
+        m_notFull.wait(lock, [this] {
+            return m_closed || m_items.size() < m_capacity;
+        });
+        if (m_closed) {
+            return false;
+        }
+
+        m_items.push_back(std::move(aItem));
+        lock.unlock();
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    // Waits for an item, nullopt once the queue is closed and empty
+    std::optional<T> pop() {
+        std::unique_lock lock(m_mutex);
+        m_notEmpty.wait(lock, [this] {
+            return m_closed || !m_items.empty();
+        });
+        if (m_items.empty()) {
+            return std::nullopt;
+        }
+
+        T item = std::move(m_items.front());
+        m_items.pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        return item;
+    }
+
+    void close() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_closed = true;
+        }
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+ private:
+    const size_t m_capacity;
+    std::deque<T> m_items;
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+    bool m_closed = false;
+};
+
+#endif  // LIB_INCLUDE_BOUNDEDQUEUE_HPP_
@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_FLOATPERCEPTRON_HPP_
+#define LIB_INCLUDE_FLOATPERCEPTRON_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "include/layer.hpp"
+#include "include/perceptron.hpp"
+
+// Single precision inference engine. Networks are trained in double
+// (Perceptron) and converted, or loaded from a float model file; float
+// halves the memory traffic and doubles the SIMD width of every forward
+// pass, which is plenty of precision for recognition.
+class FloatPerceptron {
+ public:
+    // Scratch buffers for infer(), see Perceptron::Workspace
+    class Workspace {
+     public:
+        Workspace() = default;
+        explicit Workspace(const FloatPerceptron& aNetwork);
+
+        void reserve(size_t aLayerSize);
+
+     private:
+        friend class FloatPerceptron;
+
+        std::vector<float> m_current;
+        std::vector<float> m_next;
+    };
+
+ public:
+    FloatPerceptron() = default;
+
+    // Rounds every parameter of aNetwork to float
+    explicit FloatPerceptron(const Perceptron& aNetwork);
+
+    // Every layer must take the outputs of the previous one as its inputs
+    bool initializeNetwork(std::vector<FloatLayer> aLayers);
+    bool isConfigured() const;
+
+    // Same contracts as the Perceptron functions of the same names
+    std::vector<std::vector<float>> forwardBatch(
+        const std::vector<float>& aInputs, size_t aCount) const;
+    bool infer(const float* aInput, float* aOutput,
+               // NOLINTNEXTLINE(runtime/references)
+               Workspace& aWorkspace) const;
+    bool infer(const std::vector<float>& aInput,
+               // NOLINTNEXTLINE(runtime/references)
+               std::vector<float>& aOutput) const;
+
+    size_t inputSize() const;
+    size_t outputSize() const;
+
+    const std::vector<FloatLayer>& layers() const;
+
+    // Double precision copy, e.g. to save it as JSON or train it further
+    Perceptron toPerceptron() const;
+
+ private:
+    std::vector<FloatLayer> m_layers;
+    size_t m_maxLayerSize = 0;
+    bool m_isConfigured = false;
+};
+
+#endif  // LIB_INCLUDE_FLOATPERCEPTRON_HPP_
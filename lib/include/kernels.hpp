@@ -0,0 +1,98 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_KERNELS_HPP_
+#define LIB_INCLUDE_KERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "include/neuron.hpp"
+
+// Vectorized math kernels used by the network hot paths.
+//
+// Every kernel exists in a portable scalar version and, on x86-64 builds,
+// in SSE2, AVX2 (+FMA), AVX-512 and AVX-512 VNNI versions; VNNI only
+// changes the integer dot product. The best version supported by
+// the running CPU is selected once at startup; setIsa() can pin a
+// specific one (tests, benchmarks).
+//
+// Every kernel takes double or float data. Vector kernels reorder the
+// summation and use a polynomial exp(), so their results differ from the
+// scalar path by at most (kFloat* tolerances for float data):
+//   dot(), gemm(), gemvTransposed():
+//                  kDotTolerance * sum(|a[i] * b[i]|)
+//   sigmoid()    : kActivationTolerance (absolute, output is in [0, 1])
+//   relu()       : exact
+// The integer dot() of quantized inference is exact on every path.
+namespace kernels {
+
+enum class Isa {
+    SCALAR,
+    SSE2,
+    AVX2,
+    AVX512,
+    AVX512_VNNI
+};
+
+constexpr double kDotTolerance = 1e-13;
+constexpr double kActivationTolerance = 1e-14;
+constexpr double kFloatDotTolerance = 1e-5;
+constexpr double kFloatActivationTolerance = 1e-6;
+
+// Best instruction set supported by both the build and the running CPU
+Isa detectIsa() noexcept;
+// Instruction set used by the kernels right now
+Isa activeIsa() noexcept;
+// Returns false (and keeps the current one) if aIsa is not supported
+bool setIsa(Isa aIsa) noexcept;
+bool isSupported(Isa aIsa) noexcept;
+const char* isaName(Isa aIsa) noexcept;
+
+// Returns sum(aLhs[i] * aRhs[i]) for i in [0, aSize)
+double dot(const double* aLhs, const double* aRhs, size_t aSize) noexcept;
+float dot(const float* aLhs, const float* aRhs, size_t aSize) noexcept;
+// Exact as long as the sum fits int32, i.e. for aSize below 66000
+int32_t dot(const uint8_t* aLhs, const int8_t* aRhs, size_t aSize) noexcept;
+
+// Product of a weight matrix (aRows rows of aDepth values) with one
+// input, aOutput[j] = dot(aInput, aWeights + j * aDepth, aDepth). Every
+// chunk of the input is loaded once for four rows.
+void gemv(const uint8_t* aInput, const int8_t* aWeights, size_t aRows,
+          size_t aDepth, int32_t* aOutput) noexcept;
+
+// Matrix product of aCount inputs (rows of aDepth values) with the
+// transposed weight matrix (aRows rows of aDepth values):
+//   aOutput[i * aRows + j] = dot(aInputs + i * aDepth,
+//                                aWeights + j * aDepth, aDepth)
+// Blocked so a panel of weights is reused from cache across the batch.
+void gemm(const double* aInputs, size_t aCount,
+          const double* aWeights, size_t aRows, size_t aDepth,
+          double* aOutput) noexcept;
+void gemm(const float* aInputs, size_t aCount,
+          const float* aWeights, size_t aRows, size_t aDepth,
+          float* aOutput) noexcept;
+
+// Product of the transposed weight matrix (aRows rows of aDepth values)
+// with aVector (aRows values), e.g. the errors a layer passes back to its
+// inputs:
+//   aOutput[i] = sum(aVector[j] * aWeights[j * aDepth + i]) over j
+// for i in [0, aDepth). The rows are read in order, four at a time,
+// instead of walking the matrix column by column.
+void gemvTransposed(const double* aVector, const double* aWeights,
+                    size_t aRows, size_t aDepth, double* aOutput) noexcept;
+void gemvTransposed(const float* aVector, const float* aWeights,
+                    size_t aRows, size_t aDepth, float* aOutput) noexcept;
+
+// In-place activation over a whole array (e.g. a layer's outputs)
+void sigmoid(double* aValues, size_t aSize) noexcept;
+void sigmoid(float* aValues, size_t aSize) noexcept;
+void relu(double* aValues, size_t aSize) noexcept;
+void relu(float* aValues, size_t aSize) noexcept;
+void activate(Neuron::ActivationFunction aFunction,
+              double* aValues, size_t aSize) noexcept;
+void activate(Neuron::ActivationFunction aFunction,
+              float* aValues, size_t aSize) noexcept;
+
+}  // namespace kernels
+
+#endif  // LIB_INCLUDE_KERNELS_HPP_
@@ -0,0 +1,197 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_LAYER_HPP_
+#define LIB_INCLUDE_LAYER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "include/neuron.hpp"
+
+// Fully connected layer. All weights of the layer live in one dense
+// row-major matrix (one row of inputs() weights per neuron) followed by
+// a separate bias vector, so a forward pass walks contiguous memory.
+// The parameters are either owned by the layer or live in external
+// memory (e.g. a memory-mapped model file) kept alive by the layer.
+//
+// T is the scalar type of the parameters and of the values passed
+// through the layer: double for training (Layer), float for the faster
+// inference engine (FloatLayer). Both are instantiated in layer.cpp.
+template <typename T>
+class BasicLayer {
+ public:
+    using value_type = T;
+    using ActivationFunction = Neuron::ActivationFunction;
+
+    // Non-owning view over a contiguous block of parameters
+    template <typename U>
+    class ArrayView {
+     public:
+        using value_type = std::remove_const_t<U>;
+        using iterator = U*;
+        using const_iterator = U*;
+
+        ArrayView(U* aData, size_t aSize) noexcept
+            : m_data(aData), m_size(aSize) {}
+
+        U* begin() const noexcept { return m_data; }
+        U* end() const noexcept { return m_data + m_size; }
+        U* data() const noexcept { return m_data; }
+        size_t size() const noexcept { return m_size; }
+        bool empty() const noexcept { return m_size == 0; }
+        U& operator[](size_t aIndex) const noexcept {
+            return m_data[aIndex];
+        }
+
+     private:
+        U* m_data;
+        size_t m_size;
+    };
+
+    // Read-only view over a single row of the weight matrix
+    using WeightsView = ArrayView<const T>;
+
+    // Per-neuron compatibility view for callers that still walk
+    // the network neuron by neuron (model serialization, inspection)
+    class NeuronView {
+     public:
+        NeuronView(const BasicLayer& aLayer, size_t aIndex) noexcept
+            : m_layer(&aLayer), m_index(aIndex) {}
+
+        T bias() const noexcept;
+        T weight(size_t aIndex) const noexcept;
+        WeightsView cweights() const noexcept;
+
+     private:
+        const BasicLayer* m_layer;
+        size_t m_index;
+    };
+
+    class const_iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = NeuronView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = NeuronView;
+
+        const_iterator(const BasicLayer& aLayer, size_t aIndex) noexcept
+            : m_layer(&aLayer), m_index(aIndex) {}
+
+        NeuronView operator*() const noexcept {
+            return NeuronView(*m_layer, m_index);
+        }
+
+        const_iterator& operator++() noexcept {
+            ++m_index;
+            return *this;
+        }
+
+        bool operator==(const const_iterator& aOther) const noexcept {
+            return m_layer == aOther.m_layer && m_index == aOther.m_index;
+        }
+
+        bool operator!=(const const_iterator& aOther) const noexcept {
+            return !(*this == aOther);
+        }
+
+     private:
+        const BasicLayer* m_layer;
+        size_t m_index;
+    };
+
+    // Training state of the optimizer (momentum velocity, Adam moments)
+    // kept next to the parameters: slotCount arrays laid out like weights()
+    // followed by slotCount arrays laid out like biases()
+    struct OptimizerState {
+        std::vector<T> weights;
+        std::vector<T> biases;
+        size_t slotCount = 0;  // Not "slots", which Qt defines as a macro
+        uint64_t step = 0;  // Batches applied with this state
+    };
+
+ public:
+    BasicLayer(size_t aInputs, size_t aNeurons, ActivationFunction aFunction);
+
+    // Layer over external parameters: aWeights holds aNeurons x aInputs
+    // values, aBiases aNeurons values. aOwner keeps that memory alive for
+    // as long as the layer (and any copy of it) uses it.
+    BasicLayer(size_t aInputs, size_t aNeurons, ActivationFunction aFunction,
+               T* aWeights, T* aBiases, std::shared_ptr<const void> aOwner);
+
+    // A copy always owns its parameters, even when the source does not
+    BasicLayer(const BasicLayer& aOther);
+    BasicLayer& operator=(const BasicLayer& aOther);
+
+    // Owning copy of a layer of the other precision, every parameter
+    // converted to T
+    template <typename U>
+    explicit BasicLayer(const BasicLayer<U>& aOther);
+
+    BasicLayer(BasicLayer&&) noexcept = default;
+    BasicLayer& operator=(BasicLayer&&) noexcept = default;
+
+    size_t size() const noexcept;
+    size_t inputs() const noexcept;
+    ActivationFunction function() const noexcept;
+
+    T* row(size_t aNeuronIndex) noexcept;
+    const T* row(size_t aNeuronIndex) const noexcept;
+    ArrayView<T> weights() noexcept;
+    ArrayView<const T> cweights() const noexcept;
+    ArrayView<T> biases() noexcept;
+    ArrayView<const T> cbiases() const noexcept;
+
+    // False when the parameters live in external memory
+    bool ownsParameters() const noexcept;
+    OptimizerState& optimizerState() noexcept;
+    const OptimizerState& optimizerState() const noexcept;
+
+    NeuronView operator[](size_t aNeuronIndex) const noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+
+    // aOutput[j] = activate(row(j) * aInput + bias[j]) for every neuron.
+    // aInput holds inputs() values, aOutput has room for size() values.
+    void forward(const T* aInput, T* aOutput) const noexcept;
+
+    // Same for aCount inputs stored row after row. aOutput receives
+    // aCount rows of size() values. Computed as one blocked matrix product.
+    void forwardBatch(const T* aInputs, size_t aCount,
+                      T* aOutput) const noexcept;
+
+    // Back propagation. Turns aErrors, the errors at the outputs aOutput
+    // that forward() produced, into the deltas of the neurons in place.
+    // The derivative of the activation is taken from the outputs, so the
+    // activation is not evaluated again.
+    void deltas(const T* aOutput, T* aErrors) const noexcept;
+
+    // Errors at the inputs of the layer for aDeltas, aErrors has room for
+    // inputs() values. One pass over the weights, row after row.
+    void inputErrors(const T* aDeltas, T* aErrors) const noexcept;
+
+    T activate(T aValue) const noexcept;
+    T activateDerivative(T aValue) const noexcept;
+
+ private:
+    std::vector<T> m_storage;  // Own weights and biases, if any
+    std::shared_ptr<const void> m_owner;  // Keeps external parameters alive
+    T* m_weights;  // size() x inputs(), row-major
+    T* m_biases;
+    size_t m_size;
+    OptimizerState m_optimizerState;
+    size_t m_inputs;
+    ActivationFunction m_function;
+};
+
+using Layer = BasicLayer<double>;
+using FloatLayer = BasicLayer<float>;
+
+extern template class BasicLayer<double>;
+extern template class BasicLayer<float>;
+
+#endif  // LIB_INCLUDE_LAYER_HPP_
@@ -0,0 +1,80 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_MICROBATCHER_HPP_
+#define LIB_INCLUDE_MICROBATCHER_HPP_
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>  // NOLINT(build/c++11)
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "include/mnistcsvdataset.hpp"
+
+// Groups single images submitted by concurrent callers into batches, so a
+// server answering many small requests still runs the network on whole
+// batches. A batch starts as soon as it is full, or once its oldest image
+// has waited for the latency budget, whichever comes first.
+class MicroBatcher final {
+ public:
+    using Image = MnistCsvDataSet::Image_t;
+    using Scores = std::vector<float>;  // One score per class
+
+    // Scores every image of aImages, in order. Called by all workers at
+    // once; an exception fails every request of the batch.
+    using Scorer =
+        std::function<std::vector<Scores>(const std::vector<Image>& aImages)>;
+
+    // aWorkers threads (at least one) run aScorer on batches of at most
+    // aMaxBatch images
+    MicroBatcher(Scorer aScorer, size_t aMaxBatch,
+                 std::chrono::microseconds aLatencyBudget,
+                 size_t aWorkers = 1);
+    // Scores the images still waiting, then stops the workers
+    ~MicroBatcher();
+
+    MicroBatcher(const MicroBatcher&) = delete;
+    MicroBatcher& operator=(const MicroBatcher&) = delete;
+
+    MicroBatcher(MicroBatcher&&) = delete;
+    MicroBatcher& operator=(MicroBatcher&&) = delete;
+
+    // Queues aImage, the future gets its scores once its batch is done
+    std::future<Scores> submit(const Image& aImage);
+
+    size_t maxBatch() const noexcept;
+    std::chrono::microseconds latencyBudget() const noexcept;
+
+    // Batches and images scored so far
+    size_t batches() const noexcept;
+    size_t images() const noexcept;
+
+ private:
+    struct Request {
+        Image image;
+        std::promise<Scores> scores;
+        std::chrono::steady_clock::time_point arrival;
+    };
+
+    void workerLoop();
+
+    const Scorer m_scorer;
+    const size_t m_maxBatch;
+    const std::chrono::microseconds m_latencyBudget;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Request> m_queue;
+    bool m_stop = false;
+
+    std::atomic<size_t> m_batches{0};
+    std::atomic<size_t> m_images{0};
+    std::vector<std::thread> m_workers;
+};
+
+#endif  // LIB_INCLUDE_MICROBATCHER_HPP_
@@ -4,10 +4,11 @@
 #define LIB_INCLUDE_MNISTCSVDATASET_HPP_
 
 #include <array>
-#include <fstream>
-#include <mutex>  // NOLINT(build/c++11)
-#include <shared_mutex>
-#include <sstream>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -26,8 +27,17 @@ class MnistCsvDataSet final {
     using Entry_t = std::pair<Label_t, Image_t>;
     using container_type = std::vector<Entry_t>;
 
-    explicit MnistCsvDataSet(const std::string& aCsvPath) {
-        m_isLoaded = loadCsv(aCsvPath);
+    // aThreads workers parse separate parts of the file in parallel,
+    // 0 takes one per hardware thread.
+    //
+    // With aUseCache the parsed entries are also stored in a binary cache
+    // next to the CSV file (see cachePath()). Later loads of the same,
+    // unchanged (size and modification time) CSV file map the cache
+    // instead of parsing the text; the entries are then used straight
+    // from the mapped file without copying.
+    explicit MnistCsvDataSet(const std::string& aCsvPath,
+                             size_t aThreads = 1, bool aUseCache = false) {
+        m_isLoaded = load(aCsvPath, aThreads, aUseCache);
     }
 
     MnistCsvDataSet(const MnistCsvDataSet& aOther) = delete;
@@ -38,96 +48,84 @@ class MnistCsvDataSet final {
 
     ~MnistCsvDataSet() = default;
 
+    // The entries never change once the constructor returns, so the
+    // accessors are plain loads and any number of threads may read them
+    // without locking. To reload, construct a new data set and publish it
+    // as a whole, e.g. with std::atomic_store on a
+    // std::shared_ptr<const MnistCsvDataSet>.
     std::size_t size() const noexcept {
-        std::shared_lock lock(m_mutex);
-        return m_data.size();
+        return m_size;
     }
 
     const Entry_t& operator[](std::size_t aIndex) const noexcept {
-        std::shared_lock lock(m_mutex);
-        return m_data[aIndex];
+        return m_entries[aIndex];
     }
 
     const Entry_t& at(std::size_t aIndex) const {
-        std::shared_lock lock(m_mutex);
-        return m_data.at(aIndex);
+        if (aIndex >= m_size) {
+            throw std::out_of_range("MnistCsvDataSet index out of range");
+        }
+        return m_entries[aIndex];
     }
 
     bool isLoaded() const noexcept {
         return m_isLoaded;
     }
 
- private:
-    bool loadCsv(const std::string& aPath) {
-        std::ifstream file(aPath);
-        if (!file.is_open()) {
-            return false;
-        }
-
-        std::vector<Entry_t> temp;
-        std::string line;
-
-        // A first line is a header, skip it
-        std::getline(file, line);
-
-        while (std::getline(file, line)) {
-            try {
-                temp.emplace_back(parseLine(line));
-            } catch (...) {
-                return false;
-            }
-        }
-
-        std::unique_lock lock(m_mutex);
-        m_data = std::move(temp);
-
-        return true;
+    // True when the entries come from the mapped binary cache
+    bool isCached() const noexcept {
+        return m_isCached;
     }
 
-    static Entry_t parseLine(const std::string& aLine) {
-        std::istringstream ss(aLine);
-        std::string token;
-
-        // Get label
-        if (!std::getline(ss, token, kMnistCsvDelimiter)) {
-            throw std::runtime_error("Missing label in CSV file");
-        }
-
-        int value = std::stoi(token);
-        if (value < 0 || value > 9) {
-            throw std::runtime_error("Invalid label value: " +
-                                     std::to_string(value));
-        }
-        Label_t label = static_cast<Label_t>(value);
-
-        // Get image
-        Image_t image{};
-        std::size_t pixelCount = 0;
-        while (std::getline(ss, token, kMnistCsvDelimiter)) {
-            if (pixelCount >= kMnistImageSize) {
-                throw std::runtime_error("Too many pixel values in line");
-            }
-
-            value = std::stoi(token);
-            if (value < 0 || value > 255) {
-                throw std::runtime_error("Pixel out of range: " +
-                                         std::to_string(value));
-            }
-
-            image[pixelCount++] = static_cast<Pixel_t>(value);
-        }
-
-        if (pixelCount != kMnistImageSize) {
-            throw std::runtime_error("Invalid pixel count: expected " +
-                    std::to_string(kMnistImageSize) + ", got " +
-                    std::to_string(pixelCount));
-        }
-
-        return {label, image};
+    // Why loading failed, e.g. "Line 12: Pixel out of range: 300".
+    // Empty when the data set is loaded.
+    const std::string& lastError() const noexcept {
+        return m_lastError;
     }
 
-    container_type m_data;
-    mutable std::shared_mutex m_mutex;
+    // Binary cache file used for aCsvPath
+    static std::string cachePath(const std::string& aCsvPath);
+
+    // Writes the cache of the complete CSV file aCsvPath from aCount
+    // entries, aEntry(i, entry) filling in entry i, as if the file had
+    // been loaded with aUseCache. The entries are streamed to the cache,
+    // so data sets larger than memory can be cached without parsing them;
+    // they must be the ones of the CSV file.
+    static bool createCache(
+        const std::string& aCsvPath, size_t aCount,
+        const std::function<void(size_t, Entry_t&)>& aEntry);
+
+    // Parses one CSV line [aFirst, aLast) (label, then kMnistImageSize
+    // pixels, no newline) into aEntry the way the data set does. On
+    // failure aError explains why, e.g. "Pixel out of range: 300".
+    static bool parseLine(const char* aFirst, const char* aLast,
+                          Entry_t& aEntry,  // NOLINT(runtime/references)
+                          std::string& aError);  // NOLINT(runtime/references)
+
+ private:
+    bool load(const std::string& aPath, size_t aThreads, bool aUseCache);
+
+    // Scans the whole file in place (memory-mapped), no per-line or
+    // per-token allocations. The file is split into newline aligned
+    // chunks, each parsed by its own worker straight into its section of
+    // the entries. Inputs that cannot be mapped (pipes, FIFOs, devices)
+    // are read into memory first and then scanned the same way.
+    bool loadCsv(const std::string& aPath, size_t aThreads);
+
+    // The cache is up to date while the size and the modification time
+    // (nanoseconds) of the CSV file match the ones stored in it
+    bool loadCache(const std::string& aCsvPath, uint64_t aCsvSize,
+                   int64_t aCsvTime);
+    bool saveCache(const std::string& aCsvPath, uint64_t aCsvSize,
+                   int64_t aCsvTime) const;
+
+    // Immutable snapshot of the entries: a parsed container_type or the
+    // mapped cache, kept alive by m_owner
+    std::shared_ptr<const void> m_owner;
+    const Entry_t* m_entries = nullptr;
+    std::size_t m_size = 0;
+    std::string m_lastError;
+    bool m_isCached = false;
     bool m_isLoaded = false;
 };
 
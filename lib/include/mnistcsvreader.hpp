@@ -0,0 +1,78 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_MNISTCSVREADER_HPP_
+#define LIB_INCLUDE_MNISTCSVREADER_HPP_
+
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "include/mnistcsvdataset.hpp"
+
+// Forward-only reader of a MNIST CSV file or stream, for data that does
+// not fit in memory. Entries are handed out in batches; only the current
+// batch and one read buffer are held at a time, however long the input
+// is. Lines are parsed and validated exactly as MnistCsvDataSet does.
+class MnistCsvReader final {
+ public:
+    using Entries = std::vector<MnistCsvDataSet::Entry_t>;
+
+    // Path that reads the standard input
+    static constexpr char kStandardInput[] = "-";
+
+    // Reads aInput, which must outlive the reader
+    explicit MnistCsvReader(
+        std::istream& aInput);  // NOLINT(runtime/references)
+    // Opens aPath, or reads the standard input for kStandardInput
+    explicit MnistCsvReader(const std::string& aPath);
+
+    MnistCsvReader(const MnistCsvReader&) = delete;
+    MnistCsvReader& operator=(const MnistCsvReader&) = delete;
+
+    MnistCsvReader(MnistCsvReader&&) = delete;
+    MnistCsvReader& operator=(MnistCsvReader&&) = delete;
+
+    bool isOpen() const noexcept;
+
+    // Replaces aEntries with the next at most aCount entries and returns
+    // how many there are, 0 at the end of the input. A line that does not
+    // parse ends the input early: the entries before it are still
+    // returned, then failed() is set.
+    size_t read(Entries& aEntries,  // NOLINT(runtime/references)
+                size_t aCount);
+
+    // Starts over from the first entry. False for streams that cannot
+    // seek (e.g. the standard input or a pipe).
+    bool rewind();
+
+    bool failed() const noexcept;
+
+    // Why reading failed, e.g. "Line 12: Pixel out of range: 300"
+    const std::string& lastError() const noexcept;
+
+ private:
+    // Moves the unread rest of the buffer to its front and appends as
+    // much of the input as fits. False when nothing new was read.
+    bool refill();
+
+    // Next line without its newline, false at the end of the input
+    bool nextLine(const char*& aFirst,  // NOLINT(runtime/references)
+                  const char*& aLast);  // NOLINT(runtime/references)
+
+    void fail(const std::string& aError);
+
+    std::ifstream m_file;
+    std::istream* m_input;
+    std::streampos m_start;  // Where rewind() returns to, -1 if it cannot
+    std::vector<char> m_buffer;
+    size_t m_begin = 0;  // Unread bytes of m_buffer are [m_begin, m_end)
+    size_t m_end = 0;
+    size_t m_line = 0;   // Lines consumed so far, the header included
+    bool m_isOpen = false;
+    bool m_failed = false;
+    std::string m_lastError;
+};
+
+#endif  // LIB_INCLUDE_MNISTCSVREADER_HPP_
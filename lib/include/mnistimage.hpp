@@ -0,0 +1,33 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_MNISTIMAGE_HPP_
+#define LIB_INCLUDE_MNISTIMAGE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "include/mnistcsvdataset.hpp"
+
+// Turns drawings into MNIST images, the way MNIST digits were prepared
+namespace mnistimage {
+
+constexpr size_t kSide = 28;  // MNIST images are kSide x kSide pixels
+static_assert(kSide * kSide == MnistCsvDataSet::kMnistImageSize);
+
+// Averages aPixels over boxes of (aWidth / kSide) x (aHeight / kSide)
+// pixels into aImage, reading the rows straight from memory. aPixels is a
+// grayscale drawing, dark ink on a light background, of aWidth x aHeight
+// bytes with aStride bytes from row to row; both sizes must be multiples
+// of kSide. MNIST pixels are ink: 0 is background, 255 black.
+bool downsample(const uint8_t* aPixels, size_t aWidth, size_t aHeight,
+                size_t aStride,
+                MnistCsvDataSet::Image_t& aImage);  // NOLINT
+
+// Shifts aImage by whole pixels so that the center of mass of its ink
+// lands on the center of the image. Ink shifted past an edge is lost. An
+// empty image is left as it is.
+void centerByMass(MnistCsvDataSet::Image_t& aImage);  // NOLINT
+
+}  // namespace mnistimage
+
+#endif  // LIB_INCLUDE_MNISTIMAGE_HPP_
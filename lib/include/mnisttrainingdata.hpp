@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_MNISTTRAININGDATA_HPP_
+#define LIB_INCLUDE_MNISTTRAININGDATA_HPP_
+
+#include <cstddef>
+
+#include "include/mnistcsvdataset.hpp"
+#include "include/mnistcsvreader.hpp"
+#include "include/trainingdata.hpp"
+
+// Feeds the uint8 entries of a MNIST data set to a network without
+// converting the data set up front: every sample is normalized to
+// [0, 1] pixels and a one-hot target while it is fetched. The data set
+// (or the entries) must outlive this object.
+class MnistTrainingData final : public TrainingData {
+ public:
+    static constexpr size_t kNumClasses = 10;  // Numbers from 0 to 9
+
+    explicit MnistTrainingData(const MnistCsvDataSet& aDataSet)
+        : m_entries(aDataSet.size() ? &aDataSet[0] : nullptr)
+        , m_size(aDataSet.size()) {}
+
+    MnistTrainingData(const MnistCsvDataSet::Entry_t* aEntries,
+                      size_t aCount)
+        : m_entries(aEntries), m_size(aCount) {}
+
+    size_t size() const override {
+        return m_size;
+    }
+
+    size_t inputSize() const override {
+        return MnistCsvDataSet::kMnistImageSize;
+    }
+
+    size_t targetSize() const override {
+        return kNumClasses;
+    }
+
+    Sample sample(size_t aIndex, double* aInput,
+                  double* aTarget) const override;
+
+    // Writes kMnistImageSize network inputs
+    static void normalize(const MnistCsvDataSet::Image_t& aImage,
+                          double* aOutput);
+    static void normalize(const MnistCsvDataSet::Image_t& aImage,
+                          float* aOutput);
+
+    // Writes kNumClasses values, 1 for aLabel and 0 for the others
+    static void oneHot(MnistCsvDataSet::Label_t aLabel, double* aOutput);
+
+ private:
+    const MnistCsvDataSet::Entry_t* m_entries;
+    size_t m_size;
+};
+
+// The same samples streamed from a MnistCsvReader, one chunk of uint8
+// entries in memory at a time. The reader must outlive this object.
+class MnistTrainingStream final : public TrainingStream {
+ public:
+    explicit MnistTrainingStream(
+        MnistCsvReader& aReader)  // NOLINT(runtime/references)
+        : m_reader(aReader), m_data(nullptr, 0) {}
+
+    size_t inputSize() const override {
+        return MnistCsvDataSet::kMnistImageSize;
+    }
+
+    size_t targetSize() const override {
+        return MnistTrainingData::kNumClasses;
+    }
+
+    const TrainingData& next(size_t aCount) override {
+        const size_t count = m_reader.read(m_entries, aCount);
+        m_data = MnistTrainingData(m_entries.data(), count);
+        return m_data;
+    }
+
+    bool rewind() override {
+        return m_reader.rewind();
+    }
+
+    bool failed() const override {
+        return m_reader.failed();
+    }
+
+ private:
+    MnistCsvReader& m_reader;
+    MnistCsvReader::Entries m_entries;
+    MnistTrainingData m_data;
+};
+
+#endif  // LIB_INCLUDE_MNISTTRAININGDATA_HPP_
@@ -0,0 +1,51 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_MODELFILE_HPP_
+#define LIB_INCLUDE_MODELFILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "include/floatperceptron.hpp"
+#include "include/perceptron.hpp"
+
+// Binary model format, an alternative to the JSON models that can be
+// loaded without parsing or copying a single weight.
+//
+// Layout (host byte order, checked on load):
+//   header        : 64 bytes, see FileHeader in modelfile.cpp
+//   architecture  : uint64_t size of every layer, input layer included
+//   weight blocks : for every layer the row-major weight matrix, then the
+//                   biases, each as raw doubles or floats (see the
+//                   header) starting at a multiple of kAlignment bytes
+// The header holds a checksum of everything from the first weight block
+// to the end of the file. Version 1 files (doubles only) still load.
+namespace modelfile {
+
+constexpr uint32_t kVersion = 2;
+constexpr size_t kAlignment = 64;
+
+// True if aFileName starts with the header of a binary model
+bool isModelFile(const std::string& aFileName);
+
+// The precision of the network is the precision of the file
+bool save(const std::string& aFileName, const Perceptron& aNetwork);
+bool save(const std::string& aFileName, const FloatPerceptron& aNetwork);
+
+// Maps aFileName into memory and points the layers of aNetwork straight
+// at the mapped weights; nothing is parsed or copied. The mapping is
+// private, so changing the weights later never touches the file. The
+// checksum is verified first unless aVerify is false, which leaves the
+// weights to be paged in on first use. A file of the other precision is
+// converted into layers that own their parameters instead.
+bool load(const std::string& aFileName,
+          Perceptron& aNetwork,  // NOLINT(runtime/references)
+          bool aVerify = true);
+bool load(const std::string& aFileName,
+          FloatPerceptron& aNetwork,  // NOLINT(runtime/references)
+          bool aVerify = true);
+
+}  // namespace modelfile
+
+#endif  // LIB_INCLUDE_MODELFILE_HPP_
@@ -3,6 +3,7 @@
 #ifndef LIB_INCLUDE_NEURON_HPP_
 #define LIB_INCLUDE_NEURON_HPP_
 
+#include <cstddef>
 #include <vector>
 
 class Neuron {
@@ -30,12 +31,17 @@ class Neuron {
     double activate(double aValue) const noexcept;
     double activateDerivative(double aValue) const noexcept;
 
+    static double activate(ActivationFunction aFunction,
+        double aValue) noexcept;
+    static double activateDerivative(ActivationFunction aFunction,
+        double aValue) noexcept;
+
  private:
-    double sigmoid(double aValue) const noexcept;
-    double sigmoidDerivative(double aValue) const noexcept;
+    static double sigmoid(double aValue) noexcept;
+    static double sigmoidDerivative(double aValue) noexcept;
 
-    double relu(double aValue) const noexcept;
-    double reluDerivative(double aValue) const noexcept;
+    static double relu(double aValue) noexcept;
+    static double reluDerivative(double aValue) noexcept;
 
     double sum(const std::vector<double>& aInputs) const noexcept;
 
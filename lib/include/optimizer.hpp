@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_OPTIMIZER_HPP_
+#define LIB_INCLUDE_OPTIMIZER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "include/layer.hpp"
+#include "include/trainingoptions.hpp"
+
+// Turns the averaged gradient of a batch into a parameter update. Whatever
+// a method remembers between batches (velocity, moments) is kept by the
+// layer next to the parameters it belongs to, see Layer::OptimizerState.
+class Optimizer {
+ public:
+    // One parameter array of a layer (its weights or its biases)
+    struct Parameters {
+        double* values;
+        // Descent direction (negative gradient) averaged over the batch
+        const double* direction;
+        // stateSlots() arrays of size values, one after another
+        double* state;
+        size_t size;
+    };
+
+ public:
+    virtual ~Optimizer() = default;
+
+    static std::unique_ptr<Optimizer> create(const TrainingOptions& aOptions);
+
+    // Per-parameter values of state the method keeps
+    virtual size_t stateSlots() const noexcept = 0;
+
+    // Starts a new batch for aLayer: sizes its state for this method
+    // (a state left by another method is dropped) and counts the step.
+    void beginStep(Layer& aLayer) const;  // NOLINT(runtime/references)
+
+    // Updates aParams.values[aBegin, aEnd) from their direction and state.
+    // Disjoint ranges of the same array may be updated concurrently.
+    // aStep is the 1-based number of the batch.
+    virtual void update(const Parameters& aParams, size_t aBegin,
+                        size_t aEnd, uint64_t aStep) const noexcept = 0;
+
+ protected:
+    explicit Optimizer(double aLearningRate) noexcept;
+
+    double m_learningRate;
+};
+
+const char* optimizerName(OptimizerType aType) noexcept;
+
+// "sgd", "momentum" or "adam"
+std::optional<OptimizerType> optimizerFromName(const std::string& aName);
+
+#endif  // LIB_INCLUDE_OPTIMIZER_HPP_
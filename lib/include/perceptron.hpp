@@ -3,33 +3,110 @@
 #ifndef LIB_INCLUDE_PERCEPTRON_HPP_
 #define LIB_INCLUDE_PERCEPTRON_HPP_
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <vector>
 
+#include "include/layer.hpp"
 #include "include/neuron.hpp"
+#include "include/trainingdata.hpp"
+#include "include/trainingmetrics.hpp"
+#include "include/trainingoptions.hpp"
 
 class Perceptron {
+ public:
+    // Scratch buffers for infer(). Sized for one network, reusable for
+    // any number of calls; one workspace must not be shared by threads.
+    class Workspace {
+     public:
+        Workspace() = default;
+        explicit Workspace(const Perceptron& aNetwork);
+
+        void reserve(size_t aLayerSize);
+
+     private:
+        friend class Perceptron;
+
+        std::vector<double> m_current;
+        std::vector<double> m_next;
+    };
+
  public:
     Perceptron() = default;
     explicit Perceptron(const std::vector<size_t>& aLayers,
         Neuron::ActivationFunction aFunction =
-            Neuron::ActivationFunction::SIGMOID);
+            Neuron::ActivationFunction::SIGMOID,
+        std::optional<uint32_t> aSeed = std::nullopt);
 
+    // Random initial weights come from aSeed when it is set, from
+    // std::random_device otherwise
     bool initializeNetwork(const std::vector<size_t> &aLayers,
                            Neuron::ActivationFunction aFunction =
-                           Neuron::ActivationFunction::SIGMOID);
+                           Neuron::ActivationFunction::SIGMOID,
+                           std::optional<uint32_t> aSeed = std::nullopt);
+
+    // Takes ready-made layers, e.g. the ones of a loaded model file. Every
+    // layer must take the outputs of the previous one as its inputs.
+    bool initializeNetwork(std::vector<Layer> aLayers);
     bool isConfigured() const;
 
     // NOLINTNEXTLINE(build/include_what_you_use)
     std::vector<std::vector<double>> forward(
         const std::vector<double>& aInput) const;
 
+    // Forward pass for aCount inputs stored row after row in aInputs
+    // (aCount x input layer size). Returns the output layer values for
+    // every input, or an empty vector if aInputs has the wrong size.
+    std::vector<std::vector<double>> forwardBatch(
+        const std::vector<double>& aInputs, size_t aCount) const;
+
+    // Inference only entry point: runs aInput (inputSize() values) through
+    // the network and writes the output layer (outputSize() values) to
+    // aOutput. Does not allocate when aWorkspace was created for this
+    // network.
+    bool infer(const double* aInput, double* aOutput,
+               // NOLINTNEXTLINE(runtime/references)
+               Workspace& aWorkspace) const;
+
+    // Same with a per-thread workspace, which only allocates the first
+    // time a thread meets a network wider than the ones before. aOutput is
+    // resized to outputSize() (no allocation when it already is).
+    bool infer(const std::vector<double>& aInput,
+               // NOLINTNEXTLINE(runtime/references)
+               std::vector<double>& aOutput) const;
+
+    size_t inputSize() const;
+    size_t outputSize() const;
+
     void train(const std::vector<std::vector<double>>& aInputData,
                 const std::vector<std::vector<double>>& aTargetData,
                 int aEpochs, double aLearningRate);
 
+    void train(const std::vector<std::vector<double>>& aInputData,
+               const std::vector<std::vector<double>>& aTargetData,
+               const TrainingOptions& aOptions);
+
+    // Trains on samples fetched one by one from aData (e.g. a
+    // MnistTrainingData normalizing compact images on the fly), so the
+    // inputs never have to be materialized as doubles. Training stopped
+    // through aOptions.stopToken leaves isTrained() false.
+    void train(const TrainingData& aData, const TrainingOptions& aOptions);
+
+    // Trains on aStream read in one forward pass per epoch, with only a
+    // few batches of it in memory at a time. aStream is rewound between
+    // epochs; training stops with an error if it cannot be, or if reading
+    // it fails. The updates are the same as for the whole data in memory.
+    void train(TrainingStream& aStream,  // NOLINT(runtime/references)
+               const TrainingOptions& aOptions);
+
     bool isTrained() const;
 
-    const std::vector<std::vector<Neuron>>& layers() const;
+    // Metrics of the last train() call, stopped ones included. Empty
+    // unless the library is built with RECOGNITION_METRICS.
+    const TrainingMetrics& trainingMetrics() const;
+
+    const std::vector<Layer>& layers() const;
 
     bool setNeuronWeights(size_t aLayerIndex, size_t aNeuronIndex,
         const std::vector<double>& aWeights);
@@ -38,9 +115,11 @@ class Perceptron {
         double aBias);
 
  private:
-    std::vector<std::vector<Neuron>> m_layers;
+    std::vector<Layer> m_layers;
+    size_t m_maxLayerSize = 0;
     bool m_isConfigured = false;
     bool m_isTrained = false;
+    TrainingMetrics m_metrics;
 };
 
 #endif  // LIB_INCLUDE_PERCEPTRON_HPP_
@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_QUANTIZEDPERCEPTRON_HPP_
+#define LIB_INCLUDE_QUANTIZEDPERCEPTRON_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "include/neuron.hpp"
+#include "include/perceptron.hpp"
+#include "include/trainingdata.hpp"
+
+// INT8 post-training quantized inference engine.
+//
+// Weights are int8 with one symmetric scale per neuron, the inputs of
+// every layer uint8 with one scale per layer, and every neuron sums its
+// products exactly in int32 (kernels::dot, VNNI where available). Only
+// the bias and the activation are computed in float. Network inputs are
+// bytes standing for byte * kInputScale, i.e. MNIST pixels as stored by
+// MnistCsvDataSet are fed without any conversion.
+//
+// Sigmoid and ReLU outputs are never negative, so no zero points are
+// needed: the scale of a hidden layer output maps the largest value seen
+// while calibrating to 255.
+class QuantizedPerceptron {
+ public:
+    static constexpr float kInputScale = 1.0f / 255.0f;
+
+    // Scratch buffers for infer(), see Perceptron::Workspace
+    class Workspace {
+     public:
+        Workspace() = default;
+        explicit Workspace(const QuantizedPerceptron& aNetwork);
+
+        void reserve(size_t aLayerSize);
+
+     private:
+        friend class QuantizedPerceptron;
+
+        std::vector<uint8_t> m_current;
+        std::vector<uint8_t> m_next;
+        std::vector<int32_t> m_sums;
+        std::vector<float> m_values;
+    };
+
+    QuantizedPerceptron() = default;
+
+    // Quantizes the trained aNetwork. The output ranges of the hidden
+    // layers come from running the first aSamples samples of aCalibration
+    // (inputs in [0, 1], at most aCalibration.size()) through aNetwork.
+    bool quantize(const Perceptron& aNetwork,
+                  const TrainingData& aCalibration, size_t aSamples);
+    bool isConfigured() const;
+
+    // Same contracts as the Perceptron functions of the same names, with
+    // byte inputs and float outputs
+    std::vector<std::vector<float>> forwardBatch(
+        const std::vector<uint8_t>& aInputs, size_t aCount) const;
+    bool infer(const uint8_t* aInput, float* aOutput,
+               // NOLINTNEXTLINE(runtime/references)
+               Workspace& aWorkspace) const;
+    bool infer(const std::vector<uint8_t>& aInput,
+               // NOLINTNEXTLINE(runtime/references)
+               std::vector<float>& aOutput) const;
+
+    size_t inputSize() const;
+    size_t outputSize() const;
+
+ private:
+    struct Layer {
+        size_t inputs = 0;
+        size_t size = 0;
+        Neuron::ActivationFunction function =
+            Neuron::ActivationFunction::SIGMOID;
+        std::vector<int8_t> weights;  // Row-major, one row per neuron
+        // Input scale times weight scale: int32 sum to real value
+        std::vector<float> scales;
+        std::vector<float> biases;
+        // Real value of an output byte, unused by the output layer
+        float outputScale = 0.0f;
+    };
+
+    // Runs aLayer on aInput and leaves the activated values in aValues,
+    // aSums is scratch space for the integer sums
+    static void forward(const Layer& aLayer, const uint8_t* aInput,
+                        int32_t* aSums, float* aValues);
+
+    std::vector<Layer> m_layers;
+    size_t m_maxLayerSize = 0;
+};
+
+#endif  // LIB_INCLUDE_QUANTIZEDPERCEPTRON_HPP_
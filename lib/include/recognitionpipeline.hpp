@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_RECOGNITIONPIPELINE_HPP_
+#define LIB_INCLUDE_RECOGNITIONPIPELINE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "include/mnistcsvdataset.hpp"
+#include "include/mnistcsvreader.hpp"
+
+// Streaming recognition of a MNIST CSV stream in three stages connected by
+// bounded queues:
+//   reader  : parses the stream batch by batch (MnistCsvReader)
+//   workers : classify batches in parallel
+//   writer  : hands the batches to the sink in stream order
+// At most a few batches per worker are in flight at any time, so memory
+// stays flat however long the stream is.
+class RecognitionPipeline final {
+ public:
+    using Entries = MnistCsvReader::Entries;
+    using Predictions = std::vector<MnistCsvDataSet::Label_t>;
+
+    // Predicts the digit of every entry. Called by all workers at once.
+    using Classifier =
+        std::function<void(const Entries& aEntries,
+                           Predictions& aPredictions)>;
+    // Consumes one classified batch, always on the thread calling run()
+    using Sink =
+        std::function<void(const Entries& aEntries,
+                           const Predictions& aPredictions)>;
+
+    // aThreads inference workers (0 takes one per hardware thread) on
+    // batches of aBatchSize entries
+    RecognitionPipeline(size_t aThreads, size_t aBatchSize);
+
+    // Recognizes every entry aReader has left. Stops at the first line
+    // that does not parse; the entries before it have reached aSink by
+    // then. Exceptions of aClassifier and aSink are rethrown once all
+    // stages have stopped.
+    bool run(MnistCsvReader& aReader,  // NOLINT(runtime/references)
+             const Classifier& aClassifier, const Sink& aSink);
+
+    size_t threads() const noexcept;
+    size_t batchSize() const noexcept;
+
+    // Entries that reached the sink during the last run()
+    size_t processed() const noexcept;
+
+    // Why the last run() failed, e.g. "Line 12: Pixel out of range: 300"
+    const std::string& lastError() const noexcept;
+
+ private:
+    size_t m_threads;
+    size_t m_batchSize;
+    size_t m_processed = 0;
+    std::string m_lastError;
+};
+
+#endif  // LIB_INCLUDE_RECOGNITIONPIPELINE_HPP_
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_RECOGNITIONSERVER_HPP_
+#define LIB_INCLUDE_RECOGNITIONSERVER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "include/microbatcher.hpp"
+
+// Long-running recognition service on a Unix domain socket or a localhost
+// TCP port. Every connection gets a thread of its own and may send any
+// number of requests; the images of all connections are scored together
+// by one MicroBatcher, and every connection gets its replies in request
+// order.
+//
+// Requests of a RAW server are kMnistImageSize pixel bytes each, answered
+// by the class scores as float values in native byte order. Requests of
+// a CSV server are lines of either kMnistImageSize pixels or a label and
+// the pixels (a line of a MNIST CSV file, the label is ignored),
+// answered by a line "digit,score0,...,score9", or by "error: <why>" when
+// the line does not parse.
+class RecognitionServer final {
+ public:
+    enum class Format {
+        RAW,
+        CSV
+    };
+
+    // aBatcher must outlive the server
+    RecognitionServer(MicroBatcher& aBatcher,  // NOLINT(runtime/references)
+                      Format aFormat);
+    // Closes the listening socket and removes its socket file
+    ~RecognitionServer();
+
+    RecognitionServer(const RecognitionServer&) = delete;
+    RecognitionServer& operator=(const RecognitionServer&) = delete;
+
+    RecognitionServer(RecognitionServer&&) = delete;
+    RecognitionServer& operator=(RecognitionServer&&) = delete;
+
+    // Listens on the Unix domain socket aPath. A stale socket file left
+    // there is replaced, any other file is not.
+    bool listenUnix(const std::string& aPath);
+
+    // Listens on 127.0.0.1:aPort, port 0 picks a free one (see port())
+    bool listenTcp(uint16_t aPort);
+
+    // TCP port listened on, 0 for a Unix domain socket
+    uint16_t port() const noexcept;
+
+    // Accepts and serves connections until stop(). Open connections are
+    // closed before it returns. False when the server is not listening.
+    bool serve();
+
+    // Makes serve() return. Async-signal-safe, so it may be called from a
+    // signal handler, and from any thread.
+    void stop() noexcept;
+
+    // Connections accepted so far
+    size_t connections() const noexcept;
+
+    // Why listening or serving failed
+    const std::string& lastError() const noexcept;
+
+ private:
+    struct Connection {
+        int socket = -1;
+        std::thread thread;
+        std::atomic<bool> isDone{false};
+    };
+
+    void handleConnection(Connection& aConnection);  // NOLINT
+
+    // Joins the threads of connections that have ended
+    void reapConnections();
+
+    bool fail(const std::string& aError);
+
+    MicroBatcher& m_batcher;
+    const Format m_format;
+
+    int m_listenSocket = -1;
+    int m_stopPipe[2] = {-1, -1};  // stop() writes, serve() polls
+    std::string m_unixPath;
+    uint16_t m_port = 0;
+
+    std::mutex m_mutex;
+    std::list<std::unique_ptr<Connection>> m_connections;
+    std::atomic<size_t> m_accepted{0};
+    std::string m_lastError;
+};
+
+#endif  // LIB_INCLUDE_RECOGNITIONSERVER_HPP_
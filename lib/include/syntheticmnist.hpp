@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_SYNTHETICMNIST_HPP_
+#define LIB_INCLUDE_SYNTHETICMNIST_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "include/mnistcsvdataset.hpp"
+
+// Synthetic data sets in the MNIST CSV format, for tests and benchmarks
+// that need more data than the real MNIST files, or broken data. A seed
+// always gives the same rows, on every platform, and every row depends
+// only on the seed and its index, so any row can be regenerated alone.
+namespace syntheticmnist {
+
+// The ways a malformed row breaks MnistCsvDataSet::parseLine
+enum class Defect {
+    NONE,
+    EMPTY_LINE,          // Missing label
+    INVALID_LABEL,       // Label 10
+    INVALID_NUMBER,      // A pixel that is not a number
+    PIXEL_OUT_OF_RANGE,  // A pixel of 256
+    MISSING_PIXEL,       // One pixel less than kMnistImageSize
+    EXTRA_PIXEL          // One pixel more
+};
+
+struct Options {
+    size_t rows = 60000;
+    uint32_t seed = 1;
+    // Share of the rows written malformed, each with one of the defects.
+    // The other rows stay the same whatever the share is.
+    double malformedRate = 0.0;
+};
+
+// Row aIndex of the data set of aSeed: a stroke in random shades of ink,
+// its direction given by the label, plus a little noise. Mostly
+// background like real digits, so the CSV files are about as large.
+void entry(uint32_t aSeed, size_t aIndex,
+           MnistCsvDataSet::Entry_t& aEntry);  // NOLINT(runtime/references)
+
+// How row aIndex is written, NONE for a well-formed row
+Defect defect(const Options& aOptions, size_t aIndex);
+
+// Writes the header and aOptions.rows rows. The first row is line 2.
+bool writeCsv(std::ostream& aOutput,  // NOLINT(runtime/references)
+              const Options& aOptions);
+bool writeCsv(const std::string& aPath, const Options& aOptions);
+
+// Writes the binary cache MnistCsvDataSet maps instead of parsing the
+// file aCsvPath, which writeCsv() wrote with the same aOptions. Data sets
+// with malformed rows cannot be cached.
+bool writeCache(const std::string& aCsvPath, const Options& aOptions);
+
+}  // namespace syntheticmnist
+
+#endif  // LIB_INCLUDE_SYNTHETICMNIST_HPP_
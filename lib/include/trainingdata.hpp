@@ -0,0 +1,82 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_TRAININGDATA_HPP_
+#define LIB_INCLUDE_TRAININGDATA_HPP_
+
+#include <cstddef>
+#include <vector>
+
+// Samples a network is trained on. A sample is handed out as pointers to
+// inputSize() input and targetSize() target values: either storage of the
+// implementation or the buffers passed to sample(), which it may fill on
+// the fly (e.g. from a compact source format), so the whole data set
+// never has to exist as doubles.
+class TrainingData {
+ public:
+    struct Sample {
+        const double* input;
+        const double* target;
+    };
+
+    virtual ~TrainingData() = default;
+
+    virtual size_t size() const = 0;
+    virtual size_t inputSize() const = 0;
+    virtual size_t targetSize() const = 0;
+
+    // Called concurrently by the training threads, each with its own
+    // buffers of inputSize() and targetSize() values
+    virtual Sample sample(size_t aIndex, double* aInput,
+                          double* aTarget) const = 0;
+};
+
+// Samples already stored as rows of doubles, used in place
+class VectorTrainingData final : public TrainingData {
+ public:
+    VectorTrainingData(const std::vector<std::vector<double>>& aInputs,
+                       const std::vector<std::vector<double>>& aTargets)
+        : m_inputs(aInputs), m_targets(aTargets) {}
+
+    size_t size() const override {
+        return m_inputs.size();
+    }
+
+    size_t inputSize() const override {
+        return m_inputs.empty() ? 0 : m_inputs.front().size();
+    }
+
+    size_t targetSize() const override {
+        return m_targets.empty() ? 0 : m_targets.front().size();
+    }
+
+    Sample sample(size_t aIndex, double*, double*) const override {
+        return {m_inputs[aIndex].data(), m_targets[aIndex].data()};
+    }
+
+ private:
+    const std::vector<std::vector<double>>& m_inputs;
+    const std::vector<std::vector<double>>& m_targets;
+};
+
+// Samples read chunk by chunk in forward-only passes over a source that
+// is too large to keep in memory (e.g. a CSV file or the standard input)
+class TrainingStream {
+ public:
+    virtual ~TrainingStream() = default;
+
+    virtual size_t inputSize() const = 0;
+    virtual size_t targetSize() const = 0;
+
+    // The next at most aCount samples of the current pass, valid until the
+    // next call. Empty data ends the pass.
+    virtual const TrainingData& next(size_t aCount) = 0;
+
+    // Starts a new pass from the first sample. False if the source cannot
+    // be read again, e.g. a pipe.
+    virtual bool rewind() = 0;
+
+    // True once reading failed, which ends the pass early
+    virtual bool failed() const = 0;
+};
+
+#endif  // LIB_INCLUDE_TRAININGDATA_HPP_
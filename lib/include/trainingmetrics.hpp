@@ -0,0 +1,54 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_TRAININGMETRICS_HPP_
+#define LIB_INCLUDE_TRAININGMETRICS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Where the time of a Perceptron::train() call went. Collected only by a
+// library built with the RECOGNITION_METRICS CMake option; otherwise the
+// instrumentation is compiled out and the metrics stay empty.
+struct TrainingMetrics {
+#ifdef RECOGNITION_METRICS
+    static constexpr bool kEnabled = true;
+#else
+    static constexpr bool kEnabled = false;
+#endif
+
+    // Floating point operations of one layer, counting a multiply-add
+    // as two. Activation functions are not counted.
+    struct Layer {
+        size_t inputs = 0;
+        size_t neurons = 0;
+        uint64_t forwardFlops = 0;
+        uint64_t backwardFlops = 0;  // Deltas and gradients
+        uint64_t updateFlops = 0;    // One multiply-add per parameter
+    };
+
+    int epochs = 0;
+    uint64_t samples = 0;
+    uint64_t batches = 0;
+
+    // Wall time of the whole call
+    double seconds = 0.0;
+    double samplesPerSecond = 0.0;
+
+    // Time of every phase. Samples are fetched (loaded and normalized),
+    // run forward and back propagated on all worker threads at once, so
+    // these three are summed over the threads. The weight update is wall
+    // time.
+    double dataSeconds = 0.0;
+    double forwardSeconds = 0.0;
+    double backwardSeconds = 0.0;
+    double updateSeconds = 0.0;
+
+    std::vector<Layer> layers;
+
+    // Heap allocations of the whole process while training
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+};
+
+#endif  // LIB_INCLUDE_TRAININGMETRICS_HPP_
@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_TRAININGOPTIONS_HPP_
+#define LIB_INCLUDE_TRAININGOPTIONS_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+// Update rule applied to the averaged gradient of every batch
+enum class OptimizerType {
+    SGD,       // Plain gradient descent
+    MOMENTUM,  // Gradient descent with a running velocity
+    ADAM       // Adaptive per-parameter steps (Kingma & Ba)
+};
+
+// Where training is, as reported to TrainingOptions::onProgress
+struct TrainingProgress {
+    int epoch = 0;   // Epoch being trained, from 1
+    int epochs = 0;  // Epochs to train
+
+    size_t samples = 0;       // Samples trained so far in this epoch
+    size_t epochSamples = 0;  // Samples per epoch, 0 while not yet known
+
+    double loss = 0.0;  // Mean squared error of the samples so far
+    double samplesPerSecond = 0.0;  // Since the epoch started
+
+    bool isEpochDone = false;  // The last report of the epoch
+};
+
+struct TrainingOptions {
+    int epochs = 1;
+    double learningRate = 0.01;
+
+    // Samples per weight update. 1 keeps the classic per-sample SGD,
+    // larger batches average the gradient of the whole batch.
+    size_t batchSize = 1;
+
+    // Worker threads sharing every batch. Each thread accumulates the
+    // gradients of its part of the batch, the parts are reduced in a
+    // fixed order, so a given thread count always gives the same result.
+    // A batchSize of 1 has nothing to share and always runs on one thread.
+    size_t threads = 1;
+
+    OptimizerType optimizer = OptimizerType::SGD;
+    double momentum = 0.9;    // Velocity decay of MOMENTUM
+    double beta1 = 0.9;       // First moment decay of ADAM
+    double beta2 = 0.999;     // Second moment decay of ADAM
+    double epsilon = 1e-8;    // Keeps ADAM steps finite
+
+    // Called on the training thread after every batch and once more at
+    // the end of every epoch. Keep it short, it holds training up.
+    std::function<void(const TrainingProgress&)> onProgress;
+
+    // Training stops after the batch in progress once it is set, e.g.
+    // from another thread, and the network is left as that batch left it
+    const std::atomic<bool>* stopToken = nullptr;
+};
+
+#endif  // LIB_INCLUDE_TRAININGOPTIONS_HPP_
@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_INCLUDE_WORKERPOOL_HPP_
+#define LIB_INCLUDE_WORKERPOOL_HPP_
+
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+// Fork-join pool of persistent threads. run() executes one task on every
+// thread of the pool (the calling thread is worker 0) and returns once all
+// of them have finished, so the pool can be driven in lockstep, e.g. once
+// per training batch, without creating threads each time.
+class WorkerPool final {
+ public:
+    using Task = std::function<void(size_t aWorkerIndex)>;
+
+    // aThreads is the total number of workers, including the caller
+    explicit WorkerPool(size_t aThreads);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    size_t size() const noexcept;
+
+    // Calls aTask(i) for every worker i in [0, size()) and waits for all
+    // of them. The first exception thrown by a task is rethrown here.
+    void run(const Task& aTask);
+
+    // [begin, end) of the aWorkerIndex-th of size() nearly equal,
+    // contiguous parts of aCount items
+    std::pair<size_t, size_t> chunk(size_t aCount,
+                                    size_t aWorkerIndex) const noexcept;
+
+ private:
+    void workerLoop(size_t aWorkerIndex);
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_startCondition;
+    std::condition_variable m_doneCondition;
+    const Task* m_task = nullptr;
+    uint64_t m_generation = 0;
+    size_t m_pending = 0;
+    bool m_stop = false;
+    std::exception_ptr m_error;
+};
+
+#endif  // LIB_INCLUDE_WORKERPOOL_HPP_
@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+// Built with RECOGNITION_METRICS only. Replaces the global allocation
+// functions of the whole process to count the heap allocations reported
+// in TrainingMetrics. A program that replaces them itself keeps its own,
+// and the count stays 0.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "src/metrics.hpp"
+
+
+namespace {
+std::atomic<uint64_t> gAllocations{0};
+std::atomic<uint64_t> gAllocatedBytes{0};
+}  // namespace
+
+
+void* operator new(std::size_t aSize) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    gAllocatedBytes.fetch_add(aSize, std::memory_order_relaxed);
+    if (void* memory = std::malloc(aSize == 0 ? 1 : aSize)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* aMemory) noexcept {
+    std::free(aMemory);
+}
+
+void operator delete(void* aMemory, std::size_t) noexcept {
+    std::free(aMemory);
+}
+
+namespace metrics {
+
+Allocations allocations() noexcept {
+    return {gAllocations.load(std::memory_order_relaxed),
+            gAllocatedBytes.load(std::memory_order_relaxed)};
+}
+
+}  // namespace metrics
@@ -0,0 +1,136 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/floatperceptron.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "include/logger.hpp"
+#include "src/inference.hpp"
+
+
+FloatPerceptron::Workspace::Workspace(const FloatPerceptron& aNetwork) {
+    reserve(aNetwork.m_maxLayerSize);
+}
+
+void FloatPerceptron::Workspace::reserve(size_t aLayerSize) {
+    if (m_current.size() < aLayerSize) {
+        m_current.resize(aLayerSize);
+        m_next.resize(aLayerSize);
+    }
+}
+
+FloatPerceptron::FloatPerceptron(const Perceptron& aNetwork) {
+    if (!aNetwork.isConfigured()) {
+        return;
+    }
+
+    std::vector<FloatLayer> layers;
+    layers.reserve(aNetwork.layers().size());
+    for (const auto& layer : aNetwork.layers()) {
+        layers.emplace_back(layer);
+    }
+
+    initializeNetwork(std::move(layers));
+}
+
+bool FloatPerceptron::initializeNetwork(std::vector<FloatLayer> aLayers) {
+    m_isConfigured = false;
+    m_layers.clear();
+    m_maxLayerSize = 0;
+
+    if (aLayers.empty()) {
+        LOG_ERROR << "Network must have at least input and output layers";
+        return false;
+    }
+
+    for (size_t i = 1; i < aLayers.size(); ++i) {
+        if (aLayers[i].inputs() != aLayers[i - 1].size()) {
+            LOG_ERROR << "Inputs of layer " << i + 1
+                << " do not match the size of layer " << i;
+            return false;
+        }
+    }
+
+    m_layers = std::move(aLayers);
+    for (const auto& layer : m_layers) {
+        m_maxLayerSize = std::max(m_maxLayerSize, layer.size());
+    }
+
+    m_isConfigured = true;
+    return true;
+}
+
+bool FloatPerceptron::isConfigured() const {
+    return m_isConfigured;
+}
+
+std::vector<std::vector<float>> FloatPerceptron::forwardBatch(
+        const std::vector<float>& aInputs, size_t aCount) const {
+    if (m_layers.empty() || aCount == 0) {
+        return {};
+    }
+
+    if (aInputs.size() != aCount * m_layers.front().inputs()) {
+        LOG_ERROR << "Batch size does not match the input layer size";
+        return {};
+    }
+
+    return inference::forwardBatch(m_layers, m_maxLayerSize,
+                                   aInputs.data(), aCount);
+}
+
+bool FloatPerceptron::infer(const float* aInput, float* aOutput,
+                            Workspace& aWorkspace) const {
+    if (m_layers.empty()) {
+        LOG_ERROR << "Network is not configured";
+        return false;
+    }
+
+    aWorkspace.reserve(m_maxLayerSize);
+    inference::infer(m_layers, aInput, aOutput, aWorkspace.m_current,
+                     aWorkspace.m_next);
+    return true;
+}
+
+bool FloatPerceptron::infer(const std::vector<float>& aInput,
+                            std::vector<float>& aOutput) const {
+    thread_local Workspace workspace;
+
+    if (aInput.size() != inputSize()) {
+        LOG_ERROR << "Input size does not match the input layer size";
+        return false;
+    }
+
+    aOutput.resize(outputSize());
+    return infer(aInput.data(), aOutput.data(), workspace);
+}
+
+size_t FloatPerceptron::inputSize() const {
+    return m_layers.empty() ? 0 : m_layers.front().inputs();
+}
+
+size_t FloatPerceptron::outputSize() const {
+    return m_layers.empty() ? 0 : m_layers.back().size();
+}
+
+const std::vector<FloatLayer>& FloatPerceptron::layers() const {
+    return m_layers;
+}
+
+Perceptron FloatPerceptron::toPerceptron() const {
+    Perceptron network;
+    if (!m_isConfigured) {
+        return network;
+    }
+
+    std::vector<Layer> layers;
+    layers.reserve(m_layers.size());
+    for (const auto& layer : m_layers) {
+        layers.emplace_back(layer);
+    }
+
+    network.initializeNetwork(std::move(layers));
+    return network;
+}
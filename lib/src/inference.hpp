@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_SRC_INFERENCE_HPP_
+#define LIB_SRC_INFERENCE_HPP_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "include/layer.hpp"
+
+// Forward passes shared by the inference engines of every precision
+namespace inference {
+
+// Runs aInput through aLayers, ping-ponging between aCurrent and aNext
+// (at least the largest layer size each). The output layer is written
+// straight to aOutput.
+template <typename T>
+void infer(const std::vector<BasicLayer<T>>& aLayers, const T* aInput,
+           T* aOutput,
+           std::vector<T>& aCurrent,  // NOLINT(runtime/references)
+           std::vector<T>& aNext) {  // NOLINT(runtime/references)
+    const T* input = aInput;
+    const size_t last = aLayers.size() - 1;
+    for (size_t i = 0; i < last; ++i) {
+        aLayers[i].forward(input, aNext.data());
+        std::swap(aCurrent, aNext);
+        input = aCurrent.data();
+    }
+
+    aLayers[last].forward(input, aOutput);
+}
+
+// aCount inputs stored row after row, one layer of the whole batch at a
+// time. Returns the output layer values of every input.
+template <typename T>
+std::vector<std::vector<T>> forwardBatch(
+        const std::vector<BasicLayer<T>>& aLayers, size_t aMaxLayerSize,
+        const T* aInputs, size_t aCount) {
+    std::vector<T> current(aCount * aMaxLayerSize);
+    std::vector<T> next(aCount * aMaxLayerSize);
+
+    const T* input = aInputs;
+    for (const auto& layer : aLayers) {
+        layer.forwardBatch(input, aCount, next.data());
+        std::swap(current, next);
+        input = current.data();
+    }
+
+    const size_t outputSize = aLayers.back().size();
+    std::vector<std::vector<T>> outputs(aCount);
+    for (size_t i = 0; i < aCount; ++i) {
+        outputs[i].assign(input + i * outputSize,
+                          input + (i + 1) * outputSize);
+    }
+
+    return outputs;
+}
+
+}  // namespace inference
+
+#endif  // LIB_SRC_INFERENCE_HPP_
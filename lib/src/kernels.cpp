@@ -0,0 +1,346 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "include/neuron.hpp"
+#include "src/kerneltable.hpp"
+
+namespace kernels {
+namespace {
+
+template <typename T>
+T dotScalar(const T* aLhs, const T* aRhs, size_t aSize) noexcept {
+    T result = 0;
+    for (size_t i = 0; i < aSize; ++i) {
+        result += aLhs[i] * aRhs[i];
+    }
+    return result;
+}
+
+int32_t dotU8Scalar(const uint8_t* aLhs, const int8_t* aRhs,
+                    size_t aSize) noexcept {
+    int32_t result = 0;
+    for (size_t i = 0; i < aSize; ++i) {
+        result += static_cast<int32_t>(aLhs[i]) * aRhs[i];
+    }
+    return result;
+}
+
+void dot4U8Scalar(const uint8_t* aInput, const int8_t* aRows,
+                  size_t aStride, size_t aSize, int32_t* aResult) noexcept {
+    for (size_t k = 0; k < 4; ++k) {
+        aResult[k] = dotU8Scalar(aInput, aRows + k * aStride, aSize);
+    }
+}
+
+template <typename T>
+void dot4Scalar(const T* aRow, const T* aInputs, size_t aStride,
+                size_t aSize, T* aResult) noexcept {
+    for (size_t k = 0; k < 4; ++k) {
+        aResult[k] = dotScalar(aRow, aInputs + k * aStride, aSize);
+    }
+}
+
+template <typename T>
+void sigmoidScalar(T* aValues, size_t aSize) noexcept {
+    for (size_t i = 0; i < aSize; ++i) {
+        aValues[i] = static_cast<T>(Neuron::activate(
+            Neuron::ActivationFunction::SIGMOID, aValues[i]));
+    }
+}
+
+template <typename T>
+void reluScalar(T* aValues, size_t aSize) noexcept {
+    for (size_t i = 0; i < aSize; ++i) {
+        aValues[i] = static_cast<T>(Neuron::activate(
+            Neuron::ActivationFunction::RELU, aValues[i]));
+    }
+}
+
+template <typename T>
+void axpy4Scalar(const T* aScales, const T* aRows, size_t aStride,
+                 size_t aSize, T* aResult) noexcept {
+    for (size_t i = 0; i < aSize; ++i) {
+        T result = aResult[i];
+        for (size_t k = 0; k < 4; ++k) {
+            result += aScales[k] * aRows[k * aStride + i];
+        }
+        aResult[i] = result;
+    }
+}
+
+template <typename T>
+void gemmBlocked(T (*aDot)(const T*, const T*, size_t) noexcept,
+                 void (*aDot4)(const T*, const T*, size_t, size_t,
+                               T*) noexcept,
+                 const T* aInputs, size_t aCount,
+                 const T* aWeights, size_t aRows, size_t aDepth,
+                 T* aOutput) noexcept {
+    // Keep a panel of weight rows in L2 while blocks of kSampleBlock inputs
+    // (small enough for L1) are streamed against it, so every weight is
+    // read from memory once per panel instead of once per sample
+    constexpr size_t kSampleBlock = 4;
+    constexpr size_t kPanelBytes = 256 * 1024;
+
+    const size_t rowBytes = std::max<size_t>(aDepth * sizeof(T), 1);
+    const size_t panelRows = std::max<size_t>(kPanelBytes / rowBytes, 1);
+
+    T result[kSampleBlock];
+    for (size_t panel = 0; panel < aRows; panel += panelRows) {
+        const size_t panelEnd = std::min(panel + panelRows, aRows);
+
+        size_t sample = 0;
+        for (; sample + kSampleBlock <= aCount; sample += kSampleBlock) {
+            const T* inputs = aInputs + sample * aDepth;
+            T* output = aOutput + sample * aRows;
+
+            for (size_t row = panel; row < panelEnd; ++row) {
+                aDot4(aWeights + row * aDepth, inputs, aDepth, aDepth,
+                      result);
+                for (size_t k = 0; k < kSampleBlock; ++k) {
+                    output[k * aRows + row] = result[k];
+                }
+            }
+        }
+
+        for (; sample < aCount; ++sample) {
+            const T* input = aInputs + sample * aDepth;
+            T* output = aOutput + sample * aRows;
+
+            for (size_t row = panel; row < panelEnd; ++row) {
+                output[row] = aDot(aWeights + row * aDepth, input, aDepth);
+            }
+        }
+    }
+}
+
+// The rows are streamed in order, each scaled by its element of aVector
+// and added to aOutput, so the matrix is never walked column by column
+template <typename T>
+void gemvTransposedWith(void (*aAxpy4)(const T*, const T*, size_t, size_t,
+                                       T*) noexcept,
+                        const T* aVector, const T* aWeights, size_t aRows,
+                        size_t aDepth, T* aOutput) noexcept {
+    std::fill(aOutput, aOutput + aDepth, T(0));
+
+    size_t j = 0;
+    for (; j + 4 <= aRows; j += 4) {
+        aAxpy4(aVector + j, aWeights + j * aDepth, aDepth, aDepth, aOutput);
+    }
+    for (; j < aRows; ++j) {
+        const T scale = aVector[j];
+        const T* row = aWeights + j * aDepth;
+        for (size_t i = 0; i < aDepth; ++i) {
+            aOutput[i] += scale * row[i];
+        }
+    }
+}
+
+template <typename T>
+void activateWith(Neuron::ActivationFunction aFunction,
+                  T* aValues, size_t aSize) noexcept {
+    switch (aFunction) {
+        case Neuron::ActivationFunction::SIGMOID:
+            sigmoid(aValues, aSize);
+            break;
+        case Neuron::ActivationFunction::RELU:
+        default:
+            relu(aValues, aSize);
+            break;
+    }
+}
+
+const KernelTable* tableFor(Isa aIsa) noexcept {
+    switch (aIsa) {
+#if defined(RECOGNITION_X86_KERNELS)
+        case Isa::SSE2:
+            return &kSse2Kernels;
+        case Isa::AVX2:
+            return &kAvx2Kernels;
+        case Isa::AVX512:
+            return &kAvx512Kernels;
+        case Isa::AVX512_VNNI:
+            return &kAvx512VnniKernels;
+#endif
+        case Isa::SCALAR:
+        default:
+            return &kScalarKernels;
+    }
+}
+
+std::atomic<const KernelTable*>& activeTable() noexcept {
+    static std::atomic<const KernelTable*> table{tableFor(detectIsa())};
+    return table;
+}
+
+const KernelTable& active() noexcept {
+    return *activeTable().load(std::memory_order_relaxed);
+}
+
+}  // namespace
+
+const KernelTable kScalarKernels = {
+    dotScalar<double>, dot4Scalar<double>,
+    sigmoidScalar<double>, reluScalar<double>,
+    axpy4Scalar<double>,
+    dotScalar<float>, dot4Scalar<float>,
+    sigmoidScalar<float>, reluScalar<float>,
+    axpy4Scalar<float>,
+    dotU8Scalar, dot4U8Scalar};
+
+bool isSupported(Isa aIsa) noexcept {
+    if (aIsa == Isa::SCALAR) {
+        return true;
+    }
+
+#if defined(RECOGNITION_X86_KERNELS)
+    __builtin_cpu_init();
+    switch (aIsa) {
+        case Isa::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case Isa::AVX2:
+            return __builtin_cpu_supports("avx2") &&
+                   __builtin_cpu_supports("fma");
+        case Isa::AVX512:
+            return __builtin_cpu_supports("avx512f") &&
+                   __builtin_cpu_supports("fma");
+        case Isa::AVX512_VNNI:
+            return isSupported(Isa::AVX512) &&
+                   __builtin_cpu_supports("avx512bw") &&
+                   __builtin_cpu_supports("avx512vnni");
+        default:
+            return false;
+    }
+#else
+    return false;
+#endif
+}
+
+Isa detectIsa() noexcept {
+    for (Isa isa : {Isa::AVX512_VNNI, Isa::AVX512, Isa::AVX2, Isa::SSE2}) {
+        if (isSupported(isa)) {
+            return isa;
+        }
+    }
+    return Isa::SCALAR;
+}
+
+Isa activeIsa() noexcept {
+    const KernelTable* table = &active();
+    for (Isa isa : {Isa::SCALAR, Isa::SSE2, Isa::AVX2, Isa::AVX512,
+                    Isa::AVX512_VNNI}) {
+        if (tableFor(isa) == table) {
+            return isa;
+        }
+    }
+    return Isa::SCALAR;
+}
+
+bool setIsa(Isa aIsa) noexcept {
+    if (!isSupported(aIsa)) {
+        return false;
+    }
+
+    activeTable().store(tableFor(aIsa), std::memory_order_relaxed);
+    return true;
+}
+
+const char* isaName(Isa aIsa) noexcept {
+    switch (aIsa) {
+        case Isa::SSE2:
+            return "SSE2";
+        case Isa::AVX2:
+            return "AVX2";
+        case Isa::AVX512:
+            return "AVX-512";
+        case Isa::AVX512_VNNI:
+            return "AVX-512 VNNI";
+        case Isa::SCALAR:
+        default:
+            return "scalar";
+    }
+}
+
+double dot(const double* aLhs, const double* aRhs, size_t aSize) noexcept {
+    return active().dot(aLhs, aRhs, aSize);
+}
+
+float dot(const float* aLhs, const float* aRhs, size_t aSize) noexcept {
+    return active().dotF(aLhs, aRhs, aSize);
+}
+
+int32_t dot(const uint8_t* aLhs, const int8_t* aRhs, size_t aSize) noexcept {
+    return active().dotU8(aLhs, aRhs, aSize);
+}
+
+void gemv(const uint8_t* aInput, const int8_t* aWeights, size_t aRows,
+          size_t aDepth, int32_t* aOutput) noexcept {
+    const KernelTable& table = active();
+    size_t j = 0;
+    for (; j + 4 <= aRows; j += 4) {
+        table.dot4U8(aInput, aWeights + j * aDepth, aDepth, aDepth,
+                     aOutput + j);
+    }
+    for (; j < aRows; ++j) {
+        aOutput[j] = table.dotU8(aInput, aWeights + j * aDepth, aDepth);
+    }
+}
+
+void gemm(const double* aInputs, size_t aCount,
+          const double* aWeights, size_t aRows, size_t aDepth,
+          double* aOutput) noexcept {
+    const KernelTable& table = active();
+    gemmBlocked(table.dot, table.dot4, aInputs, aCount, aWeights, aRows,
+                aDepth, aOutput);
+}
+
+void gemm(const float* aInputs, size_t aCount,
+          const float* aWeights, size_t aRows, size_t aDepth,
+          float* aOutput) noexcept {
+    const KernelTable& table = active();
+    gemmBlocked(table.dotF, table.dot4F, aInputs, aCount, aWeights, aRows,
+                aDepth, aOutput);
+}
+
+void gemvTransposed(const double* aVector, const double* aWeights,
+                    size_t aRows, size_t aDepth, double* aOutput) noexcept {
+    gemvTransposedWith(active().axpy4, aVector, aWeights, aRows, aDepth,
+                       aOutput);
+}
+
+void gemvTransposed(const float* aVector, const float* aWeights,
+                    size_t aRows, size_t aDepth, float* aOutput) noexcept {
+    gemvTransposedWith(active().axpy4F, aVector, aWeights, aRows, aDepth,
+                       aOutput);
+}
+
+void sigmoid(double* aValues, size_t aSize) noexcept {
+    active().sigmoid(aValues, aSize);
+}
+
+void sigmoid(float* aValues, size_t aSize) noexcept {
+    active().sigmoidF(aValues, aSize);
+}
+
+void relu(double* aValues, size_t aSize) noexcept {
+    active().relu(aValues, aSize);
+}
+
+void relu(float* aValues, size_t aSize) noexcept {
+    active().reluF(aValues, aSize);
+}
+
+void activate(Neuron::ActivationFunction aFunction,
+              double* aValues, size_t aSize) noexcept {
+    activateWith(aFunction, aValues, aSize);
+}
+
+void activate(Neuron::ActivationFunction aFunction,
+              float* aValues, size_t aSize) noexcept {
+    activateWith(aFunction, aValues, aSize);
+}
+
+}  // namespace kernels
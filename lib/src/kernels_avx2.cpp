@@ -0,0 +1,16 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+// AVX2 build of the vector kernels, see lib/CMakeLists.txt for the flags
+
+#if !defined(__AVX2__)
+#error "kernels_avx2.cpp must be compiled with AVX2 enabled"
+#endif
+
+#define KERNELS_VECTOR_BYTES 32
+#include "src/kernels_simd.hpp"
+
+namespace kernels {
+
+const KernelTable kAvx2Kernels = makeKernelTable();
+
+}  // namespace kernels
@@ -0,0 +1,16 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+// AVX-512 build of the vector kernels, see lib/CMakeLists.txt for the flags
+
+#if !defined(__AVX512F__)
+#error "kernels_avx512.cpp must be compiled with AVX-512 enabled"
+#endif
+
+#define KERNELS_VECTOR_BYTES 64
+#include "src/kernels_simd.hpp"
+
+namespace kernels {
+
+const KernelTable kAvx512Kernels = makeKernelTable();
+
+}  // namespace kernels
@@ -0,0 +1,17 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+// AVX-512 VNNI build of the vector kernels, see lib/CMakeLists.txt for the
+// flags. Only the integer dot product differs from kernels_avx512.cpp.
+
+#if !defined(__AVX512F__) || !defined(__AVX512VNNI__)
+#error "kernels_avx512vnni.cpp must be compiled with AVX-512 VNNI enabled"
+#endif
+
+#define KERNELS_VECTOR_BYTES 64
+#include "src/kernels_simd.hpp"
+
+namespace kernels {
+
+const KernelTable kAvx512VnniKernels = makeKernelTable();
+
+}  // namespace kernels
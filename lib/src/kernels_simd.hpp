@@ -0,0 +1,406 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+// Generic vector implementation of the kernels. It is written with the
+// GCC/Clang vector extensions and compiled once per instruction set by
+// kernels_<isa>.cpp, which defines KERNELS_VECTOR_BYTES (16, 32 or 64) and
+// builds the file with the matching -m flags. Everything here has internal
+// linkage on purpose: code compiled for AVX-512 must never be picked by the
+// linker for a caller running on an SSE2-only CPU.
+
+#ifndef LIB_SRC_KERNELS_SIMD_HPP_
+#define LIB_SRC_KERNELS_SIMD_HPP_
+
+#if !defined(KERNELS_VECTOR_BYTES)
+#error "KERNELS_VECTOR_BYTES must be defined before including this file"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX512VNNI__)
+#include <immintrin.h>
+#endif
+
+#include "src/kerneltable.hpp"
+
+namespace kernels {
+namespace {
+
+// Vector types and exp() constants of one scalar type
+template <typename T>
+struct VectorTraits;
+
+template <>
+struct VectorTraits<double> {
+    typedef double Vec __attribute__((vector_size(KERNELS_VECTOR_BYTES)));
+    typedef int64_t Mask __attribute__((vector_size(KERNELS_VECTOR_BYTES)));
+
+    static constexpr int kMantissaBits = 52;
+    static constexpr double kExpMax = 709.0;
+    static constexpr double kExpMin = -708.0;
+    static constexpr double kLn2Hi = 6.93147180369123816490e-01;
+    static constexpr double kLn2Lo = 1.90821492927058770002e-10;
+    // 1.5 * 2^52: adding it rounds to an integer kept in the low bits
+    static constexpr double kExpShift = 6755399441055744.0;
+    // Taylor coefficients 1/k! of exp(r), enough for ~1 ulp
+    static constexpr int kExpDegree = 13;
+    static constexpr double kExpTerms[kExpDegree + 1] = {
+        1.0, 1.0, 0.5, 1.0 / 6.0, 1.0 / 24.0, 1.0 / 120.0, 1.0 / 720.0,
+        1.0 / 5040.0, 1.0 / 40320.0, 1.0 / 362880.0, 1.0 / 3628800.0,
+        1.0 / 39916800.0, 1.0 / 479001600.0, 1.0 / 6227020800.0};
+};
+
+template <>
+struct VectorTraits<float> {
+    typedef float Vec __attribute__((vector_size(KERNELS_VECTOR_BYTES)));
+    typedef int32_t Mask __attribute__((vector_size(KERNELS_VECTOR_BYTES)));
+
+    static constexpr int kMantissaBits = 23;
+    static constexpr float kExpMax = 88.0f;
+    static constexpr float kExpMin = -87.0f;
+    static constexpr float kLn2Hi = 6.93359375e-01f;
+    static constexpr float kLn2Lo = -2.12194440e-04f;
+    static constexpr float kExpShift = 12582912.0f;  // 1.5 * 2^23
+    static constexpr int kExpDegree = 7;
+    static constexpr float kExpTerms[kExpDegree + 1] = {
+        1.0f, 1.0f, 0.5f, 1.0f / 6.0f, 1.0f / 24.0f, 1.0f / 120.0f,
+        1.0f / 720.0f, 1.0f / 5040.0f};
+};
+
+template <typename T>
+using Vec = typename VectorTraits<T>::Vec;
+template <typename T>
+using Mask = typename VectorTraits<T>::Mask;
+
+template <typename T>
+constexpr size_t kLanes = sizeof(Vec<T>) / sizeof(T);
+
+template <typename T>
+inline Vec<T> load(const T* aData) noexcept {
+    Vec<T> result;
+    __builtin_memcpy(&result, aData, sizeof(result));
+    return result;
+}
+
+template <typename T>
+inline void store(T* aData, Vec<T> aValue) noexcept {
+    __builtin_memcpy(aData, &aValue, sizeof(aValue));
+}
+
+template <typename T>
+inline Vec<T> broadcast(T aValue) noexcept {
+    return Vec<T>{} + aValue;
+}
+
+// Lane-wise aMask ? aLhs : aRhs, aMask lanes are all ones or all zeros
+template <typename T>
+inline Vec<T> select(Mask<T> aMask, Vec<T> aLhs, Vec<T> aRhs) noexcept {
+    return reinterpret_cast<Vec<T>>(
+        (reinterpret_cast<Mask<T>>(aLhs) & aMask) |
+        (reinterpret_cast<Mask<T>>(aRhs) & ~aMask));
+}
+
+template <typename T>
+inline T horizontalSum(Vec<T> aValue) noexcept {
+    T result = 0;
+    for (size_t i = 0; i < kLanes<T>; ++i) {
+        result += aValue[i];
+    }
+    return result;
+}
+
+// exp(x) with ~1 ulp error: x = n * ln2 + r, |r| <= ln2 / 2,
+// exp(r) from its Taylor polynomial, 2^n added straight to the exponent
+template <typename T>
+inline Vec<T> exp(Vec<T> aValue) noexcept {
+    using Traits = VectorTraits<T>;
+
+    const Vec<T> kMax = broadcast<T>(Traits::kExpMax);
+    const Vec<T> kMin = broadcast<T>(Traits::kExpMin);
+    const Vec<T> kLog2e = broadcast<T>(1.4426950408889634074);
+    const Vec<T> kLn2Hi = broadcast<T>(Traits::kLn2Hi);
+    const Vec<T> kLn2Lo = broadcast<T>(Traits::kLn2Lo);
+    const Vec<T> kShift = broadcast<T>(Traits::kExpShift);
+
+    Vec<T> x = select<T>(aValue > kMax, kMax, aValue);
+    x = select<T>(x < kMin, kMin, x);
+
+    const Vec<T> shifted = x * kLog2e + kShift;
+    const Vec<T> n = shifted - kShift;
+    const Vec<T> r = (x - n * kLn2Hi) - n * kLn2Lo;
+
+    Vec<T> p = broadcast<T>(Traits::kExpTerms[Traits::kExpDegree]);
+    for (int k = Traits::kExpDegree - 1; k >= 0; --k) {
+        p = p * r + broadcast<T>(Traits::kExpTerms[k]);
+    }
+
+    const Mask<T> exponent = (reinterpret_cast<Mask<T>>(shifted) -
+        reinterpret_cast<Mask<T>>(kShift)) << Traits::kMantissaBits;
+    return reinterpret_cast<Vec<T>>(reinterpret_cast<Mask<T>>(p) + exponent);
+}
+
+template <typename T>
+inline Vec<T> sigmoid(Vec<T> aValue) noexcept {
+    const Vec<T> one = broadcast<T>(1);
+    return one / (one + exp<T>(-aValue));
+}
+
+template <typename T>
+inline Vec<T> relu(Vec<T> aValue) noexcept {
+    const Mask<T> positive = aValue > Vec<T>{};
+    return reinterpret_cast<Vec<T>>(
+        reinterpret_cast<Mask<T>>(aValue) & positive);
+}
+
+template <typename T>
+T dotVector(const T* aLhs, const T* aRhs, size_t aSize) noexcept {
+    constexpr size_t lanes = kLanes<T>;
+
+    Vec<T> acc0{};
+    Vec<T> acc1{};
+    Vec<T> acc2{};
+    Vec<T> acc3{};
+
+    size_t i = 0;
+    for (; i + 4 * lanes <= aSize; i += 4 * lanes) {
+        acc0 += load(aLhs + i) * load(aRhs + i);
+        acc1 += load(aLhs + i + lanes) * load(aRhs + i + lanes);
+        acc2 += load(aLhs + i + 2 * lanes) * load(aRhs + i + 2 * lanes);
+        acc3 += load(aLhs + i + 3 * lanes) * load(aRhs + i + 3 * lanes);
+    }
+    for (; i + lanes <= aSize; i += lanes) {
+        acc0 += load(aLhs + i) * load(aRhs + i);
+    }
+
+    T result = horizontalSum<T>((acc0 + acc1) + (acc2 + acc3));
+    for (; i < aSize; ++i) {
+        result += aLhs[i] * aRhs[i];
+    }
+
+    return result;
+}
+
+template <typename T>
+void dot4Vector(const T* aRow, const T* aInputs, size_t aStride,
+                size_t aSize, T* aResult) noexcept {
+    const T* input0 = aInputs;
+    const T* input1 = aInputs + aStride;
+    const T* input2 = aInputs + 2 * aStride;
+    const T* input3 = aInputs + 3 * aStride;
+
+    Vec<T> acc0{};
+    Vec<T> acc1{};
+    Vec<T> acc2{};
+    Vec<T> acc3{};
+
+    // Every chunk of the row is loaded once and used for all four inputs
+    size_t i = 0;
+    for (; i + kLanes<T> <= aSize; i += kLanes<T>) {
+        const Vec<T> row = load(aRow + i);
+        acc0 += row * load(input0 + i);
+        acc1 += row * load(input1 + i);
+        acc2 += row * load(input2 + i);
+        acc3 += row * load(input3 + i);
+    }
+
+    aResult[0] = horizontalSum<T>(acc0);
+    aResult[1] = horizontalSum<T>(acc1);
+    aResult[2] = horizontalSum<T>(acc2);
+    aResult[3] = horizontalSum<T>(acc3);
+    for (; i < aSize; ++i) {
+        aResult[0] += aRow[i] * input0[i];
+        aResult[1] += aRow[i] * input1[i];
+        aResult[2] += aRow[i] * input2[i];
+        aResult[3] += aRow[i] * input3[i];
+    }
+}
+
+template <typename T>
+void axpy4Vector(const T* aScales, const T* aRows, size_t aStride,
+                 size_t aSize, T* aResult) noexcept {
+    const T* row0 = aRows;
+    const T* row1 = aRows + aStride;
+    const T* row2 = aRows + 2 * aStride;
+    const T* row3 = aRows + 3 * aStride;
+
+    const Vec<T> scale0 = broadcast<T>(aScales[0]);
+    const Vec<T> scale1 = broadcast<T>(aScales[1]);
+    const Vec<T> scale2 = broadcast<T>(aScales[2]);
+    const Vec<T> scale3 = broadcast<T>(aScales[3]);
+
+    // Every chunk of the result is loaded and stored once for four rows
+    size_t i = 0;
+    for (; i + kLanes<T> <= aSize; i += kLanes<T>) {
+        Vec<T> result = load(aResult + i);
+        result += scale0 * load(row0 + i);
+        result += scale1 * load(row1 + i);
+        result += scale2 * load(row2 + i);
+        result += scale3 * load(row3 + i);
+        store(aResult + i, result);
+    }
+
+    for (; i < aSize; ++i) {
+        T result = aResult[i];
+        result += aScales[0] * row0[i];
+        result += aScales[1] * row1[i];
+        result += aScales[2] * row2[i];
+        result += aScales[3] * row3[i];
+        aResult[i] = result;
+    }
+}
+
+// Integer vectors of the quantized kernels: half a vector of bytes is
+// widened to a full vector of int16, products are summed into int32
+typedef uint8_t Bytes __attribute__((vector_size(KERNELS_VECTOR_BYTES / 2)));
+typedef int8_t SignedBytes
+    __attribute__((vector_size(KERNELS_VECTOR_BYTES / 2)));
+typedef int16_t Words __attribute__((vector_size(KERNELS_VECTOR_BYTES)));
+typedef int32_t Sums __attribute__((vector_size(KERNELS_VECTOR_BYTES)));
+
+constexpr size_t kBytesPerStep = sizeof(Bytes);
+#if defined(__AVX512VNNI__) && KERNELS_VECTOR_BYTES == 64
+constexpr size_t kVnniBytes = 64;
+#endif
+
+inline Words loadWords(const uint8_t* aData) noexcept {
+    Bytes bytes;
+    __builtin_memcpy(&bytes, aData, sizeof(bytes));
+    return __builtin_convertvector(bytes, Words);
+}
+
+inline Words loadWords(const int8_t* aData) noexcept {
+    SignedBytes bytes;
+    __builtin_memcpy(&bytes, aData, sizeof(bytes));
+    return __builtin_convertvector(bytes, Words);
+}
+
+// uint8 x int8 products fit int16 (255 * 127), adjacent pairs are summed
+// into int32 lanes, which is what pmaddwd does
+inline Sums multiplyAdd(Words aLhs, Words aRhs) noexcept {
+    const Sums pairs = reinterpret_cast<Sums>(aLhs * aRhs);
+    return ((pairs << 16) >> 16) + (pairs >> 16);
+}
+
+#if defined(__AVX512VNNI__) && KERNELS_VECTOR_BYTES == 64
+// aAcc + the sums of four adjacent products, 64 bytes in one vpdpbusd
+inline Sums multiplyAddVnni(Sums aAcc, const uint8_t* aLhs,
+                            const int8_t* aRhs) noexcept {
+    return reinterpret_cast<Sums>(_mm512_dpbusd_epi32(
+        reinterpret_cast<__m512i>(aAcc), _mm512_loadu_si512(aLhs),
+        _mm512_loadu_si512(aRhs)));
+}
+#endif
+
+inline int32_t horizontalSum(Sums aValue) noexcept {
+    int32_t result = 0;
+    for (size_t i = 0; i < sizeof(Sums) / sizeof(int32_t); ++i) {
+        result += aValue[i];
+    }
+    return result;
+}
+
+inline int32_t dotU8Vector(const uint8_t* aLhs, const int8_t* aRhs,
+                           size_t aSize) noexcept {
+    Sums acc{};
+    size_t i = 0;
+#if defined(__AVX512VNNI__) && KERNELS_VECTOR_BYTES == 64
+    for (; i + kVnniBytes <= aSize; i += kVnniBytes) {
+        acc = multiplyAddVnni(acc, aLhs + i, aRhs + i);
+    }
+#endif
+    for (; i + kBytesPerStep <= aSize; i += kBytesPerStep) {
+        acc += multiplyAdd(loadWords(aLhs + i), loadWords(aRhs + i));
+    }
+
+    int32_t result = horizontalSum(acc);
+    for (; i < aSize; ++i) {
+        result += static_cast<int32_t>(aLhs[i]) * aRhs[i];
+    }
+
+    return result;
+}
+
+inline void dot4U8Vector(const uint8_t* aInput, const int8_t* aRows,
+                         size_t aStride, size_t aSize,
+                         int32_t* aResult) noexcept {
+    const int8_t* row0 = aRows;
+    const int8_t* row1 = aRows + aStride;
+    const int8_t* row2 = aRows + 2 * aStride;
+    const int8_t* row3 = aRows + 3 * aStride;
+
+    Sums acc0{};
+    Sums acc1{};
+    Sums acc2{};
+    Sums acc3{};
+
+    // Every chunk of the input is loaded once and used for all four rows
+    size_t i = 0;
+#if defined(__AVX512VNNI__) && KERNELS_VECTOR_BYTES == 64
+    for (; i + kVnniBytes <= aSize; i += kVnniBytes) {
+        acc0 = multiplyAddVnni(acc0, aInput + i, row0 + i);
+        acc1 = multiplyAddVnni(acc1, aInput + i, row1 + i);
+        acc2 = multiplyAddVnni(acc2, aInput + i, row2 + i);
+        acc3 = multiplyAddVnni(acc3, aInput + i, row3 + i);
+    }
+#endif
+    for (; i + kBytesPerStep <= aSize; i += kBytesPerStep) {
+        const Words input = loadWords(aInput + i);
+        acc0 += multiplyAdd(input, loadWords(row0 + i));
+        acc1 += multiplyAdd(input, loadWords(row1 + i));
+        acc2 += multiplyAdd(input, loadWords(row2 + i));
+        acc3 += multiplyAdd(input, loadWords(row3 + i));
+    }
+
+    aResult[0] = horizontalSum(acc0);
+    aResult[1] = horizontalSum(acc1);
+    aResult[2] = horizontalSum(acc2);
+    aResult[3] = horizontalSum(acc3);
+    for (; i < aSize; ++i) {
+        const int32_t input = aInput[i];
+        aResult[0] += input * row0[i];
+        aResult[1] += input * row1[i];
+        aResult[2] += input * row2[i];
+        aResult[3] += input * row3[i];
+    }
+}
+
+// Applies aFunction to every value, the tail goes through a padded vector
+template <typename T, Vec<T> (*aFunction)(Vec<T>) noexcept>
+void transformVector(T* aValues, size_t aSize) noexcept {
+    size_t i = 0;
+    for (; i + kLanes<T> <= aSize; i += kLanes<T>) {
+        store(aValues + i, aFunction(load(aValues + i)));
+    }
+
+    if (i < aSize) {
+        Vec<T> tail{};
+        __builtin_memcpy(&tail, aValues + i, (aSize - i) * sizeof(T));
+        tail = aFunction(tail);
+        __builtin_memcpy(aValues + i, &tail, (aSize - i) * sizeof(T));
+    }
+}
+
+template <typename T>
+void sigmoidVector(T* aValues, size_t aSize) noexcept {
+    transformVector<T, sigmoid<T>>(aValues, aSize);
+}
+
+template <typename T>
+void reluVector(T* aValues, size_t aSize) noexcept {
+    transformVector<T, relu<T>>(aValues, aSize);
+}
+
+constexpr KernelTable makeKernelTable() noexcept {
+    return KernelTable{dotVector<double>, dot4Vector<double>,
+                       sigmoidVector<double>, reluVector<double>,
+                       axpy4Vector<double>,
+                       dotVector<float>, dot4Vector<float>,
+                       sigmoidVector<float>, reluVector<float>,
+                       axpy4Vector<float>,
+                       dotU8Vector, dot4U8Vector};
+}
+
+}  // namespace
+}  // namespace kernels
+
+#endif  // LIB_SRC_KERNELS_SIMD_HPP_
@@ -0,0 +1,16 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+// SSE2 build of the vector kernels, see lib/CMakeLists.txt for the flags
+
+#if !defined(__SSE2__)
+#error "kernels_sse2.cpp must be compiled with SSE2 enabled"
+#endif
+
+#define KERNELS_VECTOR_BYTES 16
+#include "src/kernels_simd.hpp"
+
+namespace kernels {
+
+const KernelTable kSse2Kernels = makeKernelTable();
+
+}  // namespace kernels
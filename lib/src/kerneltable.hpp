@@ -0,0 +1,53 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_SRC_KERNELTABLE_HPP_
+#define LIB_SRC_KERNELTABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace kernels {
+
+// One set of kernel entry points per instruction set. Every
+// kernels_<isa>.cpp translation unit is built with its own -m flags and
+// only exports its table, so no ISA specific code can leak into shared
+// inline functions.
+struct KernelTable {
+    double (*dot)(const double*, const double*, size_t) noexcept;
+    // Four dot products of one row with four rows aStride apart
+    void (*dot4)(const double* aRow, const double* aInputs, size_t aStride,
+                 size_t aSize, double* aResult) noexcept;
+    void (*sigmoid)(double*, size_t) noexcept;
+    void (*relu)(double*, size_t) noexcept;
+    // aResult[i] += sum(aScales[k] * aRows[k * aStride + i]) over four rows
+    void (*axpy4)(const double* aScales, const double* aRows, size_t aStride,
+                  size_t aSize, double* aResult) noexcept;
+
+    // Single precision versions of the above
+    float (*dotF)(const float*, const float*, size_t) noexcept;
+    void (*dot4F)(const float* aRow, const float* aInputs, size_t aStride,
+                  size_t aSize, float* aResult) noexcept;
+    void (*sigmoidF)(float*, size_t) noexcept;
+    void (*reluF)(float*, size_t) noexcept;
+    void (*axpy4F)(const float* aScales, const float* aRows, size_t aStride,
+                   size_t aSize, float* aResult) noexcept;
+
+    // Exact uint8 x int8 dot product for quantized inference
+    int32_t (*dotU8)(const uint8_t*, const int8_t*, size_t) noexcept;
+    // Dot products of one input with four rows aStride apart
+    void (*dot4U8)(const uint8_t* aInput, const int8_t* aRows,
+                   size_t aStride, size_t aSize, int32_t* aResult) noexcept;
+};
+
+extern const KernelTable kScalarKernels;
+
+#if defined(RECOGNITION_X86_KERNELS)
+extern const KernelTable kSse2Kernels;
+extern const KernelTable kAvx2Kernels;
+extern const KernelTable kAvx512Kernels;
+extern const KernelTable kAvx512VnniKernels;
+#endif
+
+}  // namespace kernels
+
+#endif  // LIB_SRC_KERNELTABLE_HPP_
@@ -0,0 +1,236 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/layer.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "include/kernels.hpp"
+
+
+template <typename T>
+T BasicLayer<T>::NeuronView::bias() const noexcept {
+    return m_layer->m_biases[m_index];
+}
+
+template <typename T>
+T BasicLayer<T>::NeuronView::weight(size_t aIndex) const noexcept {
+    if (aIndex >= m_layer->m_inputs) {
+        return 0;
+    }
+
+    return m_layer->row(m_index)[aIndex];
+}
+
+template <typename T>
+typename BasicLayer<T>::WeightsView
+BasicLayer<T>::NeuronView::cweights() const noexcept {
+    return WeightsView(m_layer->row(m_index), m_layer->m_inputs);
+}
+
+template <typename T>
+BasicLayer<T>::BasicLayer(size_t aInputs, size_t aNeurons,
+                          ActivationFunction aFunction)
+    : m_storage(aInputs * aNeurons + aNeurons, 0)
+    , m_weights(m_storage.data())
+    , m_biases(m_storage.data() + aInputs * aNeurons)
+    , m_size(aNeurons)
+    , m_inputs(aInputs)
+    , m_function(aFunction) {
+}
+
+template <typename T>
+BasicLayer<T>::BasicLayer(size_t aInputs, size_t aNeurons,
+                          ActivationFunction aFunction,
+                          T* aWeights, T* aBiases,
+                          std::shared_ptr<const void> aOwner)
+    : m_owner(std::move(aOwner))
+    , m_weights(aWeights)
+    , m_biases(aBiases)
+    , m_size(aNeurons)
+    , m_inputs(aInputs)
+    , m_function(aFunction) {
+}
+
+template <typename T>
+BasicLayer<T>::BasicLayer(const BasicLayer& aOther)
+    : m_storage(aOther.m_inputs * aOther.m_size + aOther.m_size)
+    , m_weights(m_storage.data())
+    , m_biases(m_storage.data() + aOther.m_inputs * aOther.m_size)
+    , m_size(aOther.m_size)
+    , m_optimizerState(aOther.m_optimizerState)
+    , m_inputs(aOther.m_inputs)
+    , m_function(aOther.m_function) {
+    std::copy(aOther.m_weights, aOther.m_weights + m_inputs * m_size,
+              m_weights);
+    std::copy(aOther.m_biases, aOther.m_biases + m_size, m_biases);
+}
+
+template <typename T>
+template <typename U>
+BasicLayer<T>::BasicLayer(const BasicLayer<U>& aOther)
+    : BasicLayer(aOther.inputs(), aOther.size(), aOther.function()) {
+    std::transform(aOther.cweights().begin(), aOther.cweights().end(),
+                   m_weights, [](U aValue) { return static_cast<T>(aValue); });
+    std::transform(aOther.cbiases().begin(), aOther.cbiases().end(),
+                   m_biases, [](U aValue) { return static_cast<T>(aValue); });
+}
+
+template <typename T>
+BasicLayer<T>& BasicLayer<T>::operator=(const BasicLayer& aOther) {
+    if (this != &aOther) {
+        BasicLayer copy(aOther);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename T>
+size_t BasicLayer<T>::size() const noexcept {
+    return m_size;
+}
+
+template <typename T>
+size_t BasicLayer<T>::inputs() const noexcept {
+    return m_inputs;
+}
+
+template <typename T>
+typename BasicLayer<T>::ActivationFunction
+BasicLayer<T>::function() const noexcept {
+    return m_function;
+}
+
+template <typename T>
+T* BasicLayer<T>::row(size_t aNeuronIndex) noexcept {
+    return m_weights + aNeuronIndex * m_inputs;
+}
+
+template <typename T>
+const T* BasicLayer<T>::row(size_t aNeuronIndex) const noexcept {
+    return m_weights + aNeuronIndex * m_inputs;
+}
+
+template <typename T>
+typename BasicLayer<T>::template ArrayView<T>
+BasicLayer<T>::weights() noexcept {
+    return ArrayView<T>(m_weights, m_size * m_inputs);
+}
+
+template <typename T>
+typename BasicLayer<T>::template ArrayView<const T>
+BasicLayer<T>::cweights() const noexcept {
+    return ArrayView<const T>(m_weights, m_size * m_inputs);
+}
+
+template <typename T>
+typename BasicLayer<T>::template ArrayView<T>
+BasicLayer<T>::biases() noexcept {
+    return ArrayView<T>(m_biases, m_size);
+}
+
+template <typename T>
+typename BasicLayer<T>::template ArrayView<const T>
+BasicLayer<T>::cbiases() const noexcept {
+    return ArrayView<const T>(m_biases, m_size);
+}
+
+template <typename T>
+bool BasicLayer<T>::ownsParameters() const noexcept {
+    return !m_owner;
+}
+
+template <typename T>
+typename BasicLayer<T>::OptimizerState&
+BasicLayer<T>::optimizerState() noexcept {
+    return m_optimizerState;
+}
+
+template <typename T>
+const typename BasicLayer<T>::OptimizerState&
+BasicLayer<T>::optimizerState() const noexcept {
+    return m_optimizerState;
+}
+
+template <typename T>
+typename BasicLayer<T>::NeuronView
+BasicLayer<T>::operator[](size_t aNeuronIndex) const noexcept {
+    return NeuronView(*this, aNeuronIndex);
+}
+
+template <typename T>
+typename BasicLayer<T>::const_iterator
+BasicLayer<T>::begin() const noexcept {
+    return const_iterator(*this, 0);
+}
+
+template <typename T>
+typename BasicLayer<T>::const_iterator BasicLayer<T>::end() const noexcept {
+    return const_iterator(*this, size());
+}
+
+template <typename T>
+void BasicLayer<T>::forward(const T* aInput, T* aOutput) const noexcept {
+    const T* weights = m_weights;
+    for (size_t j = 0; j < m_size; ++j, weights += m_inputs) {
+        aOutput[j] = m_biases[j] + kernels::dot(aInput, weights, m_inputs);
+    }
+
+    kernels::activate(m_function, aOutput, m_size);
+}
+
+template <typename T>
+void BasicLayer<T>::forwardBatch(const T* aInputs, size_t aCount,
+                                 T* aOutput) const noexcept {
+    const size_t neurons = m_size;
+    kernels::gemm(aInputs, aCount, m_weights, neurons, m_inputs,
+                  aOutput);
+
+    for (size_t sample = 0; sample < aCount; ++sample) {
+        T* output = aOutput + sample * neurons;
+        for (size_t j = 0; j < neurons; ++j) {
+            output[j] += m_biases[j];
+        }
+    }
+
+    kernels::activate(m_function, aOutput, aCount * neurons);
+}
+
+template <typename T>
+void BasicLayer<T>::deltas(const T* aOutput, T* aErrors) const noexcept {
+    if (m_function == ActivationFunction::SIGMOID) {
+        // sigmoid'(z) = sigmoid(z) * (1 - sigmoid(z))
+        for (size_t j = 0; j < m_size; ++j) {
+            aErrors[j] *= aOutput[j] * (T(1) - aOutput[j]);
+        }
+    } else {
+        // relu'(z) is 1 exactly where relu(z) is positive
+        for (size_t j = 0; j < m_size; ++j) {
+            aErrors[j] = aOutput[j] > T(0) ? aErrors[j] : T(0);
+        }
+    }
+}
+
+template <typename T>
+void BasicLayer<T>::inputErrors(const T* aDeltas,
+                                T* aErrors) const noexcept {
+    kernels::gemvTransposed(aDeltas, m_weights, m_size, m_inputs, aErrors);
+}
+
+template <typename T>
+T BasicLayer<T>::activate(T aValue) const noexcept {
+    return static_cast<T>(Neuron::activate(m_function, aValue));
+}
+
+template <typename T>
+T BasicLayer<T>::activateDerivative(T aValue) const noexcept {
+    return static_cast<T>(Neuron::activateDerivative(m_function, aValue));
+}
+
+template class BasicLayer<double>;
+template class BasicLayer<float>;
+
+template BasicLayer<double>::BasicLayer(const BasicLayer<float>&);
+template BasicLayer<float>::BasicLayer(const BasicLayer<double>&);
@@ -0,0 +1,84 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "src/mappedfile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+#include <utility>
+
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& aOther) noexcept
+    : m_data(std::exchange(aOther.m_data, nullptr))
+    , m_size(std::exchange(aOther.m_size, 0))
+    , m_isOpen(std::exchange(aOther.m_isOpen, false)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& aOther) noexcept {
+    if (this != &aOther) {
+        close();
+        m_data = std::exchange(aOther.m_data, nullptr);
+        m_size = std::exchange(aOther.m_size, 0);
+        m_isOpen = std::exchange(aOther.m_isOpen, false);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& aFileName, Mode aMode) {
+    close();
+
+    const int fd = ::open(aFileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 || !S_ISREG(status.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(status.st_size);
+    if (size == 0) {
+        ::close(fd);
+        m_isOpen = true;
+        return true;
+    }
+
+    const int protection = aMode == Mode::READ_ONLY
+        ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* address = ::mmap(nullptr, size, protection, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file referenced on its own
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = static_cast<unsigned char*>(address);
+    m_size = size;
+    m_isOpen = true;
+    return true;
+}
+
+void MappedFile::close() noexcept {
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_size);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_isOpen = false;
+}
+
+void MappedFile::adviseSequential() const noexcept {
+    if (m_data != nullptr) {
+        ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+    }
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_SRC_MAPPEDFILE_HPP_
+#define LIB_SRC_MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <string>
+
+// Whole file mapped into memory. READ_ONLY mappings suit files that are
+// only scanned; COPY_ON_WRITE mappings may be changed in memory while the
+// file itself stays untouched.
+class MappedFile final {
+ public:
+    enum class Mode {
+        READ_ONLY,
+        COPY_ON_WRITE
+    };
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& aOther) noexcept;
+    MappedFile& operator=(MappedFile&& aOther) noexcept;
+
+    // Empty files open successfully with a null data()
+    bool open(const std::string& aFileName, Mode aMode);
+    void close() noexcept;
+
+    // Announces one front-to-back pass over the data
+    void adviseSequential() const noexcept;
+
+    bool isOpen() const noexcept { return m_isOpen; }
+    unsigned char* data() const noexcept { return m_data; }
+    size_t size() const noexcept { return m_size; }
+
+ private:
+    unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_isOpen = false;
+};
+
+#endif  // LIB_SRC_MAPPEDFILE_HPP_
@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#ifndef LIB_SRC_METRICS_HPP_
+#define LIB_SRC_METRICS_HPP_
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdint>
+
+#include "include/trainingmetrics.hpp"
+
+// Instrumentation behind TrainingMetrics. Without RECOGNITION_METRICS
+// every piece of it is empty and compiles to nothing.
+namespace metrics {
+
+// Adds the time from its construction to its destruction to aSeconds
+#ifdef RECOGNITION_METRICS
+class Stopwatch {
+ public:
+    explicit Stopwatch(double& aSeconds)  // NOLINT(runtime/references)
+        : m_seconds(aSeconds)
+        , m_start(std::chrono::steady_clock::now()) {}
+
+    ~Stopwatch() {
+        m_seconds += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    Stopwatch(const Stopwatch&) = delete;
+    Stopwatch& operator=(const Stopwatch&) = delete;
+
+ private:
+    double& m_seconds;
+    const std::chrono::steady_clock::time_point m_start;
+};
+#else
+class Stopwatch {
+ public:
+    explicit Stopwatch(double&) {}  // NOLINT(runtime/references)
+};
+#endif
+
+// Runs aFunction, adding its time to aSeconds
+template <typename Function>
+auto timed(double& aSeconds,  // NOLINT(runtime/references)
+           Function&& aFunction) {
+    Stopwatch stopwatch(aSeconds);
+    return aFunction();
+}
+
+// Heap allocations of the process so far
+struct Allocations {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+#ifdef RECOGNITION_METRICS
+// Counted by the global operator new of allocationcounter.cpp
+Allocations allocations() noexcept;
+#else
+inline Allocations allocations() noexcept {
+    return {};
+}
+#endif
+
+}  // namespace metrics
+
+#endif  // LIB_SRC_METRICS_HPP_
@@ -0,0 +1,136 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/microbatcher.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+MicroBatcher::MicroBatcher(Scorer aScorer, size_t aMaxBatch,
+                           std::chrono::microseconds aLatencyBudget,
+                           size_t aWorkers)
+    : m_scorer(std::move(aScorer))
+    , m_maxBatch(std::max<size_t>(aMaxBatch, 1))
+    , m_latencyBudget(std::max(aLatencyBudget,
+                               std::chrono::microseconds::zero())) {
+    const size_t workers = std::max<size_t>(aWorkers, 1);
+    m_workers.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        m_workers.emplace_back(&MicroBatcher::workerLoop, this);
+    }
+}
+
+MicroBatcher::~MicroBatcher() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+std::future<MicroBatcher::Scores> MicroBatcher::submit(const Image& aImage) {
+    std::future<Scores> scores;
+    bool wake = false;
+    {
+        std::lock_guard lock(m_mutex);
+        m_queue.push_back({aImage, {}, std::chrono::steady_clock::now()});
+        scores = m_queue.back().scores.get_future();
+        // An idle worker starts the latency clock, a waiting one is
+        // done waiting once the batch is full
+        wake = m_queue.size() == 1 || m_queue.size() >= m_maxBatch;
+    }
+
+    if (wake) {
+        m_condition.notify_one();
+    }
+    return scores;
+}
+
+size_t MicroBatcher::maxBatch() const noexcept {
+    return m_maxBatch;
+}
+
+std::chrono::microseconds MicroBatcher::latencyBudget() const noexcept {
+    return m_latencyBudget;
+}
+
+size_t MicroBatcher::batches() const noexcept {
+    return m_batches;
+}
+
+size_t MicroBatcher::images() const noexcept {
+    return m_images;
+}
+
+void MicroBatcher::workerLoop() {
+    std::vector<Image> images;
+    std::vector<std::promise<Scores>> promises;
+
+    for (;;) {
+        bool more = false;
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this] {
+                return m_stop || !m_queue.empty();
+            });
+            if (m_queue.empty()) {
+                return;
+            }
+
+            // Wait for a full batch, but no longer than the oldest image
+            // may wait. Stopping flushes right away.
+            const auto deadline = m_queue.front().arrival + m_latencyBudget;
+            m_condition.wait_until(lock, deadline, [this] {
+                return m_stop || m_queue.size() >= m_maxBatch;
+            });
+            // Another worker took the batch in the meantime
+            if (m_queue.empty()) {
+                continue;
+            }
+
+            const size_t count = std::min(m_queue.size(), m_maxBatch);
+            images.clear();
+            promises.clear();
+            for (size_t i = 0; i < count; ++i) {
+                images.push_back(m_queue.front().image);
+                promises.push_back(std::move(m_queue.front().scores));
+                m_queue.pop_front();
+            }
+            more = !m_queue.empty();
+        }
+
+        // The rest starts its own batch on another worker
+        if (more) {
+            m_condition.notify_one();
+        }
+
+        // Counted before any caller can see the results
+        ++m_batches;
+        m_images += images.size();
+
+        try {
+            std::vector<Scores> scores = m_scorer(images);
+            if (scores.size() != images.size()) {
+                throw std::runtime_error("Scorer returned " +
+                    std::to_string(scores.size()) + " results for " +
+                    std::to_string(images.size()) + " images");
+            }
+
+            for (size_t i = 0; i < promises.size(); ++i) {
+                promises[i].set_value(std::move(scores[i]));
+            }
+        } catch (...) {
+            for (auto& promise : promises) {
+                promise.set_exception(std::current_exception());
+            }
+        }
+    }
+}
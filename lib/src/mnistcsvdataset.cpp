@@ -0,0 +1,506 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/mnistcsvdataset.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>  // NOLINT(build/c++17)
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "include/logger.hpp"
+#include "include/workerpool.hpp"
+#include "src/mappedfile.hpp"
+
+
+// Unnamed namespace to restrict the parser to this translation unit
+namespace {
+using Entry_t = MnistCsvDataSet::Entry_t;
+
+constexpr char kDelimiter = MnistCsvDataSet::kMnistCsvDelimiter;
+constexpr size_t kImageSize = MnistCsvDataSet::kMnistImageSize;
+// Smaller parts of a file are not worth a worker of their own
+constexpr size_t kMinChunkBytes = 1 << 20;
+// Inputs that cannot be mapped are read in blocks of this size
+constexpr size_t kReadBlockBytes = 1 << 20;
+
+constexpr char kCacheExtension[] = ".cache";
+constexpr char kCacheMagic[8] = {'N', 'R', 'M', 'N', 'I', 'S', 'T', '\0'};
+constexpr uint32_t kCacheVersion = 1;
+
+// Binary cache layout: this header, then count Entry_t records exactly as
+// they are laid out in memory, so the mapped file is used as is
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entrySize;   // sizeof(Entry_t) of the writer
+    uint64_t count;
+    uint64_t sourceSize;  // Size of the CSV file
+    int64_t sourceTime;   // Its modification time in nanoseconds
+    uint8_t reserved[24];
+};
+static_assert(sizeof(CacheHeader) == 64, "Cache header must be 64 bytes");
+static_assert(sizeof(Entry_t) == 1 + MnistCsvDataSet::kMnistImageSize &&
+              alignof(Entry_t) == 1, "Entries must be packed to be mapped");
+
+// The white space std::stoi skips, '\n' aside as it ends the line
+bool isBlank(char aChar) {
+    return aChar == ' ' || aChar == '\t' || aChar == '\r' ||
+        aChar == '\v' || aChar == '\f';
+}
+
+bool isDigit(char aChar) {
+    return aChar >= '0' && aChar <= '9';
+}
+
+const char* skipBlanks(const char* aFirst, const char* aLast) {
+    while (aFirst != aLast && isBlank(*aFirst)) {
+        ++aFirst;
+    }
+    return aFirst;
+}
+
+// Fast path for the usual field: plain digits right up to the delimiter
+// or the end of the line. Leaves everything else to parseField().
+bool parseDigits(const char*& aFirst, const char* aLast,
+                 int& aValue) {  // NOLINT(runtime/references)
+    constexpr ptrdiff_t kMaxDigits = 4;
+
+    const char* current = aFirst;
+    int value = 0;
+    while (current != aLast && current - aFirst < kMaxDigits) {
+        const unsigned digit = static_cast<unsigned char>(*current) - '0';
+        if (digit > 9) {
+            break;
+        }
+        value = value * 10 + static_cast<int>(digit);
+        ++current;
+    }
+
+    if (current == aFirst || (current != aLast && *current != kDelimiter)) {
+        return false;
+    }
+
+    aFirst = current;
+    aValue = value;
+    return true;
+}
+
+// Reads one integer field starting at aFirst and moves aFirst to the
+// delimiter after it. As lenient as std::stoi: blanks and a sign may
+// precede the digits, anything after them up to the delimiter is ignored
+// ("+5", "5abc"). Fails on fields that do not start with a number.
+bool parseField(const char*& aFirst, const char* aLast, int& aValue,
+                std::string& aError) {  // NOLINT(runtime/references)
+    if (parseDigits(aFirst, aLast, aValue)) {
+        return true;
+    }
+
+    const char* first = skipBlanks(aFirst, aLast);
+    // from_chars only takes a minus sign
+    const char* digits = first;
+    if (aLast - digits > 1 && *digits == '+' && isDigit(digits[1])) {
+        ++digits;
+    }
+
+    const auto [end, status] = std::from_chars(digits, aLast, aValue);
+    if (status != std::errc()) {
+        const char* fieldEnd = static_cast<const char*>(
+            std::memchr(first, kDelimiter, aLast - first));
+        aError = "Invalid number: '" +
+            std::string(first, fieldEnd ? fieldEnd : aLast) + "'";
+        return false;
+    }
+
+    const char* delimiter = static_cast<const char*>(
+        std::memchr(end, kDelimiter, aLast - end));
+    aFirst = delimiter ? delimiter : aLast;
+    return true;
+}
+
+// Parses the line [aFirst, aLast) into aEntry, explains failures in aError
+bool parseLine(const char* aFirst, const char* aLast,
+               Entry_t& aEntry,  // NOLINT(runtime/references)
+               std::string& aError) {  // NOLINT(runtime/references)
+    if (skipBlanks(aFirst, aLast) == aLast) {
+        aError = "Missing label in CSV file";
+        return false;
+    }
+
+    // Get label
+    int value = 0;
+    if (!parseField(aFirst, aLast, value, aError)) {
+        return false;
+    }
+
+    if (value < 0 || value > 9) {
+        aError = "Invalid label value: " + std::to_string(value);
+        return false;
+    }
+    aEntry.first = static_cast<MnistCsvDataSet::Label_t>(value);
+
+    // Get image. A delimiter at the very end of the line is tolerated.
+    size_t pixelCount = 0;
+    while (aFirst != aLast && ++aFirst != aLast) {
+        if (pixelCount >= kImageSize) {
+            aError = "Too many pixel values in line";
+            return false;
+        }
+
+        if (!parseField(aFirst, aLast, value, aError)) {
+            return false;
+        }
+
+        if (value < 0 || value > 255) {
+            aError = "Pixel out of range: " + std::to_string(value);
+            return false;
+        }
+
+        aEntry.second[pixelCount++] =
+            static_cast<MnistCsvDataSet::Pixel_t>(value);
+    }
+
+    if (pixelCount != kImageSize) {
+        aError = "Invalid pixel count: expected " +
+            std::to_string(kImageSize) + ", got " +
+            std::to_string(pixelCount);
+        return false;
+    }
+
+    return true;
+}
+
+// Reads all of aPath into aData, for inputs that cannot be mapped
+bool readFile(const std::string& aPath,
+              std::vector<char>& aData) {  // NOLINT(runtime/references)
+    std::ifstream file(aPath, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    size_t size = 0;
+    while (file) {
+        aData.resize(size + kReadBlockBytes);
+        file.read(aData.data() + size, kReadBlockBytes);
+        size += static_cast<size_t>(file.gcount());
+    }
+    aData.resize(size);
+
+    return !file.bad();
+}
+
+bool fileStamp(const std::string& aPath,
+               uint64_t& aSize,  // NOLINT(runtime/references)
+               int64_t& aTime) {  // NOLINT(runtime/references)
+    std::error_code error;
+    const auto size = std::filesystem::file_size(aPath, error);
+    if (error) {
+        return false;
+    }
+
+    const auto time = std::filesystem::last_write_time(aPath, error);
+    if (error) {
+        return false;
+    }
+
+    aSize = size;
+    aTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        time.time_since_epoch()).count();
+    return true;
+}
+
+// Newline aligned part of the file, parsed by one worker
+struct Chunk {
+    const char* first;
+    const char* last;
+};
+
+// First failure of a chunk, line 0 if there is none
+struct ChunkError {
+    size_t line = 0;
+    std::string message;
+};
+
+const char* lineEnd(const char* aFirst, const char* aLast) {
+    const void* newline = std::memchr(aFirst, '\n', aLast - aFirst);
+    return newline ? static_cast<const char*>(newline) : aLast;
+}
+
+size_t countLines(const char* aFirst, const char* aLast) {
+    size_t lines = 0;
+    while (aFirst != aLast) {
+        aFirst = lineEnd(aFirst, aLast);
+        aFirst = aFirst == aLast ? aLast : aFirst + 1;
+        ++lines;
+    }
+    return lines;
+}
+
+// Up to aCount chunks of nearly equal size that all start at the
+// beginning of a line; small files are not worth splitting that far
+std::vector<Chunk> splitChunks(const char* aFirst, const char* aLast,
+                               size_t aCount) {
+    const size_t bytes = static_cast<size_t>(aLast - aFirst);
+    const size_t count = std::min(aCount, bytes / kMinChunkBytes + 1);
+
+    std::vector<Chunk> chunks;
+    const char* first = aFirst;
+    for (size_t i = 1; i <= count && first != aLast; ++i) {
+        const char* last = aLast;
+        if (i < count) {
+            const char* split = std::max(first, aFirst + bytes * i / count);
+            last = lineEnd(split, aLast);
+            last = last == aLast ? aLast : last + 1;
+        }
+
+        chunks.push_back({first, last});
+        first = last;
+    }
+
+    if (chunks.empty()) {
+        chunks.push_back({aFirst, aLast});
+    }
+    return chunks;
+}
+
+// Parses every line of aChunk into consecutive entries from aEntries on.
+// aFirstLine is the file line number of the first line of the chunk.
+void parseChunk(const Chunk& aChunk, size_t aFirstLine, Entry_t* aEntries,
+                ChunkError& aError) {  // NOLINT(runtime/references)
+    const char* current = aChunk.first;
+    size_t line = aFirstLine;
+
+    while (current != aChunk.last) {
+        const char* last = lineEnd(current, aChunk.last);
+
+        if (!parseLine(current, last, *aEntries++, aError.message)) {
+            aError.line = line;
+            return;
+        }
+
+        current = last == aChunk.last ? aChunk.last : last + 1;
+        ++line;
+    }
+}
+
+// Writes the cache of aCsvPath for aCount entries, which
+// aWriteEntries(file) appends to the file after the header. Written
+// aside and renamed, so readers never see a partial cache.
+template <typename WriteEntries>
+bool writeCache(const std::string& aCsvPath, uint64_t aCount,
+                uint64_t aCsvSize, int64_t aCsvTime,
+                WriteEntries aWriteEntries) {
+    CacheHeader header{};
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kCacheVersion;
+    header.entrySize = sizeof(Entry_t);
+    header.count = aCount;
+    header.sourceSize = aCsvSize;
+    header.sourceTime = aCsvTime;
+
+    const std::string path = MnistCsvDataSet::cachePath(aCsvPath);
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        aWriteEntries(file);
+        file.close();
+
+        if (!file) {
+            LOG_ERROR << "Unable to write cache " << temporaryPath;
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        LOG_ERROR << "Unable to create cache " << path << ": "
+                  << error.message();
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+
+    LOG_INFO << "Created cache " << path;
+    return true;
+}
+}  // namespace
+
+
+bool MnistCsvDataSet::loadCsv(const std::string& aPath, size_t aThreads) {
+    m_lastError.clear();
+
+    // Regular files are mapped. Pipes and devices, e.g.
+    // <(zcat mnist_train.csv.gz) or /dev/stdin, are read into memory.
+    MappedFile file;
+    std::vector<char> buffer;
+    const char* first = nullptr;
+    const char* end = nullptr;
+    if (file.open(aPath, MappedFile::Mode::READ_ONLY)) {
+        file.adviseSequential();
+        first = reinterpret_cast<const char*>(file.data());
+        end = first + file.size();
+    } else if (readFile(aPath, buffer)) {
+        first = buffer.data();
+        end = first + buffer.size();
+    } else {
+        m_lastError = "Unable to open file " + aPath;
+        LOG_ERROR << m_lastError;
+        return false;
+    }
+
+    // A first line is a header, skip it
+    if (first != end) {
+        first = lineEnd(first, end);
+        first = first == end ? end : first + 1;
+    }
+
+    const size_t threads =
+        aThreads == 0 ? std::thread::hardware_concurrency() : aThreads;
+    const std::vector<Chunk> chunks = splitChunks(first, end,
+        std::max<size_t>(threads, 1));
+    std::vector<size_t> firstEntries(chunks.size() + 1, 0);
+    std::vector<ChunkError> errors(chunks.size());
+
+    WorkerPool pool(chunks.size());
+
+    // Count the lines of every chunk to find its section of the entries
+    pool.run([&](size_t aWorker) {
+        firstEntries[aWorker + 1] =
+            countLines(chunks[aWorker].first, chunks[aWorker].last);
+    });
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        firstEntries[i + 1] += firstEntries[i];
+    }
+
+    container_type temp(firstEntries.back());
+
+    pool.run([&](size_t aWorker) {
+        // The header is line 1
+        parseChunk(chunks[aWorker], firstEntries[aWorker] + 2,
+                   temp.data() + firstEntries[aWorker], errors[aWorker]);
+    });
+
+    // Chunks are in file order, so the first failed one has the first error
+    for (const auto& error : errors) {
+        if (error.line != 0) {
+            m_lastError =
+                "Line " + std::to_string(error.line) + ": " + error.message;
+            LOG_ERROR << aPath << ": " << m_lastError;
+            return false;
+        }
+    }
+
+    auto entries = std::make_shared<const container_type>(std::move(temp));
+    m_entries = entries->data();
+    m_size = entries->size();
+    m_owner = std::move(entries);
+
+    return true;
+}
+
+std::string MnistCsvDataSet::cachePath(const std::string& aCsvPath) {
+    return aCsvPath + kCacheExtension;
+}
+
+bool MnistCsvDataSet::createCache(
+        const std::string& aCsvPath, size_t aCount,
+        const std::function<void(size_t, Entry_t&)>& aEntry) {
+    uint64_t csvSize = 0;
+    int64_t csvTime = 0;
+    if (!fileStamp(aCsvPath, csvSize, csvTime)) {
+        LOG_ERROR << "Unable to create cache, no CSV file " << aCsvPath;
+        return false;
+    }
+
+    return writeCache(aCsvPath, aCount, csvSize, csvTime,
+                      [&](std::ofstream& aFile) {
+        Entry_t entry{};
+        for (size_t i = 0; i < aCount && aFile; ++i) {
+            aEntry(i, entry);
+            aFile.write(reinterpret_cast<const char*>(&entry),
+                        sizeof(entry));
+        }
+    });
+}
+
+bool MnistCsvDataSet::parseLine(const char* aFirst, const char* aLast,
+                                Entry_t& aEntry, std::string& aError) {
+    return ::parseLine(aFirst, aLast, aEntry, aError);
+}
+
+bool MnistCsvDataSet::load(const std::string& aPath, size_t aThreads,
+                           bool aUseCache) {
+    m_lastError.clear();
+
+    // Taken before parsing, a CSV file changed meanwhile is not cached
+    // under its new time
+    uint64_t csvSize = 0;
+    int64_t csvTime = 0;
+    const bool cacheable = aUseCache && fileStamp(aPath, csvSize, csvTime);
+
+    if (cacheable && loadCache(aPath, csvSize, csvTime)) {
+        LOG_INFO << "Loaded " << m_size << " entries from cache "
+                 << cachePath(aPath);
+        return true;
+    }
+
+    if (!loadCsv(aPath, aThreads)) {
+        return false;
+    }
+
+    // The data set is usable without a cache, failures are only logged
+    if (cacheable) {
+        saveCache(aPath, csvSize, csvTime);
+    }
+
+    return true;
+}
+
+bool MnistCsvDataSet::loadCache(const std::string& aCsvPath,
+                                uint64_t aCsvSize, int64_t aCsvTime) {
+    auto mapping = std::make_shared<MappedFile>();
+    if (!mapping->open(cachePath(aCsvPath), MappedFile::Mode::READ_ONLY) ||
+        mapping->size() < sizeof(CacheHeader)) {
+        return false;
+    }
+
+    CacheHeader header;
+    std::memcpy(&header, mapping->data(), sizeof(header));
+    if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 ||
+        header.version != kCacheVersion ||
+        header.entrySize != sizeof(Entry_t) ||
+        header.sourceSize != aCsvSize || header.sourceTime != aCsvTime ||
+        header.count > mapping->size() / sizeof(Entry_t) ||
+        mapping->size() != sizeof(header) + header.count * sizeof(Entry_t)) {
+        LOG_INFO << "Cache " << cachePath(aCsvPath) << " is out of date";
+        return false;
+    }
+
+    m_entries = reinterpret_cast<const Entry_t*>(
+        mapping->data() + sizeof(header));
+    m_size = header.count;
+    m_owner = std::move(mapping);
+    m_isCached = true;
+
+    return true;
+}
+
+bool MnistCsvDataSet::saveCache(const std::string& aCsvPath,
+                                uint64_t aCsvSize, int64_t aCsvTime) const {
+    return writeCache(aCsvPath, m_size, aCsvSize, aCsvTime,
+                      [this](std::ofstream& aFile) {
+        aFile.write(reinterpret_cast<const char*>(m_entries),
+                    m_size * sizeof(Entry_t));
+    });
+}
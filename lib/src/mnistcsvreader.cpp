@@ -0,0 +1,154 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/mnistcsvreader.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+// Read buffer, grown for lines that are longer
+constexpr size_t kBufferSize = 1 << 20;
+}  // namespace
+
+
+MnistCsvReader::MnistCsvReader(std::istream& aInput)
+    : m_input(&aInput)
+    , m_start(aInput.tellg())
+    , m_buffer(kBufferSize)
+    , m_isOpen(static_cast<bool>(aInput)) {
+}
+
+MnistCsvReader::MnistCsvReader(const std::string& aPath)
+    : m_input(&m_file)
+    , m_buffer(kBufferSize) {
+    if (aPath == kStandardInput) {
+        m_input = &std::cin;
+    } else {
+        m_file.open(aPath, std::ios::binary);
+    }
+
+    m_start = m_input->tellg();
+    m_isOpen = static_cast<bool>(*m_input);
+    if (!m_isOpen) {
+        fail("Unable to open file " + aPath);
+    }
+}
+
+bool MnistCsvReader::isOpen() const noexcept {
+    return m_isOpen;
+}
+
+size_t MnistCsvReader::read(Entries& aEntries, size_t aCount) {
+    aEntries.resize(aCount);
+    size_t count = 0;
+
+    const char* first = nullptr;
+    const char* last = nullptr;
+    std::string error;
+
+    // A first line is a header, skip it
+    if (!m_failed && m_line == 0) {
+        nextLine(first, last);
+    }
+
+    while (!m_failed && count < aCount && nextLine(first, last)) {
+        if (!MnistCsvDataSet::parseLine(first, last, aEntries[count],
+                                        error)) {
+            fail("Line " + std::to_string(m_line) + ": " + error);
+            break;
+        }
+        ++count;
+    }
+
+    if (!m_failed && m_input->bad()) {
+        fail("Unable to read the input stream");
+    }
+
+    aEntries.resize(count);
+    return count;
+}
+
+bool MnistCsvReader::rewind() {
+    if (!m_isOpen || m_start == std::streampos(-1)) {
+        return false;
+    }
+
+    m_input->clear();
+    if (!m_input->seekg(m_start)) {
+        m_input->clear();
+        return false;
+    }
+
+    m_begin = 0;
+    m_end = 0;
+    m_line = 0;
+    m_failed = false;
+    m_lastError.clear();
+    return true;
+}
+
+bool MnistCsvReader::failed() const noexcept {
+    return m_failed;
+}
+
+const std::string& MnistCsvReader::lastError() const noexcept {
+    return m_lastError;
+}
+
+bool MnistCsvReader::refill() {
+    if (m_begin != 0) {
+        std::memmove(m_buffer.data(), m_buffer.data() + m_begin,
+                     m_end - m_begin);
+        m_end -= m_begin;
+        m_begin = 0;
+    }
+
+    // The buffer holds a single, unfinished line
+    if (m_end == m_buffer.size()) {
+        m_buffer.resize(m_buffer.size() * 2);
+    }
+
+    m_input->read(m_buffer.data() + m_end, m_buffer.size() - m_end);
+    const size_t bytes = static_cast<size_t>(m_input->gcount());
+    m_end += bytes;
+    return bytes != 0;
+}
+
+bool MnistCsvReader::nextLine(const char*& aFirst, const char*& aLast) {
+    size_t searched = m_begin;
+    for (;;) {
+        const char* first = m_buffer.data() + m_begin;
+        const void* newline = std::memchr(m_buffer.data() + searched, '\n',
+                                          m_end - searched);
+        if (newline) {
+            aFirst = first;
+            aLast = static_cast<const char*>(newline);
+            m_begin = aLast - m_buffer.data() + 1;
+            ++m_line;
+            return true;
+        }
+
+        // refill() moves the unread bytes to the front of the buffer
+        searched = m_end - m_begin;
+        if (!refill()) {
+            break;
+        }
+    }
+
+    // The last line may lack its newline
+    if (m_begin == m_end) {
+        return false;
+    }
+
+    aFirst = m_buffer.data() + m_begin;
+    aLast = m_buffer.data() + m_end;
+    m_begin = m_end;
+    ++m_line;
+    return true;
+}
+
+void MnistCsvReader::fail(const std::string& aError) {
+    m_failed = true;
+    m_lastError = aError;
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/mnistimage.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "include/logger.hpp"
+
+
+namespace mnistimage {
+
+bool downsample(const uint8_t* aPixels, size_t aWidth, size_t aHeight,
+                size_t aStride, MnistCsvDataSet::Image_t& aImage) {
+    if (!aPixels || aWidth == 0 || aHeight == 0 ||
+        aWidth % kSide || aHeight % kSide || aStride < aWidth) {
+        LOG_ERROR << "Unable to downsample a " << aWidth << "x" << aHeight
+                  << " image with " << aStride << " bytes per row to "
+                  << kSide << "x" << kSide;
+        return false;
+    }
+
+    const size_t boxWidth = aWidth / kSide;
+    const size_t boxHeight = aHeight / kSide;
+    const uint32_t area = static_cast<uint32_t>(boxWidth * boxHeight);
+
+    std::array<uint32_t, kSide> sums;
+    for (size_t y = 0; y < kSide; ++y) {
+        // Sum the boxes of a whole output row scanline by scanline
+        sums.fill(0);
+        const uint8_t* row = aPixels + y * boxHeight * aStride;
+        for (size_t line = 0; line < boxHeight; ++line, row += aStride) {
+            const uint8_t* pixel = row;
+            for (size_t x = 0; x < kSide; ++x) {
+                uint32_t sum = 0;
+                for (size_t i = 0; i < boxWidth; ++i) {
+                    sum += *pixel++;
+                }
+                sums[x] += sum;
+            }
+        }
+
+        // Rounded average brightness, inverted to ink
+        for (size_t x = 0; x < kSide; ++x) {
+            aImage[y * kSide + x] =
+                static_cast<uint8_t>(255 - (sums[x] + area / 2) / area);
+        }
+    }
+
+    return true;
+}
+
+void centerByMass(MnistCsvDataSet::Image_t& aImage) {
+    uint64_t mass = 0;
+    uint64_t massX = 0;
+    uint64_t massY = 0;
+    for (size_t y = 0; y < kSide; ++y) {
+        for (size_t x = 0; x < kSide; ++x) {
+            const uint8_t ink = aImage[y * kSide + x];
+            mass += ink;
+            massX += ink * x;
+            massY += ink * y;
+        }
+    }
+    if (mass == 0) {
+        return;
+    }
+
+    constexpr double kCenter = (kSide - 1) / 2.0;
+    const auto shift = [mass](uint64_t aMoment) {
+        return static_cast<long>(std::lround(
+            kCenter - static_cast<double>(aMoment) / mass));
+    };
+    const long shiftX = shift(massX);
+    const long shiftY = shift(massY);
+    if (shiftX == 0 && shiftY == 0) {
+        return;
+    }
+
+    // Copy the rows that stay inside the image, then the part of each
+    // row that does
+    MnistCsvDataSet::Image_t shifted{};
+    const long side = static_cast<long>(kSide);
+    const long firstX = std::max(0L, shiftX);
+    const long lastX = std::min(side, side + shiftX);
+    for (long y = std::max(0L, shiftY); y < std::min(side, side + shiftY);
+         ++y) {
+        if (firstX < lastX) {
+            std::memcpy(&shifted[y * side + firstX],
+                        &aImage[(y - shiftY) * side + firstX - shiftX],
+                        lastX - firstX);
+        }
+    }
+    aImage = shifted;
+}
+
+}  // namespace mnistimage
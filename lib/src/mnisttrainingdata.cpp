@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/mnisttrainingdata.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace {
+
+template <typename T>
+void normalizeWith(const MnistCsvDataSet::Image_t& aImage, T* aOutput) {
+    // A lookup per pixel, the same values as pixel / 255.0
+    static const std::array<T, 256> kScale = [] {
+        std::array<T, 256> scale{};
+        for (size_t i = 0; i < scale.size(); ++i) {
+            scale[i] = static_cast<T>(static_cast<double>(i) / 255.0);
+        }
+        return scale;
+    }();
+
+    std::transform(aImage.begin(), aImage.end(), aOutput,
+                   [](MnistCsvDataSet::Pixel_t aPixel) {
+                       return kScale[aPixel];
+                   });
+}
+
+}  // namespace
+
+
+TrainingData::Sample MnistTrainingData::sample(size_t aIndex, double* aInput,
+                                               double* aTarget) const {
+    const auto& entry = m_entries[aIndex];
+    normalize(entry.second, aInput);
+    oneHot(entry.first, aTarget);
+
+    return {aInput, aTarget};
+}
+
+void MnistTrainingData::normalize(const MnistCsvDataSet::Image_t& aImage,
+                                  double* aOutput) {
+    normalizeWith(aImage, aOutput);
+}
+
+void MnistTrainingData::normalize(const MnistCsvDataSet::Image_t& aImage,
+                                  float* aOutput) {
+    normalizeWith(aImage, aOutput);
+}
+
+void MnistTrainingData::oneHot(MnistCsvDataSet::Label_t aLabel,
+                               double* aOutput) {
+    std::fill(aOutput, aOutput + kNumClasses, 0.0);
+    if (aLabel < kNumClasses) {
+        aOutput[aLabel] = 1.0;
+    }
+}
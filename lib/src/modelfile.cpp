@@ -0,0 +1,402 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/modelfile.hpp"
+
+#include <cstring>
+#include <filesystem>  // NOLINT(build/c++17)
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "include/logger.hpp"
+#include "src/mappedfile.hpp"
+
+
+// Unnamed namespace to restrict the format details to this translation unit
+namespace {
+using modelfile::kAlignment;
+
+constexpr char kMagic[8] = {'N', 'R', 'M', 'O', 'D', 'E', 'L', '\0'};
+constexpr uint32_t kByteOrder = 0x01020304;
+// Larger layers are taken for a damaged file rather than a model
+constexpr uint64_t kMaxLayerSize = uint64_t{1} << 24;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;    // kByteOrder as written by the saving host
+    uint32_t activation;   // See toActivation()
+    uint32_t layerCount;   // Architecture entries, input layer included
+    uint64_t dataOffset;   // First weight block
+    uint64_t dataSize;     // Bytes from dataOffset to the end of the file
+    uint64_t checksum;     // Of those bytes
+    uint32_t scalarSize;   // Bytes per parameter, 0 in version 1 files
+    uint8_t reserved[12];
+};
+static_assert(sizeof(FileHeader) == 64, "Model file header must be 64 bytes");
+
+uint32_t fromActivation(Neuron::ActivationFunction aFunction) {
+    return aFunction == Neuron::ActivationFunction::RELU ? 1 : 0;
+}
+
+std::optional<Neuron::ActivationFunction> toActivation(uint32_t aValue) {
+    switch (aValue) {
+        case 0:
+            return Neuron::ActivationFunction::SIGMOID;
+        case 1:
+            return Neuron::ActivationFunction::RELU;
+        default:
+            return std::nullopt;
+    }
+}
+
+uint64_t alignUp(uint64_t aValue) {
+    return (aValue + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+// Size of the block of aCount parameters, padding included
+uint64_t blockSize(uint64_t aCount, uint64_t aScalarSize) {
+    return alignUp(aCount * aScalarSize);
+}
+
+// Multiplicative hash over 64-bit words in four independent lanes, so it
+// runs at memory speed. The data is always a multiple of kAlignment bytes.
+class Checksum {
+ public:
+    void update(const void* aData, size_t aSize) {
+        const auto* bytes = static_cast<const unsigned char*>(aData);
+        for (size_t offset = 0; offset + sizeof(uint64_t) <= aSize;
+                offset += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, bytes + offset, sizeof(word));
+
+            uint64_t& lane = m_lanes[m_words++ % kLanes];
+            lane = (lane ^ word) * kPrime;
+            lane ^= lane >> 32;
+        }
+    }
+
+    uint64_t value() const {
+        uint64_t result = m_words;
+        for (const uint64_t lane : m_lanes) {
+            result = (result ^ lane) * kPrime;
+            result ^= result >> 32;
+        }
+        return result;
+    }
+
+ private:
+    static constexpr size_t kLanes = 4;
+    static constexpr uint64_t kPrime = 0x100000001b3ULL;
+
+    uint64_t m_lanes[kLanes] = {0xcbf29ce484222325ULL, 0x84222325cbf29ce4ULL,
+                                0x9e3779b97f4a7c15ULL, 0x7f4a7c159e3779b9ULL};
+    uint64_t m_words = 0;
+};
+
+// Writes aCount parameters padded to the block size
+template <typename T>
+void writeBlock(std::ofstream& aFile,  // NOLINT(runtime/references)
+                Checksum& aChecksum,  // NOLINT(runtime/references)
+                const T* aValues, size_t aCount) {
+    static constexpr char kZeros[kAlignment] = {};
+
+    const size_t bytes = aCount * sizeof(T);
+    const size_t padding = blockSize(aCount, sizeof(T)) - bytes;
+
+    aFile.write(reinterpret_cast<const char*>(aValues), bytes);
+    aFile.write(kZeros, padding);
+
+    // The checksum takes whole 64-bit words: floats may leave half a word,
+    // which is hashed together with the padding
+    const size_t words = bytes / sizeof(uint64_t) * sizeof(uint64_t);
+    char tail[sizeof(uint64_t) + kAlignment] = {};
+    std::memcpy(tail, reinterpret_cast<const char*>(aValues) + words,
+                bytes - words);
+    aChecksum.update(aValues, words);
+    aChecksum.update(tail, bytes - words + padding);
+}
+
+bool readHeader(const std::string& aFileName,
+                FileHeader& aHeader) {  // NOLINT(runtime/references)
+    std::ifstream file(aFileName, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file.read(reinterpret_cast<char*>(&aHeader), sizeof(aHeader));
+    return file.gcount() == sizeof(aHeader) &&
+        std::memcmp(aHeader.magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+template <typename T>
+bool saveLayers(const std::string& aFileName,
+                const std::vector<BasicLayer<T>>& aLayers) {
+    if (aFileName.empty()) {
+        LOG_ERROR << "Empty model file name";
+        return false;
+    }
+
+    if (std::filesystem::exists(aFileName)) {
+        LOG_ERROR << "File " << aFileName << " already exists";
+        return false;
+    }
+
+    if (aLayers.empty()) {
+        LOG_ERROR << "Network is not configured";
+        return false;
+    }
+
+    std::vector<uint64_t> architecture;
+    architecture.push_back(aLayers.front().inputs());
+    for (const auto& layer : aLayers) {
+        architecture.push_back(layer.size());
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = modelfile::kVersion;
+    header.byteOrder = kByteOrder;
+    header.activation = fromActivation(aLayers.front().function());
+    header.layerCount = static_cast<uint32_t>(architecture.size());
+    header.dataOffset =
+        alignUp(sizeof(header) + architecture.size() * sizeof(uint64_t));
+    header.scalarSize = sizeof(T);
+
+    std::ofstream file(aFileName, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR << "Unable to open file " << aFileName;
+        return false;
+    }
+
+    // Header goes first as a placeholder, the checksum is known at the end
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(architecture.data()),
+               architecture.size() * sizeof(uint64_t));
+    const std::vector<char> padding(header.dataOffset -
+        sizeof(header) - architecture.size() * sizeof(uint64_t), 0);
+    file.write(padding.data(), padding.size());
+
+    Checksum checksum;
+    for (const auto& layer : aLayers) {
+        writeBlock(file, checksum, layer.cweights().data(),
+                   layer.cweights().size());
+        writeBlock(file, checksum, layer.cbiases().data(),
+                   layer.cbiases().size());
+    }
+
+    header.dataSize = static_cast<uint64_t>(file.tellp()) - header.dataOffset;
+    header.checksum = checksum.value();
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    file.close();
+    if (!file) {
+        LOG_ERROR << "Unable to write model to the file " << aFileName;
+        return false;
+    }
+
+    LOG_INFO << "Model saved to " << aFileName;
+
+    return true;
+}
+
+// Validated model file, mapped into memory
+struct MappedModel {
+    std::shared_ptr<MappedFile> mapping;
+    std::vector<uint64_t> architecture;  // Input layer included
+    Neuron::ActivationFunction function;
+    size_t scalarSize;
+    unsigned char* data;  // First weight block
+};
+
+std::optional<MappedModel> mapModel(const std::string& aFileName,
+                                    bool aVerify) {
+    // Private writable mapping: the network may change its weights
+    // (copy-on-write), the file itself stays untouched. Shared by all
+    // layers, unmapped together with the last of them.
+    auto mapping = std::make_shared<MappedFile>();
+    if (!mapping->open(aFileName, MappedFile::Mode::COPY_ON_WRITE)) {
+        LOG_ERROR << "Unable to map file " << aFileName;
+        return std::nullopt;
+    }
+
+    const size_t fileSize = mapping->size();
+    if (fileSize < sizeof(FileHeader)) {
+        LOG_ERROR << "File " << aFileName << " is not a model file";
+        return std::nullopt;
+    }
+
+    unsigned char* bytes = mapping->data();
+
+    FileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        LOG_ERROR << "File " << aFileName << " is not a model file";
+        return std::nullopt;
+    }
+
+    if (header.version != 1 && header.version != modelfile::kVersion) {
+        LOG_ERROR << "Unsupported model file version " << header.version;
+        return std::nullopt;
+    }
+
+    if (header.byteOrder != kByteOrder) {
+        LOG_ERROR << "Model file " << aFileName
+            << " was saved with a different byte order";
+        return std::nullopt;
+    }
+
+    const auto function = toActivation(header.activation);
+    if (!function) {
+        LOG_ERROR << "Unknown activation function " << header.activation;
+        return std::nullopt;
+    }
+
+    // Version 1 only had doubles
+    const size_t scalarSize =
+        header.version == 1 ? sizeof(double) : header.scalarSize;
+    if (scalarSize != sizeof(double) && scalarSize != sizeof(float)) {
+        LOG_ERROR << "Unsupported parameter size " << scalarSize
+            << " in model file " << aFileName;
+        return std::nullopt;
+    }
+
+    const uint64_t architectureEnd =
+        sizeof(header) + uint64_t{header.layerCount} * sizeof(uint64_t);
+    if (header.layerCount < 2 || architectureEnd > fileSize ||
+        header.dataOffset < architectureEnd ||
+        header.dataOffset % kAlignment != 0 ||
+        header.dataOffset > fileSize ||
+        header.dataSize != fileSize - header.dataOffset) {
+        LOG_ERROR << "Corrupted header in model file " << aFileName;
+        return std::nullopt;
+    }
+
+    std::vector<uint64_t> architecture(header.layerCount);
+    std::memcpy(architecture.data(), bytes + sizeof(header),
+                architecture.size() * sizeof(uint64_t));
+
+    uint64_t expectedSize = 0;
+    for (size_t i = 0; i < architecture.size(); ++i) {
+        if (architecture[i] == 0 || architecture[i] > kMaxLayerSize) {
+            LOG_ERROR << "Wrong size of layer " << i << " in model file "
+                << aFileName;
+            return std::nullopt;
+        }
+
+        if (i > 0) {
+            expectedSize +=
+                blockSize(architecture[i - 1] * architecture[i],
+                          scalarSize) +
+                blockSize(architecture[i], scalarSize);
+        }
+    }
+
+    if (expectedSize != header.dataSize) {
+        LOG_ERROR << "Weights in model file " << aFileName
+            << " do not match the architecture";
+        return std::nullopt;
+    }
+
+    unsigned char* data = bytes + header.dataOffset;
+    if (aVerify) {
+        Checksum checksum;
+        checksum.update(data, header.dataSize);
+        if (checksum.value() != header.checksum) {
+            LOG_ERROR << "Checksum mismatch in model file " << aFileName;
+            return std::nullopt;
+        }
+    }
+
+    return MappedModel{std::move(mapping), std::move(architecture),
+                       *function, scalarSize, data};
+}
+
+// Layers over the parameters of aModel stored as U. With U == T they use
+// the mapping in place, otherwise they get converted copies.
+template <typename T, typename U>
+std::vector<BasicLayer<T>> buildLayers(const MappedModel& aModel) {
+    std::vector<BasicLayer<T>> layers;
+    layers.reserve(aModel.architecture.size() - 1);
+
+    unsigned char* data = aModel.data;
+    for (size_t i = 1; i < aModel.architecture.size(); ++i) {
+        const size_t inputs = aModel.architecture[i - 1];
+        const size_t neurons = aModel.architecture[i];
+
+        auto* weights = reinterpret_cast<U*>(data);
+        data += blockSize(inputs * neurons, sizeof(U));
+        auto* biases = reinterpret_cast<U*>(data);
+        data += blockSize(neurons, sizeof(U));
+
+        BasicLayer<U> mapped(inputs, neurons, aModel.function, weights,
+                             biases, aModel.mapping);
+        if constexpr (std::is_same_v<T, U>) {
+            layers.push_back(std::move(mapped));
+        } else {
+            layers.emplace_back(mapped);
+        }
+    }
+
+    return layers;
+}
+
+template <typename T, typename Network>
+bool loadNetwork(const std::string& aFileName,
+                 Network& aNetwork,  // NOLINT(runtime/references)
+                 bool aVerify) {
+    const auto model = mapModel(aFileName, aVerify);
+    if (!model) {
+        return false;
+    }
+
+    if (model->scalarSize == sizeof(T)) {
+        return aNetwork.initializeNetwork(buildLayers<T, T>(*model));
+    }
+
+    using Other = std::conditional_t<std::is_same_v<T, double>,
+                                     float, double>;
+    return aNetwork.initializeNetwork(buildLayers<T, Other>(*model));
+}
+}  // namespace
+
+namespace modelfile {
+
+bool isModelFile(const std::string& aFileName) {
+    FileHeader header;
+    return readHeader(aFileName, header);
+}
+
+bool save(const std::string& aFileName, const Perceptron& aNetwork) {
+    if (!aNetwork.isConfigured()) {
+        LOG_ERROR << "Network is not configured";
+        return false;
+    }
+
+    return saveLayers(aFileName, aNetwork.layers());
+}
+
+bool save(const std::string& aFileName, const FloatPerceptron& aNetwork) {
+    if (!aNetwork.isConfigured()) {
+        LOG_ERROR << "Network is not configured";
+        return false;
+    }
+
+    return saveLayers(aFileName, aNetwork.layers());
+}
+
+bool load(const std::string& aFileName, Perceptron& aNetwork, bool aVerify) {
+    return loadNetwork<double>(aFileName, aNetwork, aVerify);
+}
+
+bool load(const std::string& aFileName, FloatPerceptron& aNetwork,
+          bool aVerify) {
+    return loadNetwork<float>(aFileName, aNetwork, aVerify);
+}
+
+}  // namespace modelfile
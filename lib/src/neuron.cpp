@@ -7,6 +7,8 @@
 #include <stdexcept>
 #include <vector>
 
+#include "include/kernels.hpp"
+
 
 Neuron::Neuron(int aInputs, ActivationFunction aFunction)
     : m_weights(aInputs, 0.0)
@@ -63,9 +65,14 @@ void Neuron::updateWeights(const std::vector<double>& aInputs,
 }
 
 double Neuron::activate(double aValue) const noexcept {
+    return activate(m_function, aValue);
+}
+
+double Neuron::activate(ActivationFunction aFunction,
+    double aValue) noexcept {
     double result;
 
-    switch (m_function) {
+    switch (aFunction) {
         case ActivationFunction::SIGMOID: {
             result = sigmoid(aValue);
             break;
@@ -80,18 +87,23 @@ double Neuron::activate(double aValue) const noexcept {
     return result;
 }
 
-double Neuron::sigmoid(double aValue) const noexcept {
+double Neuron::sigmoid(double aValue) noexcept {
     return 1.0 / (1.0 + std::exp(-aValue));
 }
 
-double Neuron::relu(double aValue) const noexcept {
+double Neuron::relu(double aValue) noexcept {
     return std::max(0.0, aValue);
 }
 
 double Neuron::activateDerivative(double aValue) const noexcept {
+    return activateDerivative(m_function, aValue);
+}
+
+double Neuron::activateDerivative(ActivationFunction aFunction,
+    double aValue) noexcept {
     double result;
 
-    switch (m_function) {
+    switch (aFunction) {
         case ActivationFunction::SIGMOID:
             result = sigmoidDerivative(aValue);
             break;
@@ -105,24 +117,20 @@ double Neuron::activateDerivative(double aValue) const noexcept {
     return result;
 }
 
-double Neuron::sigmoidDerivative(double aValue) const noexcept {
+double Neuron::sigmoidDerivative(double aValue) noexcept {
     const double sig = sigmoid(aValue);
     return sig * (1 - sig);
 }
 
-double Neuron::reluDerivative(double aValue) const noexcept {
+double Neuron::reluDerivative(double aValue) noexcept {
     return (aValue > 0) ? 1.0 : 0.0;
 }
 
 double Neuron::sum(const std::vector<double>& aInputs) const noexcept {
-    double result = m_bias;
     if (aInputs.size() != m_weights.size()) {
         return 0.0;
     }
 
-    for (size_t i = 0; i < aInputs.size(); ++i) {
-        result += aInputs[i] * m_weights[i];
-    }
-
-    return result;
+    return m_bias +
+        kernels::dot(aInputs.data(), m_weights.data(), m_weights.size());
 }
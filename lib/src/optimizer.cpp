@@ -0,0 +1,141 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/optimizer.hpp"
+
+#include <cmath>
+#include <memory>
+#include <string>
+
+
+// Unnamed namespace to restrict the update rules to this translation unit
+namespace {
+class SgdOptimizer final : public Optimizer {
+ public:
+    explicit SgdOptimizer(double aLearningRate) noexcept
+        : Optimizer(aLearningRate) {}
+
+    size_t stateSlots() const noexcept override { return 0; }
+
+    void update(const Parameters& aParams, size_t aBegin, size_t aEnd,
+                uint64_t) const noexcept override {
+        for (size_t k = aBegin; k < aEnd; ++k) {
+            aParams.values[k] += m_learningRate * aParams.direction[k];
+        }
+    }
+};
+
+class MomentumOptimizer final : public Optimizer {
+ public:
+    MomentumOptimizer(double aLearningRate, double aMomentum) noexcept
+        : Optimizer(aLearningRate), m_momentum(aMomentum) {}
+
+    size_t stateSlots() const noexcept override { return 1; }
+
+    void update(const Parameters& aParams, size_t aBegin, size_t aEnd,
+                uint64_t) const noexcept override {
+        double* velocity = aParams.state;
+        for (size_t k = aBegin; k < aEnd; ++k) {
+            velocity[k] = m_momentum * velocity[k] + aParams.direction[k];
+            aParams.values[k] += m_learningRate * velocity[k];
+        }
+    }
+
+ private:
+    double m_momentum;
+};
+
+class AdamOptimizer final : public Optimizer {
+ public:
+    AdamOptimizer(double aLearningRate, double aBeta1, double aBeta2,
+                  double aEpsilon) noexcept
+        : Optimizer(aLearningRate)
+        , m_beta1(aBeta1)
+        , m_beta2(aBeta2)
+        , m_epsilon(aEpsilon) {}
+
+    size_t stateSlots() const noexcept override { return 2; }
+
+    void update(const Parameters& aParams, size_t aBegin, size_t aEnd,
+                uint64_t aStep) const noexcept override {
+        double* first = aParams.state;
+        double* second = aParams.state + aParams.size;
+
+        // Bias corrections of the zero-initialized moments
+        const double step = static_cast<double>(aStep);
+        const double correction1 = 1.0 - std::pow(m_beta1, step);
+        const double correction2 = 1.0 - std::pow(m_beta2, step);
+        const double rate = m_learningRate / correction1;
+        const double scale2 = 1.0 / correction2;
+
+        for (size_t k = aBegin; k < aEnd; ++k) {
+            const double direction = aParams.direction[k];
+            first[k] = m_beta1 * first[k] + (1.0 - m_beta1) * direction;
+            second[k] = m_beta2 * second[k] +
+                (1.0 - m_beta2) * direction * direction;
+            aParams.values[k] += rate * first[k] /
+                (std::sqrt(second[k] * scale2) + m_epsilon);
+        }
+    }
+
+ private:
+    double m_beta1;
+    double m_beta2;
+    double m_epsilon;
+};
+}  // namespace
+
+Optimizer::Optimizer(double aLearningRate) noexcept
+    : m_learningRate(aLearningRate) {
+}
+
+std::unique_ptr<Optimizer> Optimizer::create(
+        const TrainingOptions& aOptions) {
+    switch (aOptions.optimizer) {
+        case OptimizerType::MOMENTUM:
+            return std::make_unique<MomentumOptimizer>(aOptions.learningRate,
+                                                       aOptions.momentum);
+        case OptimizerType::ADAM:
+            return std::make_unique<AdamOptimizer>(aOptions.learningRate,
+                aOptions.beta1, aOptions.beta2, aOptions.epsilon);
+        case OptimizerType::SGD:
+        default:
+            return std::make_unique<SgdOptimizer>(aOptions.learningRate);
+    }
+}
+
+void Optimizer::beginStep(Layer& aLayer) const {
+    Layer::OptimizerState& state = aLayer.optimizerState();
+    const size_t slotCount = stateSlots();
+
+    if (state.slotCount != slotCount) {
+        state.weights.assign(slotCount * aLayer.cweights().size(), 0.0);
+        state.biases.assign(slotCount * aLayer.size(), 0.0);
+        state.slotCount = slotCount;
+        state.step = 0;
+    }
+
+    ++state.step;
+}
+
+const char* optimizerName(OptimizerType aType) noexcept {
+    switch (aType) {
+        case OptimizerType::MOMENTUM:
+            return "momentum";
+        case OptimizerType::ADAM:
+            return "adam";
+        case OptimizerType::SGD:
+        default:
+            return "sgd";
+    }
+}
+
+std::optional<OptimizerType> optimizerFromName(const std::string& aName) {
+    for (auto type : {OptimizerType::SGD, OptimizerType::MOMENTUM,
+                      OptimizerType::ADAM}) {
+        if (aName == optimizerName(type)) {
+            return type;
+        }
+    }
+
+    return std::nullopt;
+}
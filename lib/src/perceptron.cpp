@@ -2,25 +2,439 @@
 
 #include "include/perceptron.hpp"
 
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
 #include <complex>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "include/logger.hpp"
+#include "include/optimizer.hpp"
+#include "include/workerpool.hpp"
+#include "src/inference.hpp"
+#include "src/metrics.hpp"
+
+// Unnamed namespace to restrict the training helpers to this translation unit
+namespace {
+// Scratch state of one training thread
+struct TrainingState {
+    TrainingState(const std::vector<Layer>& aLayers, bool aGradients)
+        : input(aLayers.front().inputs()),
+          target(aLayers.back().size()) {
+        for (const auto& layer : aLayers) {
+            activations.emplace_back(layer.size());
+            deltas.emplace_back(layer.size());
+            if (aGradients) {
+                weightGradients.emplace_back(layer.cweights().size());
+                biasGradients.emplace_back(layer.size());
+            }
+        }
+    }
+
+    void resetGradients() {
+        for (auto& gradients : weightGradients) {
+            std::fill(gradients.begin(), gradients.end(), 0.0);
+        }
+        for (auto& gradients : biasGradients) {
+            std::fill(gradients.begin(), gradients.end(), 0.0);
+        }
+        error = 0.0;
+    }
+
+    // Buffers for samples the training data produces on the fly
+    std::vector<double> input;
+    std::vector<double> target;
+    std::vector<std::vector<double>> activations;  // Outputs of every layer
+    std::vector<std::vector<double>> deltas;
+    std::vector<std::vector<double>> weightGradients;
+    std::vector<std::vector<double>> biasGradients;
+    double error = 0.0;
+
+    // Time this thread spent on the phases of TrainingMetrics
+    double dataSeconds = 0.0;
+    double forwardSeconds = 0.0;
+    double backwardSeconds = 0.0;
+};
+
+const double* layerInput(const double* aInput, const TrainingState& aState,
+                         size_t aLayerIndex) {
+    return aLayerIndex == 0 ? aInput
+                            : aState.activations[aLayerIndex - 1].data();
+}
+
+// Forward pass and error back propagation for one sample. Leaves the
+// outputs and deltas of every layer in aState, adds the squared error.
+void backpropagate(const std::vector<Layer>& aLayers, const double* aInput,
+                   const double* aTarget,
+                   TrainingState& aState) {  // NOLINT(runtime/references)
+    {
+        metrics::Stopwatch stopwatch(aState.forwardSeconds);
+        for (size_t i = 0; i < aLayers.size(); ++i) {
+            aLayers[i].forward(layerInput(aInput, aState, i),
+                               aState.activations[i].data());
+        }
+    }
+
+    metrics::Stopwatch stopwatch(aState.backwardSeconds);
+    const size_t last = aLayers.size() - 1;
+    const std::vector<double>& outputs = aState.activations[last];
+    std::vector<double>& errors = aState.deltas[last];
+    for (size_t j = 0; j < errors.size(); ++j) {
+        errors[j] = aTarget[j] - outputs[j];
+        aState.error += errors[j] * errors[j];
+    }
 
+    // The errors of a hidden layer are the deltas of the next one
+    // propagated back through its weights
+    for (size_t i = last + 1; i-- > 0;) {
+        aLayers[i].deltas(aState.activations[i].data(),
+                          aState.deltas[i].data());
+        if (i > 0) {
+            aLayers[i].inputErrors(aState.deltas[i].data(),
+                                   aState.deltas[i - 1].data());
+        }
+    }
+}
+
+// Classic per-sample SGD step straight from the deltas
+void applyDeltas(std::vector<Layer>& aLayers,  // NOLINT(runtime/references)
+                 const double* aInput, const TrainingState& aState,
+                 double aLearningRate) {
+    for (size_t i = 0; i < aLayers.size(); ++i) {
+        Layer& layer = aLayers[i];
+        const double* inputs = layerInput(aInput, aState, i);
+
+        for (size_t j = 0; j < layer.size(); ++j) {
+            const double step = aLearningRate * aState.deltas[i][j];
+            double* weights = layer.row(j);
+            for (size_t k = 0; k < layer.inputs(); ++k) {
+                weights[k] += step * inputs[k];
+            }
+
+            layer.biases()[j] += step;
+        }
+    }
+}
+
+void accumulateGradients(const std::vector<Layer>& aLayers,
+                         const double* aInput,
+                         TrainingState& aState) {  // NOLINT
+    for (size_t i = 0; i < aLayers.size(); ++i) {
+        const Layer& layer = aLayers[i];
+        const double* inputs = layerInput(aInput, aState, i);
+        double* gradients = aState.weightGradients[i].data();
+
+        for (size_t j = 0; j < layer.size(); ++j) {
+            const double delta = aState.deltas[i][j];
+            double* row = gradients + j * layer.inputs();
+            for (size_t k = 0; k < layer.inputs(); ++k) {
+                row[k] += delta * inputs[k];
+            }
+
+            aState.biasGradients[i][j] += delta;
+        }
+    }
+}
+
+// Sums the gradients of all workers for the aWorker-th part of every
+// layer's parameters (always in worker order) into the first worker's
+// accumulators and lets the optimizer apply the averaged direction
+void applyGradients(std::vector<Layer>& aLayers,  // NOLINT
+                    std::vector<TrainingState>& aStates,  // NOLINT
+                    const Optimizer& aOptimizer, double aScale,
+                    const WorkerPool& aPool, size_t aWorker) {
+    auto reduce = [&aStates, aScale](
+            std::vector<std::vector<double>> TrainingState::* aGradients,
+            size_t aLayer, size_t aBegin, size_t aEnd) {
+        double* total = (aStates.front().*aGradients)[aLayer].data();
+        for (size_t k = aBegin; k < aEnd; ++k) {
+            double gradient = 0.0;
+            for (const auto& state : aStates) {
+                gradient += (state.*aGradients)[aLayer][k];
+            }
+            total[k] = aScale * gradient;
+        }
+        return total;
+    };
+
+    for (size_t i = 0; i < aLayers.size(); ++i) {
+        Layer& layer = aLayers[i];
+        Layer::OptimizerState& state = layer.optimizerState();
+
+        const auto weights = layer.weights();
+        const auto [begin, end] = aPool.chunk(weights.size(), aWorker);
+        const Optimizer::Parameters weightParams{weights.data(),
+            reduce(&TrainingState::weightGradients, i, begin, end),
+            state.weights.data(), weights.size()};
+        aOptimizer.update(weightParams, begin, end, state.step);
+
+        const auto biases = layer.biases();
+        const auto [biasBegin, biasEnd] = aPool.chunk(biases.size(), aWorker);
+        const Optimizer::Parameters biasParams{biases.data(),
+            reduce(&TrainingState::biasGradients, i, biasBegin, biasEnd),
+            state.biases.data(), biases.size()};
+        aOptimizer.update(biasParams, biasBegin, biasEnd, state.step);
+    }
+}
+// Samples a TrainingStream is asked for at once, rounded to whole batches
+constexpr size_t kStreamChunkSamples = 4096;
+
+// Progress of one epoch, reported through TrainingOptions::onProgress
+class EpochProgress {
+ public:
+    EpochProgress(const TrainingOptions& aOptions, int aEpoch,
+                  size_t aEpochSamples)
+        : m_onProgress(aOptions.onProgress)
+        , m_stopToken(aOptions.stopToken)
+        , m_start(std::chrono::steady_clock::now()) {
+        m_progress.epoch = aEpoch;
+        m_progress.epochs = aOptions.epochs;
+        m_progress.epochSamples = aEpochSamples;
+    }
+
+    bool isStopped() const {
+        return m_stopToken && m_stopToken->load(std::memory_order_relaxed);
+    }
+
+    // Counts a batch of aSamples with the squared errors aError
+    void addBatch(size_t aSamples, double aError) {
+        m_error += aError;
+        m_progress.samples += aSamples;
+        report();
+    }
+
+    void finish() {
+        m_progress.isEpochDone = true;
+        report();
+    }
+
+    size_t samples() const {
+        return m_progress.samples;
+    }
+
+    double loss() const {
+        return m_progress.samples ? m_error / m_progress.samples : 0.0;
+    }
+
+ private:
+    void report() {
+        if (!m_onProgress) {
+            return;
+        }
+
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - m_start;
+        m_progress.loss = loss();
+        m_progress.samplesPerSecond = elapsed.count() > 0.0
+            ? m_progress.samples / elapsed.count() : 0.0;
+        m_onProgress(m_progress);
+    }
+
+    const std::function<void(const TrainingProgress&)>& m_onProgress;
+    const std::atomic<bool>* const m_stopToken;
+    const std::chrono::steady_clock::time_point m_start;
+    TrainingProgress m_progress;
+    double m_error = 0.0;
+};
+
+// Optimizer, worker threads and their scratch state of one train() call,
+// kept over all its epochs
+class Trainer {
+ public:
+    Trainer(const std::vector<Layer>& aLayers,
+            const TrainingOptions& aOptions)
+        : m_learningRate(aOptions.learningRate)
+        , m_batchSize(std::max<size_t>(aOptions.batchSize, 1))
+        , m_optimizer(Optimizer::create(aOptions))
+          // Plain SGD on single samples updates straight from the deltas
+        , m_perSample(m_batchSize == 1 &&
+                      aOptions.optimizer == OptimizerType::SGD)
+          // A batch of one sample has nothing to share between threads
+        , m_pool(m_batchSize == 1 ? 1 : aOptions.threads)
+        , m_start(std::chrono::steady_clock::now())
+        , m_startAllocations(metrics::allocations()) {
+        if (m_pool.size() < aOptions.threads) {
+            LOG_INFO << "Training on 1 thread, " << aOptions.threads
+                     << " threads need a batch size above 1";
+        }
+
+        m_states.reserve(m_pool.size());
+        for (size_t i = 0; i < m_pool.size(); ++i) {
+            m_states.emplace_back(aLayers, !m_perSample);
+        }
+    }
+
+    // Trains aLayers on all samples of aData in batches, counting them in
+    // aProgress. False when training was stopped before the end of aData.
+    bool train(std::vector<Layer>& aLayers,  // NOLINT(runtime/references)
+               const TrainingData& aData,
+               EpochProgress& aProgress) {  // NOLINT(runtime/references)
+        // For all batches
+        for (size_t first = 0; first < aData.size();
+                first += m_batchSize) {
+            if (aProgress.isStopped()) {
+                return false;
+            }
+
+            const size_t count =
+                std::min(m_batchSize, aData.size() - first);
+            if constexpr (TrainingMetrics::kEnabled) {
+                ++m_batches;
+                m_samples += count;
+            }
+
+            if (m_perSample) {
+                TrainingState& state = m_states.front();
+                state.error = 0.0;
+                const auto sample = metrics::timed(state.dataSeconds, [&] {
+                    return aData.sample(first, state.input.data(),
+                                        state.target.data());
+                });
+                backpropagate(aLayers, sample.input, sample.target, state);
+                {
+                    metrics::Stopwatch stopwatch(m_updateSeconds);
+                    applyDeltas(aLayers, sample.input, state,
+                                m_learningRate);
+                }
+                aProgress.addBatch(count, state.error);
+                continue;
+            }
+
+            // Every worker back-propagates its part of the batch
+            m_pool.run([&](size_t aWorker) {
+                TrainingState& state = m_states[aWorker];
+                state.resetGradients();
+
+                const auto [begin, end] = m_pool.chunk(count, aWorker);
+                for (size_t sample = first + begin; sample < first + end;
+                        ++sample) {
+                    const auto data = metrics::timed(state.dataSeconds,
+                        [&] {
+                            return aData.sample(sample, state.input.data(),
+                                                state.target.data());
+                        });
+                    backpropagate(aLayers, data.input, data.target, state);
+                    metrics::Stopwatch stopwatch(state.backwardSeconds);
+                    accumulateGradients(aLayers, data.input, state);
+                }
+            });
+
+            double batchError = 0.0;
+            for (const auto& state : m_states) {
+                batchError += state.error;
+            }
+
+            {
+                metrics::Stopwatch stopwatch(m_updateSeconds);
+                for (auto& layer : aLayers) {
+                    m_optimizer->beginStep(layer);
+                }
+
+                // Every worker reduces and applies its part of the weights
+                const double scale = 1.0 / static_cast<double>(count);
+                m_pool.run([&](size_t aWorker) {
+                    applyGradients(aLayers, m_states, *m_optimizer, scale,
+                                   m_pool, aWorker);
+                });
+            }
+            aProgress.addBatch(count, batchError);
+        }
+
+        return true;
+    }
+
+    // Metrics of all train() calls so far, empty without
+    // RECOGNITION_METRICS
+    TrainingMetrics metrics(const std::vector<Layer>& aLayers,
+                            int aEpochs) const {
+        TrainingMetrics result;
+        if constexpr (!TrainingMetrics::kEnabled) {
+            return result;
+        }
+
+        result.epochs = aEpochs;
+        result.samples = m_samples;
+        result.batches = m_batches;
+        result.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - m_start).count();
+        result.samplesPerSecond = result.seconds > 0.0
+            ? static_cast<double>(m_samples) / result.seconds : 0.0;
+
+        for (const auto& state : m_states) {
+            result.dataSeconds += state.dataSeconds;
+            result.forwardSeconds += state.forwardSeconds;
+            result.backwardSeconds += state.backwardSeconds;
+        }
+        result.updateSeconds = m_updateSeconds;
+
+        // Per sample: the forward pass, the deltas (but those of the
+        // output layer) and the gradients. Per update: every parameter.
+        const uint64_t updates = m_perSample ? m_samples : m_batches;
+        for (size_t i = 0; i < aLayers.size(); ++i) {
+            TrainingMetrics::Layer& layer = result.layers.emplace_back();
+            layer.inputs = aLayers[i].inputs();
+            layer.neurons = aLayers[i].size();
+
+            const uint64_t weights = layer.inputs * layer.neurons;
+            const uint64_t deltas = i + 1 < aLayers.size()
+                ? layer.neurons * aLayers[i + 1].size() : 0;
+            layer.forwardFlops = 2 * weights * m_samples;
+            layer.backwardFlops = 2 * (deltas + weights) * m_samples;
+            layer.updateFlops = 2 * (weights + layer.neurons) * updates;
+        }
+
+        const metrics::Allocations allocations = metrics::allocations();
+        result.allocations = allocations.count - m_startAllocations.count;
+        result.allocatedBytes =
+            allocations.bytes - m_startAllocations.bytes;
+        return result;
+    }
+
+ private:
+    const double m_learningRate;
+    const size_t m_batchSize;
+    const std::unique_ptr<Optimizer> m_optimizer;
+    const bool m_perSample;
+    WorkerPool m_pool;
+    std::vector<TrainingState> m_states;
+
+    // See TrainingMetrics
+    const std::chrono::steady_clock::time_point m_start;
+    const metrics::Allocations m_startAllocations;
+    double m_updateSeconds = 0.0;
+    uint64_t m_samples = 0;
+    uint64_t m_batches = 0;
+};
+}  // namespace
+
+
+Perceptron::Workspace::Workspace(const Perceptron& aNetwork) {
+    reserve(aNetwork.m_maxLayerSize);
+}
+
+void Perceptron::Workspace::reserve(size_t aLayerSize) {
+    if (m_current.size() < aLayerSize) {
+        m_current.resize(aLayerSize);
+        m_next.resize(aLayerSize);
+    }
+}
 
 Perceptron::Perceptron(const std::vector<size_t> &aLayers,
-                       Neuron::ActivationFunction aFunction) {
-    initializeNetwork(aLayers, aFunction);
+                       Neuron::ActivationFunction aFunction,
+                       std::optional<uint32_t> aSeed) {
+    initializeNetwork(aLayers, aFunction, aSeed);
 }
 
 bool Perceptron::initializeNetwork(const std::vector<size_t>& aLayers,
-    Neuron::ActivationFunction aFunction) {
+    Neuron::ActivationFunction aFunction, std::optional<uint32_t> aSeed) {
     m_isConfigured = false;
     m_isTrained = false;
     m_layers.clear();
+    m_maxLayerSize = 0;
 
     if (aLayers.size() < 2) {
         LOG_ERROR << "Network must have at least input and output layers";
@@ -28,22 +442,25 @@ bool Perceptron::initializeNetwork(const std::vector<size_t>& aLayers,
     }
 
     std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(aSeed ? *aSeed : rd());
     std::normal_distribution<double> dist(0.0, 1.0);
 
-    m_layers.resize(aLayers.size() - 1);  // Without first (input) layer
+    m_layers.reserve(aLayers.size() - 1);  // Without first (input) layer
     for (size_t layerIndex = 1; layerIndex < aLayers.size(); ++layerIndex) {
-        m_layers[layerIndex - 1].resize(aLayers[layerIndex],
-            Neuron(aLayers[layerIndex - 1], aFunction));
-
-        for (auto& neuron : m_layers[layerIndex - 1]) {
-            for (size_t neuronIndex = 0; neuronIndex < neuron.cweights().size();
-                    ++neuronIndex) {
-                neuron.setWeight(neuronIndex, dist(gen));
+        Layer& layer = m_layers.emplace_back(aLayers[layerIndex - 1],
+            aLayers[layerIndex], aFunction);
+
+        for (size_t neuronIndex = 0; neuronIndex < layer.size();
+                ++neuronIndex) {
+            double* weights = layer.row(neuronIndex);
+            for (size_t i = 0; i < layer.inputs(); ++i) {
+                weights[i] = dist(gen);
             }
 
-            neuron.setBias(dist(gen));
+            layer.biases()[neuronIndex] = dist(gen);
         }
+
+        m_maxLayerSize = std::max(m_maxLayerSize, layer.size());
     }
 
     LOG_INFO << "Network configured: ";
@@ -57,6 +474,34 @@ bool Perceptron::initializeNetwork(const std::vector<size_t>& aLayers,
     return true;
 }
 
+bool Perceptron::initializeNetwork(std::vector<Layer> aLayers) {
+    m_isConfigured = false;
+    m_isTrained = false;
+    m_layers.clear();
+    m_maxLayerSize = 0;
+
+    if (aLayers.empty()) {
+        LOG_ERROR << "Network must have at least input and output layers";
+        return false;
+    }
+
+    for (size_t i = 1; i < aLayers.size(); ++i) {
+        if (aLayers[i].inputs() != aLayers[i - 1].size()) {
+            LOG_ERROR << "Inputs of layer " << i + 1
+                << " do not match the size of layer " << i;
+            return false;
+        }
+    }
+
+    m_layers = std::move(aLayers);
+    for (const auto& layer : m_layers) {
+        m_maxLayerSize = std::max(m_maxLayerSize, layer.size());
+    }
+
+    m_isConfigured = true;
+    return true;
+}
+
 bool Perceptron::isConfigured() const {
     return m_isConfigured;
 }
@@ -64,83 +509,194 @@ bool Perceptron::isConfigured() const {
 std::vector<std::vector<double>> Perceptron::forward(
         const std::vector<double>& aInput) const {
     std::vector<std::vector<double>> activations;
+    activations.reserve(m_layers.size() + 1);
     activations.push_back(aInput);  // Push input layer
 
     for (const auto& layer : m_layers) {
-        std::vector<double> newActivations;
-        for (auto& neuron : layer) {
-            newActivations.push_back(neuron.output(activations.back()));
+        std::vector<double> newActivations(layer.size(), 0.0);
+        if (activations.back().size() == layer.inputs()) {
+            layer.forward(activations.back().data(), newActivations.data());
         }
-        activations.push_back(newActivations);  // Add another layer
+        activations.push_back(std::move(newActivations));  // Add layer
     }
 
     return activations;
 }
 
+std::vector<std::vector<double>> Perceptron::forwardBatch(
+        const std::vector<double>& aInputs, size_t aCount) const {
+    if (m_layers.empty() || aCount == 0) {
+        return {};
+    }
+
+    if (aInputs.size() != aCount * m_layers.front().inputs()) {
+        LOG_ERROR << "Batch size does not match the input layer size";
+        return {};
+    }
+
+    return inference::forwardBatch(m_layers, m_maxLayerSize,
+                                   aInputs.data(), aCount);
+}
+
+bool Perceptron::infer(const double* aInput, double* aOutput,
+                       Workspace& aWorkspace) const {
+    if (m_layers.empty()) {
+        LOG_ERROR << "Network is not configured";
+        return false;
+    }
+
+    aWorkspace.reserve(m_maxLayerSize);
+    inference::infer(m_layers, aInput, aOutput, aWorkspace.m_current,
+                     aWorkspace.m_next);
+    return true;
+}
+
+bool Perceptron::infer(const std::vector<double>& aInput,
+                       std::vector<double>& aOutput) const {
+    thread_local Workspace workspace;
+
+    if (aInput.size() != inputSize()) {
+        LOG_ERROR << "Input size does not match the input layer size";
+        return false;
+    }
+
+    aOutput.resize(outputSize());
+    return infer(aInput.data(), aOutput.data(), workspace);
+}
+
+size_t Perceptron::inputSize() const {
+    return m_layers.empty() ? 0 : m_layers.front().inputs();
+}
+
+size_t Perceptron::outputSize() const {
+    return m_layers.empty() ? 0 : m_layers.back().size();
+}
+
 void Perceptron::train(const std::vector<std::vector<double>>& aInputData,
             const std::vector<std::vector<double>>& aTargetData,
             int aEpochs, double aLearningRate) {
+    TrainingOptions options;
+    options.epochs = aEpochs;
+    options.learningRate = aLearningRate;
+
+    train(aInputData, aTargetData, options);
+}
+
+void Perceptron::train(const std::vector<std::vector<double>>& aInputData,
+            const std::vector<std::vector<double>>& aTargetData,
+            const TrainingOptions& aOptions) {
+    if (aInputData.size() != aTargetData.size()) {
+        m_isTrained = false;
+        LOG_ERROR << "Number of inputs and targets does not match";
+        return;
+    }
+
+    // An unconfigured network is reported by the overload below
+    for (size_t i = 0; m_isConfigured && i < aInputData.size(); ++i) {
+        if (aInputData[i].size() != inputSize() ||
+            aTargetData[i].size() != outputSize()) {
+            m_isTrained = false;
+            LOG_ERROR << "Sample " << i << " does not match the network";
+            return;
+        }
+    }
+
+    train(VectorTrainingData(aInputData, aTargetData), aOptions);
+}
+
+void Perceptron::train(const TrainingData& aData,
+                       const TrainingOptions& aOptions) {
     m_isTrained = false;
+    m_metrics = TrainingMetrics();
 
     if (!m_isConfigured) {
         LOG_ERROR << "Network is not configured successfully";
         return;
     }
 
+    if (aData.size() != 0 && (aData.inputSize() != inputSize() ||
+                              aData.targetSize() != outputSize())) {
+        LOG_ERROR << "Training data does not match the network";
+        return;
+    }
+
+    Trainer trainer(m_layers, aOptions);
+
     // For all epochs
-    for (int epoch = 0; epoch < aEpochs; ++epoch) {
-        double totalError = 0.0;
-
-        // For all samples
-        for (size_t sample = 0; sample < aInputData.size(); ++sample) {
-            // 1 Stage: Forward pass
-            std::vector<std::vector<double>> activations =
-                // NOLINTNEXTLINE(build/include_what_you_use)
-                forward(aInputData[sample]);
-
-            // 2 Stage: Backpropagation(calculate errors and gradients)
-            std::vector<std::vector<double>> deltas(m_layers.size());
-            for (int i = static_cast<int>(m_layers.size()) - 1; i >= 0; --i) {
-                deltas[i].resize(m_layers[i].size());
-
-                for (size_t j = 0; j < m_layers[i].size(); ++j) {
-                    if (i == m_layers.size() - 1) {
-                        // output layer
-                        double error = aTargetData[sample][j] -
-                            activations[i + 1][j];
-                        deltas[i][j] = error *
-                            m_layers[i][j].activateDerivative(
-                                activations[i + 1][j]);
-                        totalError += error * error;
-                    } else {
-                        // hidden layers
-                        double error = 0.0;
-                        for (size_t k = 0; k < m_layers[i + 1].size(); ++k) {
-                            const auto& weights = m_layers[i + 1][k].cweights();
-                            if (j < weights.size()) {
-                                error += deltas[i + 1][k] * weights[j];
-                            }
-                        }
-                        deltas[i][j] = error *
-                            m_layers[i][j].activateDerivative(
-                                activations[i + 1][j]);
-                    }
-                }
-            }
+    for (int epoch = 0; epoch < aOptions.epochs; ++epoch) {
+        EpochProgress progress(aOptions, epoch + 1, aData.size());
+        if (!trainer.train(m_layers, aData, progress)) {
+            LOG_INFO << "Training stopped in epoch " << epoch + 1;
+            m_metrics = trainer.metrics(m_layers, epoch);
+            return;
+        }
+        progress.finish();
 
-            // 3 Stage: Update weights
-            for (size_t i = 0; i < m_layers.size(); ++i) {
-                for (size_t j = 0; j < m_layers[i].size(); ++j) {
-                    m_layers[i][j].updateWeights(activations[i],
-                        aLearningRate, deltas[i][j]);
-                }
+        LOG_INFO << "Epoch " << epoch + 1 << ", Error: " << progress.loss();
+    }
+
+    m_metrics = trainer.metrics(m_layers, aOptions.epochs);
+    m_isTrained = true;
+}
+
+void Perceptron::train(TrainingStream& aStream,
+                       const TrainingOptions& aOptions) {
+    m_isTrained = false;
+    m_metrics = TrainingMetrics();
+
+    if (!m_isConfigured) {
+        LOG_ERROR << "Network is not configured successfully";
+        return;
+    }
+
+    if (aStream.inputSize() != inputSize() ||
+        aStream.targetSize() != outputSize()) {
+        LOG_ERROR << "Training data does not match the network";
+        return;
+    }
+
+    Trainer trainer(m_layers, aOptions);
+    // Whole batches per chunk, so the updates are the same as for the
+    // data set in memory
+    const size_t batchSize = std::max<size_t>(aOptions.batchSize, 1);
+    const size_t chunkSize =
+        batchSize * std::max<size_t>(kStreamChunkSamples / batchSize, 1);
+
+    // For all epochs, one pass over the stream each. Its size is known
+    // once the first pass is done.
+    size_t epochSamples = 0;
+    for (int epoch = 0; epoch < aOptions.epochs; ++epoch) {
+        if (epoch != 0 && !aStream.rewind()) {
+            LOG_ERROR << "Training data cannot be read again for epoch "
+                      << epoch + 1;
+            return;
+        }
+
+        EpochProgress progress(aOptions, epoch + 1, epochSamples);
+        for (;;) {
+            const TrainingData& chunk = aStream.next(chunkSize);
+            if (chunk.size() == 0) {
+                break;
+            }
+            if (!trainer.train(m_layers, chunk, progress)) {
+                LOG_INFO << "Training stopped in epoch " << epoch + 1;
+                m_metrics = trainer.metrics(m_layers, epoch);
+                return;
             }
         }
 
-        LOG_INFO << "Epoch " << epoch + 1
-            << ", Error: " << totalError / aInputData.size();
+        if (aStream.failed()) {
+            LOG_ERROR << "Reading the training data failed in epoch "
+                      << epoch + 1;
+            return;
+        }
+        epochSamples = progress.samples();
+        progress.finish();
+
+        LOG_INFO << "Epoch " << epoch + 1 << ", Error: " << progress.loss();
     }
 
+    m_metrics = trainer.metrics(m_layers, aOptions.epochs);
     m_isTrained = true;
 }
 
@@ -148,7 +704,11 @@ bool Perceptron::isTrained() const {
     return m_isTrained;
 }
 
-const std::vector<std::vector<Neuron>>& Perceptron::layers() const {
+const TrainingMetrics& Perceptron::trainingMetrics() const {
+    return m_metrics;
+}
+
+const std::vector<Layer>& Perceptron::layers() const {
     return m_layers;
 }
 
@@ -164,16 +724,14 @@ bool Perceptron::setNeuronWeights(size_t aLayerIndex, size_t aNeuronIndex,
         return false;
     }
 
-    if (aWeights.size() !=
-            m_layers[aLayerIndex][aNeuronIndex].cweights().size()) {
+    Layer& layer = m_layers[aLayerIndex];
+    if (aWeights.size() != layer.inputs()) {
         LOG_ERROR << "The size of the weights vector does not "
             << "match the number of weights in the neuron";
         return false;
     }
 
-    for (size_t i = 0; i < aWeights.size(); ++i) {
-        m_layers[aLayerIndex][aNeuronIndex].setWeight(i, aWeights[i]);
-    }
+    std::copy(aWeights.begin(), aWeights.end(), layer.row(aNeuronIndex));
 
     return true;
 }
@@ -190,6 +748,6 @@ bool Perceptron::setNeuronBias(size_t aLayerIndex, size_t aNeuronIndex,
         return false;
     }
 
-    m_layers[aLayerIndex][aNeuronIndex].setBias(aBias);
+    m_layers[aLayerIndex].biases()[aNeuronIndex] = aBias;
     return true;
 }
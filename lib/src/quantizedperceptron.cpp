@@ -0,0 +1,219 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/quantizedperceptron.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "include/kernels.hpp"
+#include "include/logger.hpp"
+
+namespace {
+
+constexpr float kMaxInput = 255.0f;
+constexpr double kMaxWeight = 127.0;
+
+// Largest output of every layer but the last over the first aSamples
+// samples of aCalibration
+std::vector<double> calibrate(const Perceptron& aNetwork,
+                              const TrainingData& aCalibration,
+                              size_t aSamples) {
+    const auto& layers = aNetwork.layers();
+    std::vector<double> maxima(layers.size() - 1, 0.0);
+
+    std::vector<double> input(aCalibration.inputSize());
+    std::vector<double> target(aCalibration.targetSize());
+    std::vector<double> current;
+    std::vector<double> next;
+    for (size_t i = 0; i < aSamples; ++i) {
+        const double* values =
+            aCalibration.sample(i, input.data(), target.data()).input;
+        for (size_t l = 0; l + 1 < layers.size(); ++l) {
+            next.resize(layers[l].size());
+            layers[l].forward(values, next.data());
+            maxima[l] = std::max(maxima[l],
+                                 *std::max_element(next.begin(), next.end()));
+            std::swap(current, next);
+            values = current.data();
+        }
+    }
+
+    return maxima;
+}
+
+}  // namespace
+
+
+QuantizedPerceptron::Workspace::Workspace(
+        const QuantizedPerceptron& aNetwork) {
+    reserve(aNetwork.m_maxLayerSize);
+}
+
+void QuantizedPerceptron::Workspace::reserve(size_t aLayerSize) {
+    if (m_current.size() < aLayerSize) {
+        m_current.resize(aLayerSize);
+        m_next.resize(aLayerSize);
+        m_sums.resize(aLayerSize);
+        m_values.resize(aLayerSize);
+    }
+}
+
+bool QuantizedPerceptron::quantize(const Perceptron& aNetwork,
+                                   const TrainingData& aCalibration,
+                                   size_t aSamples) {
+    m_layers.clear();
+    m_maxLayerSize = 0;
+
+    if (!aNetwork.isConfigured()) {
+        LOG_ERROR << "Network is not configured";
+        return false;
+    }
+
+    if (aSamples == 0 || aSamples > aCalibration.size()) {
+        LOG_ERROR << "Wrong number of calibration samples: " << aSamples;
+        return false;
+    }
+
+    if (aCalibration.inputSize() != aNetwork.inputSize()) {
+        LOG_ERROR << "Calibration data does not match the input layer size";
+        return false;
+    }
+
+    const std::vector<double> maxima =
+        calibrate(aNetwork, aCalibration, aSamples);
+
+    std::vector<Layer> layers;
+    layers.reserve(aNetwork.layers().size());
+    float inputScale = kInputScale;
+    for (size_t l = 0; l < aNetwork.layers().size(); ++l) {
+        const auto& source = aNetwork.layers()[l];
+
+        Layer layer;
+        layer.inputs = source.inputs();
+        layer.size = source.size();
+        layer.function = source.function();
+        layer.weights.resize(layer.inputs * layer.size);
+        layer.scales.resize(layer.size);
+        layer.biases.assign(source.cbiases().begin(), source.cbiases().end());
+
+        for (size_t j = 0; j < layer.size; ++j) {
+            const double* row = source.row(j);
+            double range = 0.0;
+            for (size_t k = 0; k < layer.inputs; ++k) {
+                range = std::max(range, std::fabs(row[k]));
+            }
+
+            const double scale = range > 0.0 ? range / kMaxWeight : 1.0;
+            int8_t* weights = layer.weights.data() + j * layer.inputs;
+            for (size_t k = 0; k < layer.inputs; ++k) {
+                weights[k] = static_cast<int8_t>(std::lround(row[k] / scale));
+            }
+            layer.scales[j] = static_cast<float>(inputScale * scale);
+        }
+
+        if (l < maxima.size()) {
+            layer.outputScale = maxima[l] > 0.0
+                ? static_cast<float>(maxima[l] / kMaxInput)
+                : kInputScale;
+            inputScale = layer.outputScale;
+        }
+
+        m_maxLayerSize = std::max(m_maxLayerSize, layer.size);
+        layers.push_back(std::move(layer));
+    }
+
+    m_layers = std::move(layers);
+    return true;
+}
+
+bool QuantizedPerceptron::isConfigured() const {
+    return !m_layers.empty();
+}
+
+void QuantizedPerceptron::forward(const Layer& aLayer, const uint8_t* aInput,
+                                  int32_t* aSums, float* aValues) {
+    kernels::gemv(aInput, aLayer.weights.data(), aLayer.size, aLayer.inputs,
+                  aSums);
+    for (size_t j = 0; j < aLayer.size; ++j) {
+        aValues[j] = static_cast<float>(aSums[j]) * aLayer.scales[j] +
+                     aLayer.biases[j];
+    }
+
+    kernels::activate(aLayer.function, aValues, aLayer.size);
+}
+
+std::vector<std::vector<float>> QuantizedPerceptron::forwardBatch(
+        const std::vector<uint8_t>& aInputs, size_t aCount) const {
+    if (m_layers.empty() || aCount == 0) {
+        return {};
+    }
+
+    if (aInputs.size() != aCount * inputSize()) {
+        LOG_ERROR << "Batch size does not match the input layer size";
+        return {};
+    }
+
+    Workspace workspace(*this);
+    std::vector<std::vector<float>> outputs(aCount);
+    for (size_t i = 0; i < aCount; ++i) {
+        outputs[i].resize(outputSize());
+        infer(aInputs.data() + i * inputSize(), outputs[i].data(),
+              workspace);
+    }
+
+    return outputs;
+}
+
+bool QuantizedPerceptron::infer(const uint8_t* aInput, float* aOutput,
+                                Workspace& aWorkspace) const {
+    if (m_layers.empty()) {
+        LOG_ERROR << "Network is not configured";
+        return false;
+    }
+
+    aWorkspace.reserve(m_maxLayerSize);
+    const uint8_t* input = aInput;
+    const size_t last = m_layers.size() - 1;
+    for (size_t l = 0; l < last; ++l) {
+        const Layer& layer = m_layers[l];
+        forward(layer, input, aWorkspace.m_sums.data(),
+                aWorkspace.m_values.data());
+
+        // Requantize for the next layer, values are never negative
+        const float inverse = 1.0f / layer.outputScale;
+        for (size_t j = 0; j < layer.size; ++j) {
+            const float value = aWorkspace.m_values[j] * inverse + 0.5f;
+            aWorkspace.m_next[j] =
+                static_cast<uint8_t>(std::min(value, kMaxInput));
+        }
+
+        std::swap(aWorkspace.m_current, aWorkspace.m_next);
+        input = aWorkspace.m_current.data();
+    }
+
+    forward(m_layers[last], input, aWorkspace.m_sums.data(), aOutput);
+    return true;
+}
+
+bool QuantizedPerceptron::infer(const std::vector<uint8_t>& aInput,
+                                std::vector<float>& aOutput) const {
+    thread_local Workspace workspace;
+
+    if (aInput.size() != inputSize()) {
+        LOG_ERROR << "Input size does not match the input layer size";
+        return false;
+    }
+
+    aOutput.resize(outputSize());
+    return infer(aInput.data(), aOutput.data(), workspace);
+}
+
+size_t QuantizedPerceptron::inputSize() const {
+    return m_layers.empty() ? 0 : m_layers.front().inputs;
+}
+
+size_t QuantizedPerceptron::outputSize() const {
+    return m_layers.empty() ? 0 : m_layers.back().size;
+}
@@ -0,0 +1,160 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/recognitionpipeline.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "include/boundedqueue.hpp"
+#include "include/workerpool.hpp"
+
+namespace {
+
+// Batches in flight per inference worker: one being classified, one
+// waiting for it
+constexpr size_t kBatchesPerWorker = 2;
+
+constexpr size_t kWriterWorker = 0;
+constexpr size_t kReaderWorker = 1;
+constexpr size_t kFirstInferenceWorker = 2;
+
+struct Batch {
+    size_t index = 0;
+    RecognitionPipeline::Entries entries;
+    RecognitionPipeline::Predictions predictions;
+};
+
+// Every queue of one run(). Batches circulate from free to input to
+// output and back to free, so there are never more than were put into
+// free at the start.
+struct Queues {
+    explicit Queues(size_t aBatches)
+        : free(aBatches), input(aBatches), output(aBatches) {
+        for (size_t i = 0; i < aBatches; ++i) {
+            free.push(Batch());
+        }
+    }
+
+    // Wakes up every stage after a failure
+    void close() {
+        free.close();
+        input.close();
+        output.close();
+    }
+
+    BoundedQueue<Batch> free;
+    BoundedQueue<Batch> input;
+    BoundedQueue<Batch> output;
+};
+
+}  // namespace
+
+
+RecognitionPipeline::RecognitionPipeline(size_t aThreads, size_t aBatchSize)
+    : m_threads(aThreads == 0
+          ? std::max<size_t>(std::thread::hardware_concurrency(), 1)
+          : aThreads)
+    , m_batchSize(std::max<size_t>(aBatchSize, 1)) {
+}
+
+bool RecognitionPipeline::run(MnistCsvReader& aReader,
+                              const Classifier& aClassifier,
+                              const Sink& aSink) {
+    m_processed = 0;
+    m_lastError.clear();
+    if (!aReader.isOpen()) {
+        m_lastError = aReader.lastError();
+        return false;
+    }
+
+    Queues queues(m_threads * kBatchesPerWorker + 1);
+    std::atomic<size_t> activeWorkers{m_threads};
+
+    auto read = [&] {
+        for (size_t index = 0;; ++index) {
+            auto batch = queues.free.pop();
+            if (!batch) {
+                return;
+            }
+
+            batch->index = index;
+            if (aReader.read(batch->entries, m_batchSize) == 0 ||
+                !queues.input.push(std::move(*batch))) {
+                return;
+            }
+        }
+    };
+
+    auto classify = [&] {
+        while (auto batch = queues.input.pop()) {
+            batch->predictions.resize(batch->entries.size());
+            aClassifier(batch->entries, batch->predictions);
+            if (!queues.output.push(std::move(*batch))) {
+                break;
+            }
+        }
+    };
+
+    // Batches finish out of order; the ones ahead of the next batch to
+    // write wait here, which is bounded by the batches in flight
+    auto write = [&] {
+        std::map<size_t, Batch> pending;
+        size_t next = 0;
+        while (auto batch = queues.output.pop()) {
+            const size_t index = batch->index;
+            pending.emplace(index, std::move(*batch));
+
+            while (!pending.empty() && pending.begin()->first == next) {
+                Batch& ready = pending.begin()->second;
+                aSink(ready.entries, ready.predictions);
+                m_processed += ready.entries.size();
+
+                queues.free.push(std::move(ready));
+                pending.erase(pending.begin());
+                ++next;
+            }
+        }
+    };
+
+    WorkerPool pool(m_threads + kFirstInferenceWorker);
+    pool.run([&](size_t aWorker) {
+        try {
+            if (aWorker == kWriterWorker) {
+                write();
+            } else if (aWorker == kReaderWorker) {
+                read();
+                queues.input.close();
+            } else {
+                classify();
+                if (--activeWorkers == 0) {
+                    queues.output.close();
+                }
+            }
+        } catch (...) {
+            queues.close();
+            throw;
+        }
+    });
+
+    m_lastError = aReader.lastError();
+    return !aReader.failed();
+}
+
+size_t RecognitionPipeline::threads() const noexcept {
+    return m_threads;
+}
+
+size_t RecognitionPipeline::batchSize() const noexcept {
+    return m_batchSize;
+}
+
+size_t RecognitionPipeline::processed() const noexcept {
+    return m_processed;
+}
+
+const std::string& RecognitionPipeline::lastError() const noexcept {
+    return m_lastError;
+}
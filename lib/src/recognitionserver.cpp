@@ -0,0 +1,425 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/recognitionserver.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <future>  // NOLINT(build/c++11)
+#include <string>
+#include <utility>
+#include <vector>
+
+
+// Unnamed namespace to restrict the protocol helpers to this translation
+// unit
+namespace {
+using Image = MicroBatcher::Image;
+using Scores = MicroBatcher::Scores;
+
+constexpr size_t kImageSize = MnistCsvDataSet::kMnistImageSize;
+constexpr char kDelimiter = MnistCsvDataSet::kMnistCsvDelimiter;
+// Longest CSV request line, a MNIST line takes about 3 KiB
+constexpr size_t kMaxLineBytes = 64 * 1024;
+
+// Request of a connection, answered in the order it arrived
+struct Pending {
+    std::future<Scores> scores;
+    std::string error;  // Set when the request was not even submitted
+};
+
+std::string systemError(const std::string& aWhat) {
+    return aWhat + ": " + std::strerror(errno);
+}
+
+void closeSocket(int& aSocket) {  // NOLINT(runtime/references)
+    if (aSocket >= 0) {
+        ::close(aSocket);
+        aSocket = -1;
+    }
+}
+
+// A line of pixels only, or a label and the pixels
+bool parseRequest(const char* aFirst, const char* aLast,
+                  Image& aImage,  // NOLINT(runtime/references)
+                  std::string& aError) {  // NOLINT(runtime/references)
+    MnistCsvDataSet::Entry_t entry;
+    bool isParsed = false;
+    if (static_cast<size_t>(std::count(aFirst, aLast, kDelimiter)) ==
+            kImageSize - 1) {
+        const std::string line = std::string("0") + kDelimiter +
+            std::string(aFirst, aLast);
+        isParsed = MnistCsvDataSet::parseLine(line.data(),
+            line.data() + line.size(), entry, aError);
+    } else {
+        isParsed = MnistCsvDataSet::parseLine(aFirst, aLast, entry, aError);
+    }
+
+    if (isParsed) {
+        aImage = entry.second;
+    }
+    return isParsed;
+}
+
+// "digit,score0,...,scoreN\n"
+void appendCsvReply(const Scores& aScores,
+                    std::string& aOutput) {  // NOLINT(runtime/references)
+    const size_t digit = std::distance(aScores.begin(),
+        std::max_element(aScores.begin(), aScores.end()));
+    aOutput += std::to_string(digit);
+
+    char number[32];
+    for (float score : aScores) {
+        const int length = std::snprintf(number, sizeof(number), ",%.6g",
+                                         static_cast<double>(score));
+        aOutput.append(number, static_cast<size_t>(length));
+    }
+    aOutput += '\n';
+}
+
+void appendRawReply(const Scores& aScores,
+                    std::string& aOutput) {  // NOLINT(runtime/references)
+    aOutput.append(reinterpret_cast<const char*>(aScores.data()),
+                   aScores.size() * sizeof(float));
+}
+
+// True when a server accepts connections on aAddress
+bool isAccepting(const sockaddr_un& aAddress) {
+    int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    const bool isConnected = probe >= 0 &&
+        ::connect(probe, reinterpret_cast<const sockaddr*>(&aAddress),
+                  sizeof(aAddress)) == 0;
+    closeSocket(probe);
+    return isConnected;
+}
+
+bool sendAll(int aSocket, const std::string& aData) {
+    size_t sent = 0;
+    while (sent < aData.size()) {
+        const ssize_t bytes = ::send(aSocket, aData.data() + sent,
+                                     aData.size() - sent, MSG_NOSIGNAL);
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        sent += static_cast<size_t>(bytes);
+    }
+    return true;
+}
+}  // namespace
+
+
+RecognitionServer::RecognitionServer(MicroBatcher& aBatcher, Format aFormat)
+    : m_batcher(aBatcher)
+    , m_format(aFormat) {
+    // Neither end may block: stop() runs in signal handlers, serve()
+    // drains the pipe after waking up
+    if (::pipe(m_stopPipe) == 0) {
+        for (int end : m_stopPipe) {
+            ::fcntl(end, F_SETFL, ::fcntl(end, F_GETFL) | O_NONBLOCK);
+            ::fcntl(end, F_SETFD, FD_CLOEXEC);
+        }
+    } else {
+        fail(systemError("Unable to create the stop pipe"));
+    }
+}
+
+RecognitionServer::~RecognitionServer() {
+    closeSocket(m_listenSocket);
+    if (!m_unixPath.empty()) {
+        ::unlink(m_unixPath.c_str());
+    }
+    closeSocket(m_stopPipe[0]);
+    closeSocket(m_stopPipe[1]);
+}
+
+bool RecognitionServer::listenUnix(const std::string& aPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (aPath.empty() || aPath.size() >= sizeof(address.sun_path)) {
+        return fail("Invalid socket path: " + aPath);
+    }
+    std::memcpy(address.sun_path, aPath.c_str(), aPath.size() + 1);
+
+    // A socket file nobody accepts on is left over by a server that died
+    struct stat status {};
+    if (::stat(aPath.c_str(), &status) == 0) {
+        if (!S_ISSOCK(status.st_mode)) {
+            return fail("File exists and is not a socket: " + aPath);
+        }
+        if (isAccepting(address)) {
+            return fail("Socket is in use: " + aPath);
+        }
+        ::unlink(aPath.c_str());
+    }
+
+    closeSocket(m_listenSocket);
+    m_listenSocket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_listenSocket < 0) {
+        return fail(systemError("Unable to create a socket"));
+    }
+
+    if (::bind(m_listenSocket, reinterpret_cast<sockaddr*>(&address),
+               sizeof(address)) != 0 ||
+        ::listen(m_listenSocket, SOMAXCONN) != 0) {
+        const std::string error =
+            systemError("Unable to listen on " + aPath);
+        closeSocket(m_listenSocket);
+        return fail(error);
+    }
+
+    m_unixPath = aPath;
+    m_port = 0;
+    return true;
+}
+
+bool RecognitionServer::listenTcp(uint16_t aPort) {
+    closeSocket(m_listenSocket);
+    m_listenSocket = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_listenSocket < 0) {
+        return fail(systemError("Unable to create a socket"));
+    }
+
+    const int enable = 1;
+    ::setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, &enable,
+                 sizeof(enable));
+
+    // Localhost only, the service has no authentication
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(aPort);
+    socklen_t length = sizeof(address);
+    if (::bind(m_listenSocket, reinterpret_cast<sockaddr*>(&address),
+               sizeof(address)) != 0 ||
+        ::listen(m_listenSocket, SOMAXCONN) != 0 ||
+        ::getsockname(m_listenSocket, reinterpret_cast<sockaddr*>(&address),
+                      &length) != 0) {
+        const std::string error = systemError(
+            "Unable to listen on port " + std::to_string(aPort));
+        closeSocket(m_listenSocket);
+        return fail(error);
+    }
+
+    m_unixPath.clear();
+    m_port = ntohs(address.sin_port);
+    return true;
+}
+
+uint16_t RecognitionServer::port() const noexcept {
+    return m_port;
+}
+
+bool RecognitionServer::serve() {
+    if (m_listenSocket < 0 || m_stopPipe[0] < 0) {
+        return fail("Server is not listening");
+    }
+
+    bool isServing = true;
+    pollfd sockets[2] = {{m_listenSocket, POLLIN, 0},
+                         {m_stopPipe[0], POLLIN, 0}};
+    while (isServing) {
+        if (::poll(sockets, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            isServing = fail(systemError("Unable to wait for connections"));
+            break;
+        }
+
+        if (sockets[1].revents != 0) {
+            break;
+        }
+
+        if ((sockets[0].revents & POLLIN) == 0) {
+            continue;
+        }
+
+        const int client = ::accept4(m_listenSocket, nullptr, nullptr,
+                                     SOCK_CLOEXEC);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            isServing = fail(systemError("Unable to accept a connection"));
+            break;
+        }
+
+        if (m_port != 0) {
+            // Replies are small and must not wait for more
+            const int enable = 1;
+            ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &enable,
+                         sizeof(enable));
+        }
+
+        reapConnections();
+
+        auto connection = std::make_unique<Connection>();
+        connection->socket = client;
+        Connection& accepted = *connection;
+        {
+            std::lock_guard lock(m_mutex);
+            m_connections.push_back(std::move(connection));
+        }
+        accepted.thread = std::thread(&RecognitionServer::handleConnection,
+                                      this, std::ref(accepted));
+        ++m_accepted;
+    }
+
+    // Wake up every connection still waiting for requests
+    {
+        std::lock_guard lock(m_mutex);
+        for (const auto& connection : m_connections) {
+            if (connection->socket >= 0) {
+                ::shutdown(connection->socket, SHUT_RDWR);
+            }
+        }
+    }
+
+    for (const auto& connection : m_connections) {
+        connection->thread.join();
+    }
+    m_connections.clear();
+
+    // Ready for the next serve()
+    char byte = 0;
+    while (::read(m_stopPipe[0], &byte, 1) > 0) {
+    }
+
+    return isServing;
+}
+
+void RecognitionServer::stop() noexcept {
+    const char byte = 0;
+    const ssize_t written = ::write(m_stopPipe[1], &byte, 1);
+    static_cast<void>(written);
+}
+
+size_t RecognitionServer::connections() const noexcept {
+    return m_accepted;
+}
+
+const std::string& RecognitionServer::lastError() const noexcept {
+    return m_lastError;
+}
+
+void RecognitionServer::handleConnection(Connection& aConnection) {
+    const int socket = aConnection.socket;
+    std::vector<char> input(kMaxLineBytes);
+    size_t begin = 0;
+    size_t end = 0;
+    std::vector<Pending> pending;
+    std::string output;
+    Image image;
+
+    for (bool isOpen = true; isOpen;) {
+        const ssize_t bytes = ::recv(socket, input.data() + end,
+                                     input.size() - end, 0);
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            break;
+        }
+        end += static_cast<size_t>(bytes);
+
+        // Submit every complete request first, so all of them can share
+        // a batch
+        pending.clear();
+        if (m_format == Format::RAW) {
+            for (; end - begin >= kImageSize; begin += kImageSize) {
+                std::memcpy(image.data(), input.data() + begin, kImageSize);
+                pending.push_back({m_batcher.submit(image), {}});
+            }
+        } else {
+            const char* first = input.data() + begin;
+            const char* const last = input.data() + end;
+            while (const void* newline =
+                       std::memchr(first, '\n', last - first)) {
+                const char* lineEnd = static_cast<const char*>(newline);
+                Pending request;
+                if (parseRequest(first, lineEnd, image, request.error)) {
+                    request.scores = m_batcher.submit(image);
+                }
+                pending.push_back(std::move(request));
+                first = lineEnd + 1;
+            }
+            begin = first - input.data();
+        }
+
+        output.clear();
+        for (auto& request : pending) {
+            if (request.error.empty()) {
+                try {
+                    const Scores scores = request.scores.get();
+                    if (m_format == Format::RAW) {
+                        appendRawReply(scores, output);
+                    } else {
+                        appendCsvReply(scores, output);
+                    }
+                    continue;
+                } catch (const std::exception& e) {
+                    request.error = e.what();
+                }
+            }
+
+            // A raw reply has no room for an error
+            if (m_format == Format::RAW) {
+                isOpen = false;
+                break;
+            }
+            output += "error: " + request.error + "\n";
+        }
+
+        if (!sendAll(socket, output)) {
+            break;
+        }
+
+        // Keep the unfinished request at the front
+        std::memmove(input.data(), input.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+        if (end == input.size()) {
+            sendAll(socket, "error: Request line too long\n");
+            break;
+        }
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        aConnection.socket = -1;
+    }
+    ::close(socket);
+    aConnection.isDone = true;
+}
+
+void RecognitionServer::reapConnections() {
+    std::lock_guard lock(m_mutex);
+    for (auto it = m_connections.begin(); it != m_connections.end();) {
+        if ((*it)->isDone) {
+            (*it)->thread.join();
+            it = m_connections.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool RecognitionServer::fail(const std::string& aError) {
+    m_lastError = aError;
+    return false;
+}
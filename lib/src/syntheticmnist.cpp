@@ -0,0 +1,235 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/syntheticmnist.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <string>
+
+#include "include/logger.hpp"
+
+
+namespace {
+using Entry_t = MnistCsvDataSet::Entry_t;
+using syntheticmnist::Defect;
+
+constexpr size_t kImageSize = MnistCsvDataSet::kMnistImageSize;
+constexpr int kSide = MnistCsvDataSet::kMnistImageWidth;
+constexpr char kDelimiter = MnistCsvDataSet::kMnistCsvDelimiter;
+
+// Half a stroke for every label, about 8 pixels long
+constexpr int kDirections[][2] = {
+    {8, 0}, {8, 2}, {6, 5}, {5, 6}, {2, 8},
+    {0, 8}, {-2, 8}, {-5, 6}, {-6, 5}, {-8, 2}
+};
+constexpr int kLabels = sizeof(kDirections) / sizeof(kDirections[0]);
+constexpr int kStrokeSteps = 32;
+constexpr int kPenSize = 3;
+constexpr int kNoisePixels = 8;
+
+// Every row draws from its own streams, so that the image of a row does
+// not depend on whether it is written malformed
+constexpr uint32_t kImageStream = 0;
+constexpr uint32_t kDefectStream = 1;
+
+// The longest line: every field 3 digits and a delimiter, plus an extra
+// pixel and the newline
+constexpr size_t kMaxLineSize = 4 * (kImageSize + 2) + 1;
+
+// SplitMix64. Cheap to seed for every row, and unlike the distributions
+// of the standard library it gives the same numbers everywhere.
+class Random {
+ public:
+    explicit Random(uint64_t aSeed) : m_state(aSeed) {}
+
+    uint64_t next() {
+        uint64_t value = (m_state += 0x9E3779B97F4A7C15ull);
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    // Uniform in [0, aBound)
+    uint32_t below(uint32_t aBound) {
+        return static_cast<uint32_t>(((next() >> 32) * aBound) >> 32);
+    }
+
+    // Uniform in [0, 1)
+    double uniform() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+ private:
+    uint64_t m_state;
+};
+
+Random rowRandom(uint32_t aSeed, size_t aIndex, uint32_t aStream) {
+    return Random((static_cast<uint64_t>(aSeed) << 32 | aStream) ^
+                  static_cast<uint64_t>(aIndex) * 0xD1B54A32D192ED03ull);
+}
+
+// The defect of row aIndex and the pixel it breaks, if it breaks one
+Defect rowDefect(const syntheticmnist::Options& aOptions, size_t aIndex,
+                 size_t& aPixel) {  // NOLINT(runtime/references)
+    if (aOptions.malformedRate <= 0.0) {
+        return Defect::NONE;
+    }
+
+    Random random = rowRandom(aOptions.seed, aIndex, kDefectStream);
+    if (random.uniform() >= aOptions.malformedRate) {
+        return Defect::NONE;
+    }
+
+    const auto defects = static_cast<uint32_t>(Defect::EXTRA_PIXEL);
+    const auto defect = static_cast<Defect>(1 + random.below(defects));
+    aPixel = random.below(kImageSize);
+    return defect;
+}
+
+// "label,1x1,1x2,...,28x28", the header of the common MNIST CSV files
+std::string header() {
+    std::string line = "label";
+    for (int row = 1; row <= kSide; ++row) {
+        for (int column = 1; column <= kSide; ++column) {
+            line += kDelimiter + std::to_string(row) + 'x' +
+                std::to_string(column);
+        }
+    }
+    return line + '\n';
+}
+
+// Formats row aIndex into aLine, returns the end of the line
+char* formatRow(const syntheticmnist::Options& aOptions, size_t aIndex,
+                char* aLine) {
+    char* const end = aLine + kMaxLineSize;
+
+    size_t brokenPixel = kImageSize;
+    const Defect defect = rowDefect(aOptions, aIndex, brokenPixel);
+    if (defect == Defect::EMPTY_LINE) {
+        *aLine++ = '\n';
+        return aLine;
+    }
+
+    Entry_t entry;
+    syntheticmnist::entry(aOptions.seed, aIndex, entry);
+
+    const int label = defect == Defect::INVALID_LABEL ? kLabels : entry.first;
+    aLine = std::to_chars(aLine, end, label).ptr;
+
+    size_t pixels = kImageSize;
+    if (defect == Defect::MISSING_PIXEL) {
+        --pixels;
+    } else if (defect == Defect::EXTRA_PIXEL) {
+        ++pixels;
+    }
+
+    for (size_t i = 0; i < pixels; ++i) {
+        *aLine++ = kDelimiter;
+        if (i == brokenPixel && defect == Defect::INVALID_NUMBER) {
+            *aLine++ = 'x';
+            continue;
+        }
+
+        int value = i < kImageSize ? entry.second[i] : 0;
+        if (i == brokenPixel && defect == Defect::PIXEL_OUT_OF_RANGE) {
+            value = 256;
+        }
+        aLine = std::to_chars(aLine, end, value).ptr;
+    }
+
+    *aLine++ = '\n';
+    return aLine;
+}
+}  // namespace
+
+
+namespace syntheticmnist {
+
+void entry(uint32_t aSeed, size_t aIndex, Entry_t& aEntry) {
+    Random random = rowRandom(aSeed, aIndex, kImageStream);
+
+    const auto label = random.below(kLabels);
+    aEntry.first = static_cast<MnistCsvDataSet::Label_t>(label);
+    aEntry.second.fill(0);
+
+    // Strokes stay clear of the border, as the digits of MNIST do
+    const int centerX = kSide / 2 - 2 + static_cast<int>(random.below(5));
+    const int centerY = kSide / 2 - 2 + static_cast<int>(random.below(5));
+    const int dx = kDirections[label][0];
+    const int dy = kDirections[label][1];
+
+    for (int step = 0; step <= kStrokeSteps; ++step) {
+        const int x = centerX + dx * (2 * step - kStrokeSteps) / kStrokeSteps;
+        const int y = centerY + dy * (2 * step - kStrokeSteps) / kStrokeSteps;
+        const auto ink = static_cast<MnistCsvDataSet::Pixel_t>(
+            255 - random.below(96));
+
+        for (int penY = y - kPenSize / 2; penY <= y + kPenSize / 2; ++penY) {
+            for (int penX = x - kPenSize / 2; penX <= x + kPenSize / 2;
+                 ++penX) {
+                auto& pixel = aEntry.second[penY * kSide + penX];
+                pixel = std::max(pixel, ink);
+            }
+        }
+    }
+
+    for (int i = 0; i < kNoisePixels; ++i) {
+        aEntry.second[random.below(kImageSize)] =
+            static_cast<MnistCsvDataSet::Pixel_t>(random.below(256));
+    }
+}
+
+Defect defect(const Options& aOptions, size_t aIndex) {
+    size_t pixel = 0;
+    return rowDefect(aOptions, aIndex, pixel);
+}
+
+bool writeCsv(std::ostream& aOutput, const Options& aOptions) {
+    aOutput << header();
+
+    char line[kMaxLineSize];
+    for (size_t i = 0; i < aOptions.rows && aOutput; ++i) {
+        const char* end = formatRow(aOptions, i, line);
+        aOutput.write(line, end - line);
+    }
+
+    if (!aOutput) {
+        LOG_ERROR << "Unable to write the synthetic data set";
+        return false;
+    }
+    return true;
+}
+
+bool writeCsv(const std::string& aPath, const Options& aOptions) {
+    std::ofstream file(aPath, std::ios::binary);
+    if (!file) {
+        LOG_ERROR << "Unable to create file " << aPath;
+        return false;
+    }
+
+    if (!writeCsv(file, aOptions)) {
+        return false;
+    }
+
+    file.close();
+    if (!file) {
+        LOG_ERROR << "Unable to write file " << aPath;
+        return false;
+    }
+    return true;
+}
+
+bool writeCache(const std::string& aCsvPath, const Options& aOptions) {
+    if (aOptions.malformedRate > 0.0) {
+        LOG_ERROR << "Data sets with malformed rows cannot be cached";
+        return false;
+    }
+
+    return MnistCsvDataSet::createCache(aCsvPath, aOptions.rows,
+        [&aOptions](size_t aIndex, Entry_t& aEntry) {
+            entry(aOptions.seed, aIndex, aEntry);
+        });
+}
+
+}  // namespace syntheticmnist
@@ -0,0 +1,117 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include "include/workerpool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+
+WorkerPool::WorkerPool(size_t aThreads) {
+    const size_t threads = std::max<size_t>(aThreads, 1);
+    m_threads.reserve(threads - 1);
+    for (size_t i = 1; i < threads; ++i) {
+        m_threads.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_startCondition.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t WorkerPool::size() const noexcept {
+    return m_threads.size() + 1;
+}
+
+void WorkerPool::run(const Task& aTask) {
+    if (m_threads.empty()) {
+        aTask(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &aTask;
+        m_pending = m_threads.size();
+        m_error = nullptr;
+        ++m_generation;
+    }
+    m_startCondition.notify_all();
+
+    std::exception_ptr callerError;
+    try {
+        aTask(0);
+    } catch (...) {
+        callerError = std::current_exception();
+    }
+
+    std::exception_ptr workerError;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [this] { return m_pending == 0; });
+        m_task = nullptr;
+        workerError = std::exchange(m_error, nullptr);
+    }
+
+    if (callerError) {
+        std::rethrow_exception(callerError);
+    }
+    if (workerError) {
+        std::rethrow_exception(workerError);
+    }
+}
+
+std::pair<size_t, size_t> WorkerPool::chunk(size_t aCount,
+        size_t aWorkerIndex) const noexcept {
+    const size_t workers = size();
+    const size_t base = aCount / workers;
+    const size_t extra = aCount % workers;
+
+    const size_t begin = aWorkerIndex * base + std::min(aWorkerIndex, extra);
+    const size_t end = begin + base + (aWorkerIndex < extra ? 1 : 0);
+    return {begin, end};
+}
+
+void WorkerPool::workerLoop(size_t aWorkerIndex) {
+    uint64_t seenGeneration = 0;
+
+    while (true) {
+        const Task* task = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCondition.wait(lock, [this, seenGeneration] {
+                return m_stop || m_generation != seenGeneration;
+            });
+
+            if (m_stop) {
+                return;
+            }
+
+            seenGeneration = m_generation;
+            task = m_task;
+        }
+
+        try {
+            (*task)(aWorkerIndex);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_error) {
+                m_error = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pending == 0) {
+                m_doneCondition.notify_one();
+            }
+        }
+    }
+}
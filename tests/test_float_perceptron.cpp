@@ -0,0 +1,187 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "include/floatperceptron.hpp"
+#include "include/perceptron.hpp"
+
+namespace {
+constexpr size_t kInputs = 20;
+constexpr size_t kClasses = 3;
+
+// Inputs in [0, 1], labelled by the closest of kClasses prototypes
+void makeDataSet(size_t aCount, unsigned aSeed,
+                 std::vector<std::vector<double>>* aInputs,
+                 std::vector<std::vector<double>>* aTargets,
+                 std::vector<size_t>* aLabels) {
+    std::mt19937 gen(aSeed);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    for (size_t i = 0; i < aCount; ++i) {
+        std::vector<double> input(kInputs);
+        for (auto& value : input) {
+            value = dist(gen);
+        }
+
+        double best = -1.0;
+        size_t label = 0;
+        for (size_t c = 0; c < kClasses; ++c) {
+            double score = 0.0;
+            for (size_t k = c; k < kInputs; k += kClasses) {
+                score += input[k];
+            }
+            if (score > best) {
+                best = score;
+                label = c;
+            }
+        }
+
+        std::vector<double> target(kClasses, 0.0);
+        target[label] = 1.0;
+        aInputs->push_back(std::move(input));
+        aTargets->push_back(std::move(target));
+        aLabels->push_back(label);
+    }
+}
+
+template <typename T>
+size_t argmax(const std::vector<T>& aValues) {
+    return std::distance(aValues.begin(),
+                         std::max_element(aValues.begin(), aValues.end()));
+}
+
+std::vector<float> toFloat(const std::vector<double>& aValues) {
+    return std::vector<float>(aValues.begin(), aValues.end());
+}
+}  // namespace
+
+TEST(FloatPerceptronTest, MatchesDoubleOutputs) {
+    const Perceptron network({kInputs, 16, 8, kClasses},
+                             Neuron::ActivationFunction::SIGMOID, 3);
+    const FloatPerceptron rounded(network);
+
+    ASSERT_TRUE(rounded.isConfigured());
+    EXPECT_EQ(rounded.inputSize(), network.inputSize());
+    EXPECT_EQ(rounded.outputSize(), network.outputSize());
+
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    std::vector<size_t> labels;
+    makeDataSet(20, 1, &inputs, &targets, &labels);
+
+    std::vector<double> expected;
+    std::vector<float> actual;
+    for (const auto& input : inputs) {
+        ASSERT_TRUE(network.infer(input, expected));
+        ASSERT_TRUE(rounded.infer(toFloat(input), actual));
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t j = 0; j < expected.size(); ++j) {
+            EXPECT_NEAR(actual[j], expected[j], 1e-4);
+        }
+    }
+}
+
+TEST(FloatPerceptronTest, ForwardBatchMatchesInfer) {
+    const FloatPerceptron network(Perceptron({kInputs, 12, kClasses},
+        Neuron::ActivationFunction::RELU, 5));
+
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    std::vector<size_t> labels;
+    makeDataSet(9, 2, &inputs, &targets, &labels);
+
+    std::vector<float> batch;
+    for (const auto& input : inputs) {
+        batch.insert(batch.end(), input.begin(), input.end());
+    }
+    const auto outputs = network.forwardBatch(batch, inputs.size());
+    ASSERT_EQ(outputs.size(), inputs.size());
+
+    FloatPerceptron::Workspace workspace(network);
+    std::vector<float> output(network.outputSize());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const auto input = toFloat(inputs[i]);
+        ASSERT_TRUE(network.infer(input.data(), output.data(), workspace));
+        for (size_t j = 0; j < output.size(); ++j) {
+            EXPECT_NEAR(outputs[i][j], output[j], 1e-5);
+        }
+    }
+}
+
+TEST(FloatPerceptronTest, AccuracyMatchesDoubleEngine) {
+    std::vector<std::vector<double>> trainInputs;
+    std::vector<std::vector<double>> trainTargets;
+    std::vector<size_t> trainLabels;
+    makeDataSet(600, 7, &trainInputs, &trainTargets, &trainLabels);
+
+    std::vector<std::vector<double>> testInputs;
+    std::vector<std::vector<double>> testTargets;
+    std::vector<size_t> testLabels;
+    makeDataSet(300, 8, &testInputs, &testTargets, &testLabels);
+
+    TrainingOptions options;
+    options.epochs = 20;
+    options.learningRate = 0.01;
+    options.batchSize = 16;
+    options.optimizer = OptimizerType::ADAM;
+
+    Perceptron network({kInputs, 16, kClasses},
+                       Neuron::ActivationFunction::SIGMOID, 11);
+    network.train(trainInputs, trainTargets, options);
+    const FloatPerceptron rounded(network);
+
+    size_t doubleCorrect = 0;
+    size_t floatCorrect = 0;
+    size_t agreements = 0;
+    std::vector<double> expected;
+    std::vector<float> actual;
+    for (size_t i = 0; i < testInputs.size(); ++i) {
+        ASSERT_TRUE(network.infer(testInputs[i], expected));
+        ASSERT_TRUE(rounded.infer(toFloat(testInputs[i]), actual));
+
+        doubleCorrect += argmax(expected) == testLabels[i];
+        floatCorrect += argmax(actual) == testLabels[i];
+        agreements += argmax(expected) == argmax(actual);
+    }
+
+    // The task is learnable, and float gives the same answers
+    EXPECT_GT(doubleCorrect, testInputs.size() * 8 / 10);
+    EXPECT_LE(std::abs(static_cast<long>(doubleCorrect) -
+                       static_cast<long>(floatCorrect)), 3);
+    EXPECT_GE(agreements, testInputs.size() - 3);
+}
+
+TEST(FloatPerceptronTest, ToPerceptronKeepsRoundedWeights) {
+    const FloatPerceptron network(Perceptron({kInputs, 6, kClasses},
+        Neuron::ActivationFunction::SIGMOID, 9));
+
+    const Perceptron widened = network.toPerceptron();
+    ASSERT_TRUE(widened.isConfigured());
+    ASSERT_EQ(widened.layers().size(), network.layers().size());
+    for (size_t i = 0; i < network.layers().size(); ++i) {
+        const auto& expected = network.layers()[i];
+        const auto& actual = widened.layers()[i];
+        EXPECT_EQ(actual.function(), expected.function());
+        for (size_t k = 0; k < expected.cweights().size(); ++k) {
+            EXPECT_EQ(actual.cweights()[k], expected.cweights()[k]);
+        }
+        for (size_t j = 0; j < expected.size(); ++j) {
+            EXPECT_EQ(actual.cbiases()[j], expected.cbiases()[j]);
+        }
+    }
+}
+
+TEST(FloatPerceptronTest, NotConfigured) {
+    const FloatPerceptron network;
+    std::vector<float> output;
+
+    EXPECT_FALSE(network.isConfigured());
+    EXPECT_FALSE(network.infer(std::vector<float>(4), output));
+    EXPECT_TRUE(network.forwardBatch(std::vector<float>(4), 1).empty());
+}
@@ -0,0 +1,328 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "include/kernels.hpp"
+#include "include/neuron.hpp"
+
+namespace {
+constexpr kernels::Isa kAllIsas[] = {kernels::Isa::SCALAR,
+                                     kernels::Isa::SSE2,
+                                     kernels::Isa::AVX2,
+                                     kernels::Isa::AVX512,
+                                     kernels::Isa::AVX512_VNNI};
+
+std::vector<double> randomVector(size_t aSize, double aRange,
+                                 unsigned aSeed) {
+    std::mt19937 gen(aSeed);
+    std::uniform_real_distribution<double> dist(-aRange, aRange);
+
+    std::vector<double> result(aSize);
+    for (auto& value : result) {
+        value = dist(gen);
+    }
+    return result;
+}
+
+std::vector<float> toFloat(const std::vector<double>& aValues) {
+    return std::vector<float>(aValues.begin(), aValues.end());
+}
+
+double scalarDot(const std::vector<double>& aLhs,
+                 const std::vector<double>& aRhs, double* aMagnitude) {
+    double result = 0.0;
+    *aMagnitude = 0.0;
+    for (size_t i = 0; i < aLhs.size(); ++i) {
+        result += aLhs[i] * aRhs[i];
+        *aMagnitude += std::fabs(aLhs[i] * aRhs[i]);
+    }
+    return result;
+}
+}  // namespace
+
+class KernelsTest : public ::testing::TestWithParam<kernels::Isa> {
+ protected:
+    void SetUp() override {
+        m_previous = kernels::activeIsa();
+        if (!kernels::setIsa(GetParam())) {
+            GTEST_SKIP() << kernels::isaName(GetParam())
+                         << " is not supported on this CPU";
+        }
+    }
+
+    void TearDown() override {
+        kernels::setIsa(m_previous);
+    }
+
+ private:
+    kernels::Isa m_previous = kernels::Isa::SCALAR;
+};
+
+TEST(KernelsDispatchTest, DetectedIsaIsActiveByDefault) {
+    EXPECT_EQ(kernels::activeIsa(), kernels::detectIsa());
+    EXPECT_TRUE(kernels::isSupported(kernels::Isa::SCALAR));
+}
+
+TEST_P(KernelsTest, ActiveIsa) {
+    EXPECT_EQ(kernels::activeIsa(), GetParam());
+}
+
+TEST_P(KernelsTest, DotMatchesScalar) {
+    for (size_t size : {0, 1, 3, 7, 8, 15, 16, 33, 64, 100, 784}) {
+        const auto lhs = randomVector(size, 1.0, 1);
+        const auto rhs = randomVector(size, 3.0, 2);
+
+        double magnitude = 0.0;
+        const double expected = scalarDot(lhs, rhs, &magnitude);
+
+        EXPECT_NEAR(kernels::dot(lhs.data(), rhs.data(), size), expected,
+                    kernels::kDotTolerance * magnitude) << "size " << size;
+    }
+}
+
+TEST_P(KernelsTest, GemmMatchesDot) {
+    // Odd sizes on purpose: partial sample blocks and vector tails
+    constexpr size_t count = 7;
+    constexpr size_t rows = 5;
+    constexpr size_t depth = 37;
+
+    const auto inputs = randomVector(count * depth, 1.0, 5);
+    const auto weights = randomVector(rows * depth, 2.0, 6);
+    std::vector<double> output(count * rows);
+
+    kernels::gemm(inputs.data(), count, weights.data(), rows, depth,
+                  output.data());
+
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < rows; ++j) {
+            const std::vector<double> input(inputs.begin() + i * depth,
+                inputs.begin() + (i + 1) * depth);
+            const std::vector<double> row(weights.begin() + j * depth,
+                weights.begin() + (j + 1) * depth);
+
+            double magnitude = 0.0;
+            const double expected = scalarDot(input, row, &magnitude);
+            EXPECT_NEAR(output[i * rows + j], expected,
+                        kernels::kDotTolerance * magnitude);
+        }
+    }
+}
+
+TEST_P(KernelsTest, GemvTransposedMatchesColumnDot) {
+    // A block of four rows plus a tail row, and a vector tail
+    constexpr size_t rows = 5;
+    constexpr size_t depth = 37;
+
+    const auto vector = randomVector(rows, 1.0, 7);
+    const auto weights = randomVector(rows * depth, 2.0, 8);
+    std::vector<double> output(depth, double(-1));
+
+    kernels::gemvTransposed(vector.data(), weights.data(), rows, depth,
+                            output.data());
+
+    for (size_t i = 0; i < depth; ++i) {
+        std::vector<double> column;
+        for (size_t j = 0; j < rows; ++j) {
+            column.push_back(weights[j * depth + i]);
+        }
+
+        double magnitude = 0.0;
+        const double expected = scalarDot(
+            std::vector<double>(vector.begin(), vector.end()), column,
+            &magnitude);
+        EXPECT_NEAR(output[i], expected, kernels::kDotTolerance * magnitude);
+    }
+}
+
+TEST_P(KernelsTest, SigmoidMatchesNeuron) {
+    auto values = randomVector(1001, 40.0, 3);
+    values.insert(values.end(), {0.0, -0.0, 1e-300, -750.0, 750.0,
+                                 -708.5, 709.5, 36.0, -36.0});
+    auto result = values;
+
+    kernels::sigmoid(result.data(), result.size());
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_NEAR(result[i],
+            Neuron::activate(Neuron::ActivationFunction::SIGMOID, values[i]),
+            kernels::kActivationTolerance) << "value " << values[i];
+    }
+}
+
+TEST_P(KernelsTest, ReluMatchesNeuron) {
+    auto values = randomVector(1001, 10.0, 4);
+    values.insert(values.end(), {0.0, -0.0, 1e-300, -1e-300});
+    auto result = values;
+
+    kernels::activate(Neuron::ActivationFunction::RELU,
+                      result.data(), result.size());
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(result[i],
+            Neuron::activate(Neuron::ActivationFunction::RELU, values[i]));
+    }
+}
+
+TEST_P(KernelsTest, FloatDotMatchesDouble) {
+    for (size_t size : {0, 1, 3, 7, 8, 15, 16, 33, 64, 100, 784}) {
+        const auto lhs = toFloat(randomVector(size, 1.0, 1));
+        const auto rhs = toFloat(randomVector(size, 3.0, 2));
+
+        double magnitude = 0.0;
+        const double expected = scalarDot(
+            std::vector<double>(lhs.begin(), lhs.end()),
+            std::vector<double>(rhs.begin(), rhs.end()), &magnitude);
+
+        EXPECT_NEAR(kernels::dot(lhs.data(), rhs.data(), size), expected,
+                    kernels::kFloatDotTolerance * magnitude)
+            << "size " << size;
+    }
+}
+
+TEST_P(KernelsTest, FloatGemmMatchesDot) {
+    constexpr size_t count = 7;
+    constexpr size_t rows = 5;
+    constexpr size_t depth = 37;
+
+    const auto inputs = toFloat(randomVector(count * depth, 1.0, 5));
+    const auto weights = toFloat(randomVector(rows * depth, 2.0, 6));
+    std::vector<float> output(count * rows);
+
+    kernels::gemm(inputs.data(), count, weights.data(), rows, depth,
+                  output.data());
+
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < rows; ++j) {
+            const std::vector<double> input(inputs.begin() + i * depth,
+                inputs.begin() + (i + 1) * depth);
+            const std::vector<double> row(weights.begin() + j * depth,
+                weights.begin() + (j + 1) * depth);
+
+            double magnitude = 0.0;
+            const double expected = scalarDot(input, row, &magnitude);
+            EXPECT_NEAR(output[i * rows + j], expected,
+                        kernels::kFloatDotTolerance * magnitude);
+        }
+    }
+}
+
+TEST_P(KernelsTest, FloatGemvTransposedMatchesColumnDot) {
+    // A block of four rows plus a tail row, and a vector tail
+    constexpr size_t rows = 5;
+    constexpr size_t depth = 37;
+
+    const auto vector = toFloat(randomVector(rows, 1.0, 7));
+    const auto weights = toFloat(randomVector(rows * depth, 2.0, 8));
+    std::vector<float> output(depth, float(-1));
+
+    kernels::gemvTransposed(vector.data(), weights.data(), rows, depth,
+                            output.data());
+
+    for (size_t i = 0; i < depth; ++i) {
+        std::vector<double> column;
+        for (size_t j = 0; j < rows; ++j) {
+            column.push_back(weights[j * depth + i]);
+        }
+
+        double magnitude = 0.0;
+        const double expected = scalarDot(
+            std::vector<double>(vector.begin(), vector.end()), column,
+            &magnitude);
+        EXPECT_NEAR(output[i], expected,
+                    kernels::kFloatDotTolerance * magnitude);
+    }
+}
+
+TEST_P(KernelsTest, FloatSigmoidMatchesNeuron) {
+    auto values = toFloat(randomVector(1001, 40.0, 3));
+    values.insert(values.end(), {0.0f, -0.0f, 1e-30f, -100.0f, 100.0f,
+                                 -87.5f, 88.5f, 17.0f, -17.0f});
+    auto result = values;
+
+    kernels::sigmoid(result.data(), result.size());
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_NEAR(result[i],
+            Neuron::activate(Neuron::ActivationFunction::SIGMOID, values[i]),
+            kernels::kFloatActivationTolerance) << "value " << values[i];
+    }
+}
+
+TEST_P(KernelsTest, FloatReluMatchesNeuron) {
+    auto values = toFloat(randomVector(1001, 10.0, 4));
+    values.insert(values.end(), {0.0f, -0.0f, 1e-30f, -1e-30f});
+    auto result = values;
+
+    kernels::activate(Neuron::ActivationFunction::RELU,
+                      result.data(), result.size());
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(result[i], static_cast<float>(
+            Neuron::activate(Neuron::ActivationFunction::RELU, values[i])));
+    }
+}
+
+TEST_P(KernelsTest, IntegerDotIsExact) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    for (size_t size : {0, 1, 3, 15, 16, 31, 33, 64, 100, 127, 784}) {
+        // Extreme values first: all 255 * -128 must not saturate
+        std::vector<uint8_t> lhs(size, 255);
+        std::vector<int8_t> rhs(size, -128);
+        for (size_t i = size / 2; i < size; ++i) {
+            lhs[i] = static_cast<uint8_t>(dist(gen));
+            rhs[i] = static_cast<int8_t>(dist(gen) - 128);
+        }
+
+        int32_t expected = 0;
+        for (size_t i = 0; i < size; ++i) {
+            expected += static_cast<int32_t>(lhs[i]) * rhs[i];
+        }
+
+        EXPECT_EQ(kernels::dot(lhs.data(), rhs.data(), size), expected)
+            << "size " << size;
+    }
+}
+
+TEST_P(KernelsTest, IntegerGemvMatchesDot) {
+    constexpr size_t rows = 7;
+    constexpr size_t depth = 133;
+
+    std::mt19937 gen(8);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<uint8_t> input(depth);
+    std::vector<int8_t> weights(rows * depth);
+    for (auto& value : input) {
+        value = static_cast<uint8_t>(dist(gen));
+    }
+    for (auto& value : weights) {
+        value = static_cast<int8_t>(dist(gen) - 128);
+    }
+
+    std::vector<int32_t> output(rows);
+    kernels::gemv(input.data(), weights.data(), rows, depth, output.data());
+    for (size_t j = 0; j < rows; ++j) {
+        EXPECT_EQ(output[j], kernels::dot(input.data(),
+                                          weights.data() + j * depth, depth))
+            << "row " << j;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, KernelsTest,
+    ::testing::ValuesIn(kAllIsas),
+    [](const ::testing::TestParamInfo<kernels::Isa>& aInfo) {
+        std::string name = kernels::isaName(aInfo.param);
+        name.erase(std::remove_if(name.begin(), name.end(),
+                                  [](char aChar) {
+                                      return aChar == '-' || aChar == ' ';
+                                  }),
+                   name.end());
+        return name;
+    });
@@ -0,0 +1,121 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "include/kernels.hpp"
+#include "include/layer.hpp"
+#include "include/neuron.hpp"
+
+
+TEST(LayerTest, Inititalization) {
+    constexpr size_t inputs = 3;
+    constexpr size_t neurons = 2;
+    constexpr double expected = 0.0;
+
+    Layer layer(inputs, neurons, Neuron::ActivationFunction::SIGMOID);
+
+    EXPECT_EQ(layer.size(), neurons);
+    EXPECT_EQ(layer.inputs(), inputs);
+    EXPECT_EQ(layer.cweights().size(), inputs * neurons);
+    EXPECT_EQ(layer.cbiases().size(), neurons);
+    for (const auto& neuron : layer) {
+        EXPECT_EQ(neuron.cweights().size(), inputs);
+        EXPECT_DOUBLE_EQ(neuron.bias(), expected);
+        for (const double weight : neuron.cweights()) {
+            EXPECT_DOUBLE_EQ(weight, expected);
+        }
+    }
+}
+
+TEST(LayerTest, RowMajorLayout) {
+    constexpr size_t inputs = 3;
+    constexpr size_t neurons = 2;
+
+    Layer layer(inputs, neurons, Neuron::ActivationFunction::RELU);
+    for (size_t i = 0; i < layer.weights().size(); ++i) {
+        layer.weights()[i] = static_cast<double>(i);
+    }
+
+    for (size_t j = 0; j < neurons; ++j) {
+        EXPECT_EQ(layer.row(j), layer.cweights().data() + j * inputs);
+        for (size_t i = 0; i < inputs; ++i) {
+            EXPECT_DOUBLE_EQ(layer[j].weight(i),
+                             static_cast<double>(j * inputs + i));
+        }
+    }
+
+    // Out of range weight index behaves like Neuron::weight()
+    EXPECT_DOUBLE_EQ(layer[0].weight(inputs), 0.0);
+}
+
+TEST(LayerTest, ForwardMatchesNeuron) {
+    constexpr int inputs = 4;
+    const std::vector<double> input = {0.5, -1.0, 0.25, 2.0};
+
+    for (auto function : {Neuron::ActivationFunction::SIGMOID,
+                          Neuron::ActivationFunction::RELU}) {
+        Layer layer(inputs, 3, function);
+        std::vector<Neuron> neurons(layer.size(), Neuron(inputs, function));
+
+        for (size_t j = 0; j < layer.size(); ++j) {
+            for (size_t i = 0; i < inputs; ++i) {
+                const double value = 0.1 * static_cast<double>(j + 1) -
+                    0.05 * static_cast<double>(i);
+                layer.row(j)[i] = value;
+                neurons[j].setWeight(i, value);
+            }
+            layer.biases()[j] = 0.3 - 0.2 * static_cast<double>(j);
+            neurons[j].setBias(layer.cbiases()[j]);
+        }
+
+        std::vector<double> output(layer.size());
+        layer.forward(input.data(), output.data());
+
+        for (size_t j = 0; j < layer.size(); ++j) {
+            EXPECT_NEAR(output[j], neurons[j].output(input),
+                        kernels::kActivationTolerance);
+        }
+    }
+}
+
+TEST(LayerTest, BackwardMatchesDerivatives) {
+    constexpr size_t inputs = 3;
+    const std::vector<double> input = {0.5, -1.0, 2.0};
+    const std::vector<double> errors = {0.4, -0.3, 0.2, 0.1};
+
+    for (auto function : {Neuron::ActivationFunction::SIGMOID,
+                          Neuron::ActivationFunction::RELU}) {
+        Layer layer(inputs, errors.size(), function);
+        for (size_t i = 0; i < layer.weights().size(); ++i) {
+            layer.weights()[i] = 0.3 - 0.1 * static_cast<double>(i);
+        }
+
+        std::vector<double> output(layer.size());
+        layer.forward(input.data(), output.data());
+        std::vector<double> deltas = errors;
+        layer.deltas(output.data(), deltas.data());
+
+        for (size_t j = 0; j < layer.size(); ++j) {
+            double sum = 0.0;
+            for (size_t i = 0; i < inputs; ++i) {
+                sum += layer.row(j)[i] * input[i];
+            }
+            EXPECT_NEAR(deltas[j],
+                        errors[j] * Neuron::activateDerivative(function, sum),
+                        1e-12);
+        }
+
+        std::vector<double> inputErrors(inputs);
+        layer.inputErrors(deltas.data(), inputErrors.data());
+
+        for (size_t i = 0; i < inputs; ++i) {
+            double expected = 0.0;
+            for (size_t j = 0; j < layer.size(); ++j) {
+                expected += deltas[j] * layer.row(j)[i];
+            }
+            EXPECT_NEAR(inputErrors[i], expected, 1e-12);
+        }
+    }
+}
@@ -1,11 +1,15 @@
 // Copyright (c) 2025 Vitalii Shkibtan./ All rights reserved.
 
 #include <gtest/gtest.h>
+#include <sys/stat.h>
 
 #include <algorithm>
 #include <cstdio>
 #include <fstream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 #include <utility>
 
@@ -156,6 +160,109 @@ class MnistCsvDataSetWrongLabelFixture : public MnistCsvDataSetFixtureBase {
     }
 };
 
+// Fixture for an error after a few valid lines
+class MnistCsvDataSetErrorLineFixture : public MnistCsvDataSetFixtureBase {
+ protected:
+    static void SetUpTestSuite() {
+        std::string invalidLine = generateCsvLine(kTestLabelValue,
+            kTestPixelValue, kDefaultDelimiter, kImageSize - 1);
+        invalidLine += kDefaultDelimiter;
+        invalidLine += "300";
+
+        csvPath = createTempCsvFile({
+            generateCsvLine(kTestLabelValue, kTestPixelValue,
+                            kDefaultDelimiter, kImageSize),
+            generateCsvLine(kTestLabelValue, kTestPixelValue,
+                            kDefaultDelimiter, kImageSize),
+            invalidLine
+        });
+    }
+};
+
+// Fixture for Windows line endings
+class MnistCsvDataSetCrLfFixture : public MnistCsvDataSetFixtureBase {
+ protected:
+    static void SetUpTestSuite() {
+        const std::string line = generateCsvLine(kTestLabelValue,
+            kTestPixelValue, kDefaultDelimiter, kImageSize) + "\r";
+        csvPath = createTempCsvFile({line, line});
+    }
+};
+
+// Fixture for a non-numeric pixel
+class MnistCsvDataSetNotNumberFixture : public MnistCsvDataSetFixtureBase {
+ protected:
+    static void SetUpTestSuite() {
+        std::string line = generateCsvLine(kTestLabelValue,
+            kTestPixelValue, kDefaultDelimiter, kImageSize - 1);
+        line += kDefaultDelimiter;
+        line += "abc";
+        csvPath = createTempCsvFile({line});
+    }
+};
+
+// Fixture for fields std::stoi accepts although they are not plain digits
+class MnistCsvDataSetLenientFixture : public MnistCsvDataSetFixtureBase {
+ protected:
+    static void SetUpTestSuite() {
+        std::string line = "+5";
+        for (size_t i = 0; i < kImageSize; ++i) {
+            line += kDefaultDelimiter;
+            line += i == 0 ? " 150" : i == 1 ? "150abc" : i == 2 ? "-0"
+                                               : "150";
+        }
+        csvPath = createTempCsvFile({line});
+    }
+};
+
+// Fixture for a file large enough to be split between workers
+class MnistCsvDataSetLargeFixture : public MnistCsvDataSetFixtureBase {
+ public:
+    static constexpr std::size_t kLines = 2000;
+
+    static std::vector<std::string> generateLines() {
+        std::vector<std::string> lines;
+        for (std::size_t i = 0; i < kLines; ++i) {
+            lines.push_back(generateCsvLine(
+                static_cast<MnistCsvDataSet::Label_t>(i % 10),
+                static_cast<MnistCsvDataSet::Pixel_t>(i % 256),
+                kDefaultDelimiter, kImageSize));
+        }
+        return lines;
+    }
+
+ protected:
+    static void SetUpTestSuite() {
+        csvPath = createTempCsvFile(generateLines());
+    }
+};
+
+// Fixture for errors in several parts of a large file
+class MnistCsvDataSetLargeErrorFixture : public MnistCsvDataSetLargeFixture {
+ protected:
+    static void SetUpTestSuite() {
+        auto lines = generateLines();
+        lines[1500] = generateCsvLine(10, kTestPixelValue,
+                                      kDefaultDelimiter, kImageSize);
+        lines[1900] = generateCsvLine(kTestLabelValue, kTestPixelValue,
+                                      kDefaultDelimiter, kImageSize - 1);
+        csvPath = createTempCsvFile(lines);
+    }
+};
+
+// Fixture for loads through the binary cache
+class MnistCsvDataSetCacheFixture : public MnistCsvDataSetLargeFixture {
+ protected:
+    void SetUp() override {
+        csvPath = createTempCsvFile(generateLines());
+        std::remove(MnistCsvDataSet::cachePath(csvPath).c_str());
+    }
+
+    void TearDown() override {
+        std::remove(MnistCsvDataSet::cachePath(csvPath).c_str());
+    }
+};
+
 TEST_F(MnistCsvDataSetValidFixture, ValidCsv_IsOpen) {
     const auto dataset = getDataset();
 
@@ -233,3 +340,174 @@ TEST_F(MnistCsvDataSetWrongLabelFixture,
 
     ASSERT_FALSE(dataset.isLoaded());
 }
+
+TEST_F(MnistCsvDataSetValidFixture, ValidCsv_NoError) {
+    const auto dataset = getDataset();
+
+    EXPECT_TRUE(dataset.lastError().empty());
+}
+
+TEST_F(MnistCsvDataSetErrorLineFixture,
+       InvalidCsv_ReportsLineNumber) {
+    const auto dataset = getDataset();
+
+    ASSERT_FALSE(dataset.isLoaded());
+    // The header is line 1
+    EXPECT_EQ(dataset.lastError(), "Line 4: Pixel out of range: 300");
+}
+
+TEST_F(MnistCsvDataSetTooFewPixelsFixture,
+       InvalidCsv_TooFewPixels_Error) {
+    const auto dataset = getDataset();
+
+    EXPECT_EQ(dataset.lastError(),
+              "Line 2: Invalid pixel count: expected 784, got 783");
+}
+
+TEST_F(MnistCsvDataSetWrongLabelFixture,
+       InvalidCsv_WrongLabelValue_Error) {
+    const auto dataset = getDataset();
+
+    EXPECT_EQ(dataset.lastError(), "Line 2: Invalid label value: 10");
+}
+
+TEST_F(MnistCsvDataSetNotNumberFixture,
+       InvalidCsv_NotNumber_ShouldFail) {
+    const auto dataset = getDataset();
+
+    ASSERT_FALSE(dataset.isLoaded());
+    EXPECT_EQ(dataset.lastError(), "Line 2: Invalid number: 'abc'");
+}
+
+TEST_F(MnistCsvDataSetCrLfFixture, ValidCsv_CrLf) {
+    const auto dataset = getDataset();
+
+    ASSERT_TRUE(dataset.isLoaded());
+    ASSERT_EQ(dataset.size(), 2u);
+    EXPECT_EQ(dataset.at(1).first, kTestLabelValue);
+    EXPECT_EQ(dataset.at(1).second.back(), kTestPixelValue);
+}
+
+TEST_F(MnistCsvDataSetLenientFixture, ValidCsv_SignsAndTrailingText) {
+    const auto dataset = getDataset();
+
+    ASSERT_TRUE(dataset.isLoaded()) << dataset.lastError();
+    ASSERT_EQ(dataset.size(), 1u);
+    EXPECT_EQ(dataset[0].first, kTestLabelValue);
+    EXPECT_EQ(dataset[0].second[0], kTestPixelValue);
+    EXPECT_EQ(dataset[0].second[1], kTestPixelValue);
+    EXPECT_EQ(dataset[0].second[2], 0);
+    EXPECT_EQ(dataset[0].second[3], kTestPixelValue);
+}
+
+TEST_F(MnistCsvDataSetLargeFixture, FifoIsReadWithoutMapping) {
+    constexpr char kFifoName[] = "temp_mnist_dataset.fifo";
+    std::remove(kFifoName);
+    ASSERT_EQ(::mkfifo(kFifoName, 0600), 0);
+
+    // Opening a FIFO blocks until the other end is opened too
+    std::thread writer([&]() {
+        std::ifstream input(csvPath, std::ios::binary);
+        std::ofstream output(kFifoName, std::ios::binary);
+        output << input.rdbuf();
+    });
+    const MnistCsvDataSet piped(kFifoName, 4, true);
+    writer.join();
+    std::remove(kFifoName);
+
+    const MnistCsvDataSet mapped(csvPath);
+    ASSERT_TRUE(piped.isLoaded()) << piped.lastError();
+    EXPECT_FALSE(piped.isCached());
+    ASSERT_EQ(piped.size(), kLines);
+    for (std::size_t i = 0; i < kLines; ++i) {
+        EXPECT_EQ(piped[i], mapped[i]);
+    }
+    EXPECT_FALSE(std::ifstream(
+        MnistCsvDataSet::cachePath(kFifoName)).good());
+}
+
+TEST(MnistCsvDataSetTest, MissingFile) {
+    const MnistCsvDataSet dataset("missing_mnist_dataset.csv");
+
+    ASSERT_FALSE(dataset.isLoaded());
+    EXPECT_FALSE(dataset.lastError().empty());
+}
+
+TEST_F(MnistCsvDataSetLargeFixture, ParallelLoadMatchesSequential) {
+    const MnistCsvDataSet sequential(csvPath);
+    const MnistCsvDataSet parallel(csvPath, 4);
+
+    ASSERT_TRUE(sequential.isLoaded());
+    ASSERT_TRUE(parallel.isLoaded());
+    ASSERT_EQ(sequential.size(), kLines);
+    ASSERT_EQ(parallel.size(), kLines);
+
+    for (std::size_t i = 0; i < kLines; ++i) {
+        EXPECT_EQ(parallel[i].first, i % 10);
+        EXPECT_EQ(parallel[i].second.front(), i % 256);
+        EXPECT_EQ(parallel[i], sequential[i]);
+    }
+}
+
+TEST_F(MnistCsvDataSetLargeErrorFixture, ParallelLoadReportsFirstError) {
+    for (std::size_t threads : {1, 3, 4, 0}) {
+        const MnistCsvDataSet dataset(csvPath, threads);
+
+        ASSERT_FALSE(dataset.isLoaded());
+        // Entry 1500 is on line 1502 after the header
+        EXPECT_EQ(dataset.lastError(), "Line 1502: Invalid label value: 10");
+    }
+}
+
+TEST_F(MnistCsvDataSetCacheFixture, CacheIsCreatedAndReused) {
+    const MnistCsvDataSet parsed(csvPath, 1, true);
+
+    ASSERT_TRUE(parsed.isLoaded());
+    EXPECT_FALSE(parsed.isCached());
+    ASSERT_TRUE(std::ifstream(MnistCsvDataSet::cachePath(csvPath)).good());
+
+    const MnistCsvDataSet cached(csvPath, 1, true);
+
+    ASSERT_TRUE(cached.isLoaded());
+    EXPECT_TRUE(cached.isCached());
+    ASSERT_EQ(cached.size(), kLines);
+    for (std::size_t i = 0; i < kLines; ++i) {
+        EXPECT_EQ(cached[i], parsed[i]);
+    }
+    EXPECT_THROW(cached.at(kLines), std::out_of_range);
+}
+
+TEST_F(MnistCsvDataSetCacheFixture, ChangedCsvInvalidatesCache) {
+    const MnistCsvDataSet first(csvPath, 1, true);
+    ASSERT_TRUE(first.isLoaded());
+
+    auto lines = generateLines();
+    lines.resize(kLines / 2);
+    createTempCsvFile(lines);
+
+    const MnistCsvDataSet changed(csvPath, 1, true);
+
+    ASSERT_TRUE(changed.isLoaded());
+    EXPECT_FALSE(changed.isCached());
+    EXPECT_EQ(changed.size(), kLines / 2);
+
+    const MnistCsvDataSet cached(csvPath, 1, true);
+
+    EXPECT_TRUE(cached.isCached());
+    EXPECT_EQ(cached.size(), kLines / 2);
+}
+
+TEST_F(MnistCsvDataSetCacheFixture, CacheIsNotUsedByDefault) {
+    const MnistCsvDataSet parsed(csvPath, 1, true);
+    const MnistCsvDataSet plain(csvPath);
+
+    ASSERT_TRUE(plain.isLoaded());
+    EXPECT_FALSE(plain.isCached());
+}
+
+TEST_F(MnistCsvDataSetLargeErrorFixture, InvalidCsvIsNotCached) {
+    const MnistCsvDataSet dataset(csvPath, 1, true);
+
+    ASSERT_FALSE(dataset.isLoaded());
+    EXPECT_FALSE(std::ifstream(MnistCsvDataSet::cachePath(csvPath)).good());
+}
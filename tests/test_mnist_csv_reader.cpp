@@ -0,0 +1,136 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "include/mnistcsvdataset.hpp"
+#include "include/mnistcsvreader.hpp"
+
+class MnistCsvReaderTest : public ::testing::Test {
+ public:
+    static constexpr char kTestFileName[] = "temp_mnist_csv_reader.csv";
+    static constexpr size_t kImageSize = MnistCsvDataSet::kMnistImageSize;
+
+ protected:
+    void TearDown() override {
+        std::remove(kTestFileName);
+    }
+
+    static unsigned pixel(size_t aEntry, size_t aIndex) {
+        return (aEntry * 13 + aIndex * 5) % 256;
+    }
+
+    // A header and aCount entries, several read buffers long for large
+    // counts
+    static std::string makeCsv(size_t aCount) {
+        std::ostringstream csv;
+        csv << "label,pixels\r\n";
+        for (size_t i = 0; i < aCount; ++i) {
+            csv << i % 10;
+            for (size_t j = 0; j < kImageSize; ++j) {
+                csv << ',' << pixel(i, j);
+            }
+            csv << "\r\n";
+        }
+        return csv.str();
+    }
+
+    static void writeFile(const std::string& aContent) {
+        std::ofstream out(kTestFileName, std::ios::binary);
+        out << aContent;
+    }
+};
+
+TEST_F(MnistCsvReaderTest, BatchesMatchDataSet) {
+    constexpr size_t kEntries = 2000;
+    writeFile(makeCsv(kEntries));
+    const MnistCsvDataSet dataset(kTestFileName);
+    ASSERT_TRUE(dataset.isLoaded());
+
+    MnistCsvReader reader(kTestFileName);
+    ASSERT_TRUE(reader.isOpen());
+
+    MnistCsvReader::Entries batch;
+    size_t total = 0;
+    while (const size_t count = reader.read(batch, 64)) {
+        ASSERT_EQ(batch.size(), count);
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(batch[i], dataset[total + i]);
+        }
+        total += count;
+    }
+
+    EXPECT_EQ(total, kEntries);
+    EXPECT_FALSE(reader.failed());
+    EXPECT_EQ(reader.read(batch, 64), 0u);
+    EXPECT_TRUE(batch.empty());
+}
+
+TEST_F(MnistCsvReaderTest, LastLineWithoutNewline) {
+    std::string csv = makeCsv(3);
+    csv.resize(csv.size() - 2);
+    std::istringstream input(csv);
+
+    MnistCsvReader reader(input);
+    MnistCsvReader::Entries batch;
+    ASSERT_EQ(reader.read(batch, 10), 3u);
+    EXPECT_EQ(batch[2].first, 2);
+    EXPECT_EQ(batch[2].second[kImageSize - 1], pixel(2, kImageSize - 1));
+}
+
+TEST_F(MnistCsvReaderTest, BadLineEndsInputAfterEntriesBeforeIt) {
+    std::string csv = makeCsv(5);
+    csv += "3,1,2\n";
+    std::istringstream input(csv + makeCsv(2));
+
+    MnistCsvReader reader(input);
+    MnistCsvReader::Entries batch;
+    EXPECT_EQ(reader.read(batch, 4), 4u);
+    EXPECT_FALSE(reader.failed());
+    EXPECT_EQ(reader.read(batch, 4), 1u);
+    EXPECT_TRUE(reader.failed());
+    // The header is line 1
+    EXPECT_EQ(reader.lastError(),
+              "Line 7: Invalid pixel count: expected 784, got 2");
+    EXPECT_EQ(reader.read(batch, 4), 0u);
+}
+
+TEST_F(MnistCsvReaderTest, RewindStartsOver) {
+    writeFile(makeCsv(10));
+    MnistCsvReader reader(kTestFileName);
+
+    MnistCsvReader::Entries first;
+    MnistCsvReader::Entries second;
+    ASSERT_EQ(reader.read(first, 100), 10u);
+    ASSERT_EQ(reader.read(second, 100), 0u);
+
+    ASSERT_TRUE(reader.rewind());
+    ASSERT_EQ(reader.read(second, 100), 10u);
+    EXPECT_EQ(first, second);
+}
+
+TEST_F(MnistCsvReaderTest, EmptyInput) {
+    for (const std::string csv : {"", "label,pixels\n"}) {
+        std::istringstream input(csv);
+        MnistCsvReader reader(input);
+        MnistCsvReader::Entries batch;
+        EXPECT_TRUE(reader.isOpen());
+        EXPECT_EQ(reader.read(batch, 8), 0u);
+        EXPECT_FALSE(reader.failed());
+    }
+}
+
+TEST_F(MnistCsvReaderTest, MissingFile) {
+    MnistCsvReader reader("nonexistent_mnist_reader.csv");
+    MnistCsvReader::Entries batch;
+    EXPECT_FALSE(reader.isOpen());
+    EXPECT_TRUE(reader.failed());
+    EXPECT_EQ(reader.lastError(),
+              "Unable to open file nonexistent_mnist_reader.csv");
+    EXPECT_EQ(reader.read(batch, 8), 0u);
+    EXPECT_FALSE(reader.rewind());
+}
@@ -0,0 +1,138 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "include/mnistimage.hpp"
+
+namespace {
+using Image = MnistCsvDataSet::Image_t;
+constexpr size_t kSide = mnistimage::kSide;
+
+// A white drawing of aScale * kSide pixels square, aPadding bytes of
+// garbage after every row
+struct Drawing {
+    Drawing(size_t aScale, size_t aPadding)
+        : side(aScale * kSide)
+        , stride(side + aPadding)
+        , pixels(stride * side, 255) {
+        for (size_t y = 0; y < side; ++y) {
+            for (size_t x = side; x < stride; ++x) {
+                pixels[y * stride + x] = 0;
+            }
+        }
+    }
+
+    void fill(size_t aX, size_t aY, size_t aWidth, size_t aHeight,
+              uint8_t aValue) {
+        for (size_t y = aY; y < aY + aHeight; ++y) {
+            for (size_t x = aX; x < aX + aWidth; ++x) {
+                pixels[y * stride + x] = aValue;
+            }
+        }
+    }
+
+    bool downsample(Image& aImage) const {  // NOLINT(runtime/references)
+        return mnistimage::downsample(pixels.data(), side, side, stride,
+                                      aImage);
+    }
+
+    size_t side;
+    size_t stride;
+    std::vector<uint8_t> pixels;
+};
+
+// Ink weighted mean of the column (aAxis 0) or row (aAxis 1) indices
+double centerOfMass(const Image& aImage, int aAxis) {
+    double mass = 0.0;
+    double moment = 0.0;
+    for (size_t y = 0; y < kSide; ++y) {
+        for (size_t x = 0; x < kSide; ++x) {
+            mass += aImage[y * kSide + x];
+            moment += aImage[y * kSide + x] * (aAxis == 0 ? x : y);
+        }
+    }
+    return moment / mass;
+}
+}  // namespace
+
+TEST(MnistImageTest, WhiteDrawingIsEmpty) {
+    Drawing drawing(10, 0);
+    Image image;
+    image.fill(7);
+
+    ASSERT_TRUE(drawing.downsample(image));
+    for (uint8_t pixel : image) {
+        EXPECT_EQ(pixel, 0);
+    }
+}
+
+TEST(MnistImageTest, AveragesBoxesIntoInk) {
+    Drawing drawing(10, 6);  // Padding bytes must not be read
+    drawing.fill(30, 20, 10, 10, 0);    // Box (3, 2) all black
+    drawing.fill(100, 50, 5, 10, 0);    // Half of box (10, 5) black
+    drawing.fill(270, 270, 10, 10, 55);  // Box (27, 27) gray
+
+    Image image;
+    ASSERT_TRUE(drawing.downsample(image));
+    EXPECT_EQ(image[2 * kSide + 3], 255);
+    EXPECT_EQ(image[5 * kSide + 10], 127);  // 255 - round(127.5)
+    EXPECT_EQ(image[27 * kSide + 27], 200);
+    EXPECT_EQ(image[0], 0);
+    EXPECT_EQ(image[27 * kSide + 26], 0);
+}
+
+TEST(MnistImageTest, BoxesFollowTheScale) {
+    Drawing drawing(1, 0);  // Already 28x28
+    drawing.fill(4, 9, 1, 1, 0);
+
+    Image image;
+    ASSERT_TRUE(drawing.downsample(image));
+    EXPECT_EQ(image[9 * kSide + 4], 255);
+    EXPECT_EQ(image[9 * kSide + 5], 0);
+}
+
+TEST(MnistImageTest, RejectsSizesOtherThanMultiplesOfTheSide) {
+    std::vector<uint8_t> pixels(300 * 300, 255);
+    Image image;
+    EXPECT_FALSE(mnistimage::downsample(pixels.data(), 300, 280, 300,
+                                        image));
+    EXPECT_FALSE(mnistimage::downsample(pixels.data(), 280, 280, 200,
+                                        image));
+    EXPECT_FALSE(mnistimage::downsample(nullptr, 280, 280, 280, image));
+}
+
+TEST(MnistImageTest, CentersByMass) {
+    Image image{};
+    // A 3x4 block in the top left corner
+    for (size_t y = 1; y < 5; ++y) {
+        for (size_t x = 2; x < 5; ++x) {
+            image[y * kSide + x] = 255;
+        }
+    }
+
+    mnistimage::centerByMass(image);
+    EXPECT_NEAR(centerOfMass(image, 0), (kSide - 1) / 2.0, 0.5);
+    EXPECT_NEAR(centerOfMass(image, 1), (kSide - 1) / 2.0, 0.5);
+
+    size_t inked = 0;
+    for (uint8_t pixel : image) {
+        inked += pixel == 255;
+    }
+    EXPECT_EQ(inked, 12u);  // Shifted, not resampled
+}
+
+TEST(MnistImageTest, CenteringKeepsCenteredAndEmptyImages) {
+    Image empty{};
+    mnistimage::centerByMass(empty);
+    EXPECT_EQ(empty, Image{});
+
+    Image centered{};
+    centered[13 * kSide + 13] = 100;
+    centered[14 * kSide + 14] = 100;
+    const Image before = centered;
+    mnistimage::centerByMass(centered);
+    EXPECT_EQ(centered, before);
+}
@@ -0,0 +1,186 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "include/mnistcsvdataset.hpp"
+#include "include/mnistcsvreader.hpp"
+#include "include/mnisttrainingdata.hpp"
+#include "include/perceptron.hpp"
+
+class MnistTrainingDataTest : public ::testing::Test {
+ public:
+    static constexpr char kTestFileName[] = "temp_mnist_training_data.csv";
+    static constexpr size_t kEntries = 40;
+    static constexpr size_t kImageSize = MnistCsvDataSet::kMnistImageSize;
+
+ protected:
+    void SetUp() override {
+        std::ofstream out(kTestFileName);
+        out << "label,pixels\n";
+        for (size_t i = 0; i < kEntries; ++i) {
+            out << i % MnistTrainingData::kNumClasses;
+            for (size_t j = 0; j < kImageSize; ++j) {
+                out << ',' << pixel(i, j);
+            }
+            out << '\n';
+        }
+    }
+
+    void TearDown() override {
+        std::remove(kTestFileName);
+    }
+
+    static unsigned pixel(size_t aEntry, size_t aIndex) {
+        return (aEntry * 31 + aIndex * 7) % 256;
+    }
+};
+
+TEST_F(MnistTrainingDataTest, SampleIsNormalizedOnTheFly) {
+    const MnistCsvDataSet dataset(kTestFileName);
+    ASSERT_TRUE(dataset.isLoaded());
+
+    const MnistTrainingData data(dataset);
+    ASSERT_EQ(data.size(), kEntries);
+    ASSERT_EQ(data.inputSize(), kImageSize);
+    ASSERT_EQ(data.targetSize(), MnistTrainingData::kNumClasses);
+
+    std::vector<double> input(data.inputSize());
+    std::vector<double> target(data.targetSize());
+    const auto sample = data.sample(13, input.data(), target.data());
+
+    EXPECT_EQ(sample.input, input.data());
+    EXPECT_EQ(sample.target, target.data());
+    for (size_t j = 0; j < kImageSize; ++j) {
+        EXPECT_DOUBLE_EQ(input[j], pixel(13, j) / 255.0);
+    }
+    for (size_t k = 0; k < target.size(); ++k) {
+        EXPECT_EQ(target[k], k == 3 ? 1.0 : 0.0);
+    }
+}
+
+TEST_F(MnistTrainingDataTest, TrainingMatchesConvertedData) {
+    const MnistCsvDataSet dataset(kTestFileName);
+    ASSERT_TRUE(dataset.isLoaded());
+    const MnistTrainingData data(dataset);
+
+    // The data set converted up front, the way it used to be trained on
+    std::vector<std::vector<double>> inputs(kEntries,
+        std::vector<double>(kImageSize));
+    std::vector<std::vector<double>> targets(kEntries,
+        std::vector<double>(MnistTrainingData::kNumClasses));
+    for (size_t i = 0; i < kEntries; ++i) {
+        for (size_t j = 0; j < kImageSize; ++j) {
+            inputs[i][j] = dataset[i].second[j] / 255.0;
+        }
+        targets[i][dataset[i].first] = 1.0;
+    }
+
+    const std::vector<size_t> architecture = {kImageSize, 16, 10};
+    for (size_t batchSize : {1, 8}) {
+        TrainingOptions options;
+        options.epochs = 2;
+        options.learningRate = 0.1;
+        options.batchSize = batchSize;
+        options.threads = 2;
+
+        Perceptron converted(architecture,
+                             Neuron::ActivationFunction::SIGMOID, 11);
+        converted.train(inputs, targets, options);
+        Perceptron streamed(architecture,
+                            Neuron::ActivationFunction::SIGMOID, 11);
+        streamed.train(data, options);
+
+        ASSERT_TRUE(streamed.isTrained());
+        for (size_t i = 0; i < architecture.size() - 1; ++i) {
+            const auto& expected = converted.layers()[i];
+            const auto& actual = streamed.layers()[i];
+            for (size_t k = 0; k < expected.cweights().size(); ++k) {
+                ASSERT_EQ(actual.cweights()[k], expected.cweights()[k]);
+            }
+        }
+    }
+}
+
+TEST_F(MnistTrainingDataTest, StreamTrainingMatchesDataSet) {
+    const MnistCsvDataSet dataset(kTestFileName);
+    ASSERT_TRUE(dataset.isLoaded());
+
+    const std::vector<size_t> architecture = {kImageSize, 16, 10};
+    for (size_t batchSize : {1, 8}) {
+        TrainingOptions options;
+        options.epochs = 3;
+        options.learningRate = 0.1;
+        options.batchSize = batchSize;
+        options.threads = 2;
+
+        Perceptron loaded(architecture,
+                          Neuron::ActivationFunction::SIGMOID, 5);
+        loaded.train(MnistTrainingData(dataset), options);
+
+        MnistCsvReader reader(kTestFileName);
+        MnistTrainingStream stream(reader);
+        Perceptron streamed(architecture,
+                            Neuron::ActivationFunction::SIGMOID, 5);
+        streamed.train(stream, options);
+
+        ASSERT_TRUE(streamed.isTrained());
+        for (size_t i = 0; i < architecture.size() - 1; ++i) {
+            const auto& expected = loaded.layers()[i];
+            const auto& actual = streamed.layers()[i];
+            for (size_t k = 0; k < expected.cweights().size(); ++k) {
+                ASSERT_EQ(actual.cweights()[k], expected.cweights()[k]);
+            }
+        }
+    }
+}
+
+TEST_F(MnistTrainingDataTest, StreamProgressLearnsTheEpochSize) {
+    std::vector<TrainingProgress> epochs;
+    TrainingOptions options;
+    options.epochs = 2;
+    options.batchSize = 8;
+    options.onProgress = [&](const TrainingProgress& aProgress) {
+        if (aProgress.isEpochDone) {
+            epochs.push_back(aProgress);
+        }
+    };
+
+    MnistCsvReader reader(kTestFileName);
+    MnistTrainingStream stream(reader);
+    Perceptron network({kImageSize, 16, 10});
+    network.train(stream, options);
+
+    ASSERT_TRUE(network.isTrained());
+    ASSERT_EQ(epochs.size(), 2u);
+    EXPECT_EQ(epochs[0].samples, kEntries);
+    EXPECT_EQ(epochs[0].epochSamples, 0u);  // Not known while reading
+    EXPECT_EQ(epochs[1].samples, kEntries);
+    EXPECT_EQ(epochs[1].epochSamples, kEntries);
+}
+
+TEST_F(MnistTrainingDataTest, BadStreamIsNotTrained) {
+    std::ofstream(kTestFileName, std::ios::app) << "1,2,3\n";
+
+    MnistCsvReader reader(kTestFileName);
+    MnistTrainingStream stream(reader);
+    Perceptron network({kImageSize, 16, 10});
+    network.train(stream, TrainingOptions());
+
+    EXPECT_FALSE(network.isTrained());
+    EXPECT_TRUE(stream.failed());
+}
+
+TEST_F(MnistTrainingDataTest, WrongNetworkIsRejected) {
+    const MnistCsvDataSet dataset(kTestFileName);
+    const MnistTrainingData data(dataset);
+
+    Perceptron network({100, 16, 10});
+    network.train(data, TrainingOptions());
+
+    EXPECT_FALSE(network.isTrained());
+}
@@ -0,0 +1,232 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>  // NOLINT(build/c++17)
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "include/floatperceptron.hpp"
+#include "include/modelfile.hpp"
+#include "include/perceptron.hpp"
+
+class ModelFileTest : public ::testing::Test {
+ public:
+    static constexpr char kTestFileName[] = "temp_model.bin";
+
+ protected:
+    void TearDown() override {
+        std::remove(kTestFileName);
+    }
+
+    static std::vector<double> makeInput(size_t aSize) {
+        std::vector<double> input(aSize);
+        for (size_t i = 0; i < aSize; ++i) {
+            input[i] = static_cast<double>(i % 17) / 16.0;
+        }
+        return input;
+    }
+
+    // Flips one byte of the saved file at aOffset from the end
+    static void corrupt(std::streamoff aOffsetFromEnd) {
+        std::fstream file(kTestFileName,
+                          std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-aOffsetFromEnd, std::ios::end);
+        const char value = static_cast<char>(file.get());
+        file.seekp(-aOffsetFromEnd, std::ios::end);
+        file.put(static_cast<char>(value ^ 0x5a));
+    }
+};
+
+TEST_F(ModelFileTest, SaveAndLoad) {
+    Perceptron network({13, 7, 5, 3}, Neuron::ActivationFunction::RELU, 1);
+    ASSERT_TRUE(modelfile::save(kTestFileName, network));
+    EXPECT_TRUE(modelfile::isModelFile(kTestFileName));
+
+    Perceptron loaded;
+    ASSERT_TRUE(modelfile::load(kTestFileName, loaded));
+    ASSERT_EQ(loaded.layers().size(), network.layers().size());
+
+    for (size_t i = 0; i < network.layers().size(); ++i) {
+        const Layer& expected = network.layers()[i];
+        const Layer& actual = loaded.layers()[i];
+
+        EXPECT_FALSE(actual.ownsParameters());
+        EXPECT_EQ(actual.inputs(), expected.inputs());
+        EXPECT_EQ(actual.size(), expected.size());
+        EXPECT_EQ(actual.function(), expected.function());
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(actual.cweights().data()) %
+                  modelfile::kAlignment, 0u);
+
+        for (size_t k = 0; k < expected.cweights().size(); ++k) {
+            EXPECT_EQ(actual.cweights()[k], expected.cweights()[k]);
+        }
+        for (size_t j = 0; j < expected.size(); ++j) {
+            EXPECT_EQ(actual.cbiases()[j], expected.cbiases()[j]);
+        }
+    }
+
+    std::vector<double> expectedOutput;
+    std::vector<double> actualOutput;
+    ASSERT_TRUE(network.infer(makeInput(13), expectedOutput));
+    ASSERT_TRUE(loaded.infer(makeInput(13), actualOutput));
+    EXPECT_EQ(actualOutput, expectedOutput);
+}
+
+TEST_F(ModelFileTest, LoadedNetworkOutlivesChangesAndCopies) {
+    Perceptron network({6, 4, 2}, Neuron::ActivationFunction::SIGMOID, 2);
+    ASSERT_TRUE(modelfile::save(kTestFileName, network));
+
+    Perceptron copy;
+    {
+        Perceptron loaded;
+        ASSERT_TRUE(modelfile::load(kTestFileName, loaded));
+
+        // Private mapping: the change stays in memory
+        ASSERT_TRUE(loaded.setNeuronBias(0, 0, 42.0));
+        EXPECT_EQ(loaded.layers()[0].cbiases()[0], 42.0);
+
+        copy = loaded;
+    }
+
+    EXPECT_TRUE(copy.layers()[0].ownsParameters());
+    EXPECT_EQ(copy.layers()[0].cbiases()[0], 42.0);
+
+    Perceptron reloaded;
+    ASSERT_TRUE(modelfile::load(kTestFileName, reloaded));
+    EXPECT_EQ(reloaded.layers()[0].cbiases()[0],
+              network.layers()[0].cbiases()[0]);
+}
+
+TEST_F(ModelFileTest, ChecksumMismatch) {
+    Perceptron network({8, 4, 2}, Neuron::ActivationFunction::SIGMOID, 3);
+    ASSERT_TRUE(modelfile::save(kTestFileName, network));
+
+    // Last bias block of the output layer
+    corrupt(64);
+
+    Perceptron loaded;
+    EXPECT_FALSE(modelfile::load(kTestFileName, loaded));
+    EXPECT_FALSE(loaded.isConfigured());
+
+    // Unverified loads leave the damage to the caller
+    EXPECT_TRUE(modelfile::load(kTestFileName, loaded, false));
+}
+
+TEST_F(ModelFileTest, RejectsOtherFiles) {
+    {
+        std::ofstream file(kTestFileName);
+        file << "{\"architecture\": [784, 10], \"layers\": []}";
+    }
+
+    Perceptron loaded;
+    EXPECT_FALSE(modelfile::isModelFile(kTestFileName));
+    EXPECT_FALSE(modelfile::load(kTestFileName, loaded));
+    EXPECT_FALSE(modelfile::load("missing_model.bin", loaded));
+}
+
+TEST_F(ModelFileTest, TruncatedFile) {
+    Perceptron network({8, 4, 2}, Neuron::ActivationFunction::SIGMOID, 4);
+    ASSERT_TRUE(modelfile::save(kTestFileName, network));
+
+    std::filesystem::resize_file(kTestFileName,
+        std::filesystem::file_size(kTestFileName) - 64);
+
+    Perceptron loaded;
+    EXPECT_FALSE(modelfile::load(kTestFileName, loaded, false));
+}
+
+TEST_F(ModelFileTest, DoesNotOverwrite) {
+    Perceptron network({4, 2}, Neuron::ActivationFunction::SIGMOID, 5);
+    ASSERT_TRUE(modelfile::save(kTestFileName, network));
+    EXPECT_FALSE(modelfile::save(kTestFileName, network));
+}
+
+TEST_F(ModelFileTest, SaveAndLoadFloat) {
+    const Perceptron source({13, 7, 3}, Neuron::ActivationFunction::RELU, 4);
+    const FloatPerceptron network(source);
+    ASSERT_TRUE(modelfile::save(kTestFileName, network));
+
+    FloatPerceptron loaded;
+    ASSERT_TRUE(modelfile::load(kTestFileName, loaded));
+    ASSERT_EQ(loaded.layers().size(), network.layers().size());
+
+    for (size_t i = 0; i < network.layers().size(); ++i) {
+        const FloatLayer& expected = network.layers()[i];
+        const FloatLayer& actual = loaded.layers()[i];
+
+        EXPECT_FALSE(actual.ownsParameters());
+        for (size_t k = 0; k < expected.cweights().size(); ++k) {
+            EXPECT_EQ(actual.cweights()[k], expected.cweights()[k]);
+        }
+        for (size_t j = 0; j < expected.size(); ++j) {
+            EXPECT_EQ(actual.cbiases()[j], expected.cbiases()[j]);
+        }
+    }
+
+    // Half the size of the same model in double
+    const auto floatSize = std::filesystem::file_size(kTestFileName);
+    std::remove(kTestFileName);
+    ASSERT_TRUE(modelfile::save(kTestFileName, source));
+    EXPECT_LT(floatSize, std::filesystem::file_size(kTestFileName));
+}
+
+TEST_F(ModelFileTest, LoadConvertsPrecision) {
+    const Perceptron network({9, 5, 4}, Neuron::ActivationFunction::SIGMOID,
+                             6);
+    ASSERT_TRUE(modelfile::save(kTestFileName, network));
+
+    FloatPerceptron rounded;
+    ASSERT_TRUE(modelfile::load(kTestFileName, rounded));
+    ASSERT_EQ(rounded.layers().size(), network.layers().size());
+    for (size_t i = 0; i < network.layers().size(); ++i) {
+        const auto& expected = network.layers()[i].cweights();
+        const auto& actual = rounded.layers()[i].cweights();
+
+        EXPECT_TRUE(rounded.layers()[i].ownsParameters());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            EXPECT_EQ(actual[k], static_cast<float>(expected[k]));
+        }
+    }
+
+    std::remove(kTestFileName);
+    ASSERT_TRUE(modelfile::save(kTestFileName, rounded));
+
+    Perceptron widened;
+    ASSERT_TRUE(modelfile::load(kTestFileName, widened));
+    for (size_t i = 0; i < network.layers().size(); ++i) {
+        const auto& expected = rounded.layers()[i].cweights();
+        const auto& actual = widened.layers()[i].cweights();
+
+        EXPECT_TRUE(widened.layers()[i].ownsParameters());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            EXPECT_EQ(actual[k], static_cast<double>(expected[k]));
+        }
+    }
+}
+
+TEST_F(ModelFileTest, LoadsVersionOneFiles) {
+    const Perceptron network({6, 4, 2}, Neuron::ActivationFunction::RELU, 8);
+    ASSERT_TRUE(modelfile::save(kTestFileName, network));
+
+    // Version 1 header: no parameter size, doubles only
+    {
+        std::fstream file(kTestFileName,
+                          std::ios::in | std::ios::out | std::ios::binary);
+        const uint32_t version = 1;
+        const uint32_t scalarSize = 0;
+        file.seekp(8);
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        file.seekp(48);
+        file.write(reinterpret_cast<const char*>(&scalarSize),
+                   sizeof(scalarSize));
+    }
+
+    Perceptron loaded;
+    ASSERT_TRUE(modelfile::load(kTestFileName, loaded));
+    EXPECT_EQ(loaded.layers()[1].cweights()[3],
+              network.layers()[1].cweights()[3]);
+}
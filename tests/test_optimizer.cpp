@@ -0,0 +1,106 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "include/optimizer.hpp"
+
+namespace {
+TrainingOptions makeOptions(OptimizerType aType, double aLearningRate) {
+    TrainingOptions options;
+    options.optimizer = aType;
+    options.learningRate = aLearningRate;
+    return options;
+}
+
+// Applies aDirection to every weight and bias of aLayer as one batch
+void step(const Optimizer& aOptimizer, Layer* aLayer,
+          const std::vector<double>& aDirection) {
+    aOptimizer.beginStep(*aLayer);
+
+    Layer::OptimizerState& state = aLayer->optimizerState();
+    const Optimizer::Parameters weights{aLayer->weights().data(),
+        aDirection.data(), state.weights.data(), aLayer->weights().size()};
+    aOptimizer.update(weights, 0, weights.size, state.step);
+
+    const Optimizer::Parameters biases{aLayer->biases().data(),
+        aDirection.data(), state.biases.data(), aLayer->biases().size()};
+    aOptimizer.update(biases, 0, biases.size, state.step);
+}
+}  // namespace
+
+
+TEST(OptimizerTest, NamesRoundTrip) {
+    for (auto type : {OptimizerType::SGD, OptimizerType::MOMENTUM,
+                      OptimizerType::ADAM}) {
+        const auto parsed = optimizerFromName(optimizerName(type));
+        ASSERT_TRUE(parsed.has_value());
+        EXPECT_EQ(*parsed, type);
+    }
+
+    EXPECT_FALSE(optimizerFromName("rmsprop").has_value());
+}
+
+TEST(OptimizerTest, SgdKeepsNoState) {
+    const auto optimizer =
+        Optimizer::create(makeOptions(OptimizerType::SGD, 0.5));
+    Layer layer(2, 1, Layer::ActivationFunction::SIGMOID);
+
+    step(*optimizer, &layer, {1.0, -2.0});
+
+    EXPECT_DOUBLE_EQ(layer.cweights()[0], 0.5);
+    EXPECT_DOUBLE_EQ(layer.cweights()[1], -1.0);
+    EXPECT_DOUBLE_EQ(layer.cbiases()[0], 0.5);
+    EXPECT_TRUE(layer.optimizerState().weights.empty());
+    EXPECT_EQ(layer.optimizerState().step, 1u);
+}
+
+TEST(OptimizerTest, MomentumAccumulatesVelocity) {
+    TrainingOptions options = makeOptions(OptimizerType::MOMENTUM, 0.1);
+    options.momentum = 0.5;
+    const auto optimizer = Optimizer::create(options);
+    Layer layer(1, 1, Layer::ActivationFunction::SIGMOID);
+
+    step(*optimizer, &layer, {1.0});
+    EXPECT_DOUBLE_EQ(layer.cweights()[0], 0.1);
+
+    // Velocity 0.5 * 1 + 1 = 1.5
+    step(*optimizer, &layer, {1.0});
+    EXPECT_DOUBLE_EQ(layer.cweights()[0], 0.1 + 0.15);
+    EXPECT_DOUBLE_EQ(layer.optimizerState().weights[0], 1.5);
+}
+
+TEST(OptimizerTest, AdamFirstStepIsLearningRate) {
+    const auto optimizer =
+        Optimizer::create(makeOptions(OptimizerType::ADAM, 0.01));
+    Layer layer(3, 1, Layer::ActivationFunction::SIGMOID);
+
+    // Bias corrected moments make the first step lr * sign(direction)
+    step(*optimizer, &layer, {4.0, -0.001, 250.0});
+
+    EXPECT_NEAR(layer.cweights()[0], 0.01, 1e-9);
+    EXPECT_NEAR(layer.cweights()[1], -0.01, 1e-7);
+    EXPECT_NEAR(layer.cweights()[2], 0.01, 1e-9);
+    EXPECT_EQ(layer.optimizerState().weights.size(), 2u * 3u);
+    EXPECT_EQ(layer.optimizerState().biases.size(), 2u);
+}
+
+TEST(OptimizerTest, SwitchingMethodResetsState) {
+    Layer layer(2, 2, Layer::ActivationFunction::SIGMOID);
+    const std::vector<double> direction(4, 1.0);
+
+    const auto momentum =
+        Optimizer::create(makeOptions(OptimizerType::MOMENTUM, 0.1));
+    step(*momentum, &layer, direction);
+    step(*momentum, &layer, direction);
+    EXPECT_EQ(layer.optimizerState().slotCount, 1u);
+    EXPECT_EQ(layer.optimizerState().step, 2u);
+
+    const auto adam =
+        Optimizer::create(makeOptions(OptimizerType::ADAM, 0.1));
+    step(*adam, &layer, direction);
+    EXPECT_EQ(layer.optimizerState().slotCount, 2u);
+    EXPECT_EQ(layer.optimizerState().step, 1u);
+}
@@ -0,0 +1,412 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "include/optimizer.hpp"
+#include "include/perceptron.hpp"
+
+namespace {
+std::atomic<size_t> gAllocations{0};
+}  // namespace
+
+// Count every allocation of the test process (the library included)
+void* operator new(std::size_t aSize) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(aSize == 0 ? 1 : aSize)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* aMemory) noexcept {
+    std::free(aMemory);
+}
+
+void operator delete(void* aMemory, std::size_t) noexcept {
+    std::free(aMemory);
+}
+
+namespace {
+std::vector<double> makeInput(size_t aSize, size_t aSeed) {
+    std::vector<double> input(aSize);
+    for (size_t i = 0; i < aSize; ++i) {
+        input[i] = static_cast<double>((i * 7 + aSeed * 13) % 256) / 255.0;
+    }
+    return input;
+}
+}  // namespace
+
+
+TEST(PerceptronTest, ForwardBatchMatchesForward) {
+    const std::vector<size_t> architecture = {20, 16, 9, 10};
+    constexpr size_t count = 11;
+
+    for (auto function : {Neuron::ActivationFunction::SIGMOID,
+                          Neuron::ActivationFunction::RELU}) {
+        Perceptron network(architecture, function);
+        ASSERT_TRUE(network.isConfigured());
+
+        std::vector<double> batch;
+        for (size_t i = 0; i < count; ++i) {
+            const auto input = makeInput(architecture.front(), i);
+            batch.insert(batch.end(), input.begin(), input.end());
+        }
+
+        const auto outputs = network.forwardBatch(batch, count);
+        ASSERT_EQ(outputs.size(), count);
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto expected =
+                network.forward(makeInput(architecture.front(), i)).back();
+            ASSERT_EQ(outputs[i].size(), expected.size());
+            for (size_t j = 0; j < expected.size(); ++j) {
+                EXPECT_NEAR(outputs[i][j], expected[j], 1e-9);
+            }
+        }
+    }
+}
+
+TEST(PerceptronTest, ForwardBatchWrongSize) {
+    Perceptron network({4, 3, 2});
+
+    EXPECT_TRUE(network.forwardBatch(std::vector<double>(7), 2).empty());
+    EXPECT_TRUE(network.forwardBatch({}, 0).empty());
+}
+
+TEST(PerceptronTest, InferMatchesForward) {
+    Perceptron network({30, 12, 10});
+    const auto input = makeInput(network.inputSize(), 3);
+    const auto expected = network.forward(input).back();
+
+    std::vector<double> output;
+    ASSERT_TRUE(network.infer(input, output));
+    ASSERT_EQ(output.size(), expected.size());
+    for (size_t j = 0; j < expected.size(); ++j) {
+        EXPECT_DOUBLE_EQ(output[j], expected[j]);
+    }
+
+    EXPECT_FALSE(network.infer(makeInput(7, 0), output));
+}
+
+TEST(PerceptronTest, InferDoesNotAllocate) {
+    constexpr int iterations = 100;
+    Perceptron network({784, 64, 32, 10});
+    const auto input = makeInput(network.inputSize(), 1);
+
+    // The counter sees allocations made inside the library
+    size_t before = gAllocations.load();
+    network.forward(input);
+    EXPECT_GT(gAllocations.load() - before, 0u);
+
+    // Preallocated workspace and output buffer: nothing to allocate
+    Perceptron::Workspace workspace(network);
+    std::vector<double> output(network.outputSize());
+    bool succeeded = true;
+
+    before = gAllocations.load();
+    for (int i = 0; i < iterations; ++i) {
+        succeeded &= network.infer(input.data(), output.data(), workspace);
+    }
+    EXPECT_EQ(gAllocations.load() - before, 0u);
+
+    // Per-thread workspace: only the first call on this thread may grow it
+    ASSERT_TRUE(network.infer(input, output));
+    before = gAllocations.load();
+    for (int i = 0; i < iterations; ++i) {
+        succeeded &= network.infer(input, output);
+    }
+    EXPECT_EQ(gAllocations.load() - before, 0u);
+
+    EXPECT_TRUE(succeeded);
+}
+
+namespace {
+void makeTrainingSet(size_t aCount, size_t aInputs, size_t aClasses,
+                     std::vector<std::vector<double>>* aInputData,
+                     std::vector<std::vector<double>>* aTargetData) {
+    for (size_t i = 0; i < aCount; ++i) {
+        aInputData->push_back(makeInput(aInputs, i));
+        std::vector<double> target(aClasses, 0.0);
+        target[i % aClasses] = 1.0;
+        aTargetData->push_back(target);
+    }
+}
+
+void expectSameWeights(const Perceptron& aLhs, const Perceptron& aRhs,
+                       double aTolerance) {
+    ASSERT_EQ(aLhs.layers().size(), aRhs.layers().size());
+    for (size_t i = 0; i < aLhs.layers().size(); ++i) {
+        const auto& lhs = aLhs.layers()[i];
+        const auto& rhs = aRhs.layers()[i];
+        ASSERT_EQ(lhs.cweights().size(), rhs.cweights().size());
+        for (size_t k = 0; k < lhs.cweights().size(); ++k) {
+            ASSERT_NEAR(lhs.cweights()[k], rhs.cweights()[k], aTolerance);
+        }
+        for (size_t j = 0; j < lhs.size(); ++j) {
+            ASSERT_NEAR(lhs.cbiases()[j], rhs.cbiases()[j], aTolerance);
+        }
+    }
+}
+}  // namespace
+
+TEST(PerceptronTest, SeedMakesInitializationReproducible) {
+    const std::vector<size_t> architecture = {12, 8, 4};
+
+    Perceptron first(architecture, Neuron::ActivationFunction::SIGMOID, 42);
+    Perceptron second(architecture, Neuron::ActivationFunction::SIGMOID, 42);
+
+    expectSameWeights(first, second, 0.0);
+}
+
+TEST(PerceptronTest, ParallelTrainingIsDeterministic) {
+    const std::vector<size_t> architecture = {16, 12, 4};
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    makeTrainingSet(50, architecture.front(), architecture.back(),
+                    &inputs, &targets);
+
+    TrainingOptions options;
+    options.epochs = 3;
+    options.learningRate = 0.1;
+    options.batchSize = 8;
+    options.threads = 4;
+
+    Perceptron first(architecture, Neuron::ActivationFunction::SIGMOID, 7);
+    Perceptron second(architecture, Neuron::ActivationFunction::SIGMOID, 7);
+    first.train(inputs, targets, options);
+    second.train(inputs, targets, options);
+
+    EXPECT_TRUE(first.isTrained());
+    expectSameWeights(first, second, 0.0);
+}
+
+TEST(PerceptronTest, ParallelTrainingMatchesSingleThread) {
+    const std::vector<size_t> architecture = {16, 12, 4};
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    makeTrainingSet(50, architecture.front(), architecture.back(),
+                    &inputs, &targets);
+
+    TrainingOptions options;
+    options.epochs = 3;
+    options.learningRate = 0.1;
+    options.batchSize = 8;
+
+    Perceptron single(architecture, Neuron::ActivationFunction::SIGMOID, 7);
+    single.train(inputs, targets, options);
+
+    options.threads = 3;
+    Perceptron parallel(architecture, Neuron::ActivationFunction::SIGMOID, 7);
+    parallel.train(inputs, targets, options);
+
+    // Only the order of the gradient sums differs
+    expectSameWeights(single, parallel, 1e-12);
+}
+
+TEST(PerceptronTest, BatchOfOneIsPerSampleTraining) {
+    const std::vector<size_t> architecture = {16, 12, 4};
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    makeTrainingSet(20, architecture.front(), architecture.back(),
+                    &inputs, &targets);
+
+    Perceptron legacy(architecture, Neuron::ActivationFunction::SIGMOID, 3);
+    legacy.train(inputs, targets, 2, 0.05);
+
+    TrainingOptions options;
+    options.epochs = 2;
+    options.learningRate = 0.05;
+    options.threads = 4;  // Ignored, there is nothing to share
+    Perceptron network(architecture, Neuron::ActivationFunction::SIGMOID, 3);
+    network.train(inputs, targets, options);
+
+    expectSameWeights(legacy, network, 0.0);
+}
+
+namespace {
+double meanSquaredError(const Perceptron& aNetwork,
+                        const std::vector<std::vector<double>>& aInputs,
+                        const std::vector<std::vector<double>>& aTargets) {
+    double error = 0.0;
+    std::vector<double> output;
+    for (size_t i = 0; i < aInputs.size(); ++i) {
+        aNetwork.infer(aInputs[i], output);
+        for (size_t j = 0; j < output.size(); ++j) {
+            const double difference = aTargets[i][j] - output[j];
+            error += difference * difference;
+        }
+    }
+    return error / static_cast<double>(aInputs.size());
+}
+}  // namespace
+
+TEST(PerceptronTest, OptimizersReduceError) {
+    const std::vector<size_t> architecture = {16, 12, 4};
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    makeTrainingSet(64, architecture.front(), architecture.back(),
+                    &inputs, &targets);
+
+    for (auto type : {OptimizerType::SGD, OptimizerType::MOMENTUM,
+                      OptimizerType::ADAM}) {
+        Perceptron network(architecture, Neuron::ActivationFunction::SIGMOID,
+                           11);
+        const double initial = meanSquaredError(network, inputs, targets);
+
+        TrainingOptions options;
+        options.epochs = 20;
+        options.learningRate = type == OptimizerType::ADAM ? 0.01 : 0.5;
+        options.batchSize = 8;
+        options.threads = 2;
+        options.optimizer = type;
+        network.train(inputs, targets, options);
+
+        EXPECT_TRUE(network.isTrained());
+        EXPECT_LT(meanSquaredError(network, inputs, targets), initial * 0.8)
+            << optimizerName(type);
+    }
+}
+
+TEST(PerceptronTest, AdamOnSingleSamples) {
+    const std::vector<size_t> architecture = {16, 12, 4};
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    makeTrainingSet(20, architecture.front(), architecture.back(),
+                    &inputs, &targets);
+
+    TrainingOptions options;
+    options.epochs = 2;
+    options.learningRate = 0.01;
+    options.optimizer = OptimizerType::ADAM;
+
+    Perceptron network(architecture, Neuron::ActivationFunction::SIGMOID, 5);
+    network.train(inputs, targets, options);
+
+    EXPECT_TRUE(network.isTrained());
+    for (const auto& layer : network.layers()) {
+        EXPECT_EQ(layer.optimizerState().slotCount, 2u);
+        EXPECT_EQ(layer.optimizerState().step, 2u * inputs.size());
+    }
+}
+
+TEST(PerceptronTest, ReportsProgressPerBatchAndEpoch) {
+    const std::vector<size_t> architecture = {16, 12, 4};
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    makeTrainingSet(50, architecture.front(), architecture.back(),
+                    &inputs, &targets);
+
+    std::vector<TrainingProgress> reports;
+    TrainingOptions options;
+    options.epochs = 2;
+    options.learningRate = 0.1;
+    options.batchSize = 8;
+    options.threads = 2;
+    options.onProgress = [&](const TrainingProgress& aProgress) {
+        reports.push_back(aProgress);
+    };
+
+    Perceptron network(architecture, Neuron::ActivationFunction::SIGMOID, 7);
+    network.train(inputs, targets, options);
+    EXPECT_TRUE(network.isTrained());
+
+    // 7 batches and the end of every epoch
+    ASSERT_EQ(reports.size(), 2u * (7 + 1));
+    for (size_t i = 0; i < reports.size(); ++i) {
+        const TrainingProgress& report = reports[i];
+        const size_t batch = i % 8;
+        EXPECT_EQ(report.epoch, static_cast<int>(i / 8 + 1));
+        EXPECT_EQ(report.epochs, 2);
+        EXPECT_EQ(report.epochSamples, inputs.size());
+        EXPECT_EQ(report.samples, std::min<size_t>((batch + 1) * 8, 50));
+        EXPECT_EQ(report.isEpochDone, batch == 7);
+        EXPECT_GT(report.loss, 0.0);
+        EXPECT_GE(report.samplesPerSecond, 0.0);
+    }
+    EXPECT_EQ(reports[7].samples, inputs.size());
+    EXPECT_LT(reports.back().loss, reports[7].loss);
+}
+
+TEST(PerceptronTest, StopTokenStopsTraining) {
+    const std::vector<size_t> architecture = {16, 12, 4};
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    makeTrainingSet(50, architecture.front(), architecture.back(),
+                    &inputs, &targets);
+
+    std::atomic<bool> stop{false};
+    size_t batches = 0;
+    TrainingOptions options;
+    options.epochs = 5;
+    options.batchSize = 8;
+    options.stopToken = &stop;
+    options.onProgress = [&](const TrainingProgress&) {
+        // Stopped from the third batch on
+        stop = ++batches == 3;
+    };
+
+    Perceptron network(architecture, Neuron::ActivationFunction::SIGMOID, 7);
+    network.train(inputs, targets, options);
+
+    EXPECT_FALSE(network.isTrained());
+    EXPECT_EQ(batches, 3u);
+
+    // Set before training, nothing is trained
+    const Perceptron untrained(architecture,
+                               Neuron::ActivationFunction::SIGMOID, 7);
+    Perceptron stopped(architecture, Neuron::ActivationFunction::SIGMOID, 7);
+    options.onProgress = nullptr;
+    stopped.train(inputs, targets, options);
+    EXPECT_FALSE(stopped.isTrained());
+    expectSameWeights(untrained, stopped, 0.0);
+}
+
+TEST(PerceptronTest, TrainingMetrics) {
+    const std::vector<size_t> architecture = {16, 12, 4};
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    makeTrainingSet(50, architecture.front(), architecture.back(),
+                    &inputs, &targets);
+
+    TrainingOptions options;
+    options.epochs = 2;
+    options.batchSize = 8;
+    options.threads = 2;
+    Perceptron network(architecture, Neuron::ActivationFunction::SIGMOID, 7);
+    network.train(inputs, targets, options);
+    ASSERT_TRUE(network.isTrained());
+
+    const TrainingMetrics& metrics = network.trainingMetrics();
+    if (!TrainingMetrics::kEnabled) {
+        // Compiled out
+        EXPECT_EQ(metrics.samples, 0u);
+        EXPECT_TRUE(metrics.layers.empty());
+        return;
+    }
+
+    EXPECT_EQ(metrics.epochs, 2);
+    EXPECT_EQ(metrics.samples, 2u * inputs.size());
+    EXPECT_EQ(metrics.batches, 2u * 7);
+    EXPECT_GT(metrics.seconds, 0.0);
+    EXPECT_GT(metrics.samplesPerSecond, 0.0);
+    EXPECT_GT(metrics.forwardSeconds, 0.0);
+    EXPECT_GT(metrics.backwardSeconds, 0.0);
+    EXPECT_GT(metrics.updateSeconds, 0.0);
+    EXPECT_LT(metrics.updateSeconds, metrics.seconds);
+
+    ASSERT_EQ(metrics.layers.size(), 2u);
+    EXPECT_EQ(metrics.layers[0].inputs, 16u);
+    EXPECT_EQ(metrics.layers[0].neurons, 12u);
+    EXPECT_EQ(metrics.layers[0].forwardFlops, 2u * 16 * 12 * 100);
+    // Gradients plus the deltas taken back from the 4 outputs
+    EXPECT_EQ(metrics.layers[0].backwardFlops,
+              2u * (16 * 12 + 12 * 4) * 100);
+    EXPECT_EQ(metrics.layers[1].backwardFlops, 2u * 12 * 4 * 100);
+    EXPECT_EQ(metrics.layers[1].updateFlops, 2u * (12 * 4 + 4) * 14);
+}
@@ -0,0 +1,191 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "include/perceptron.hpp"
+#include "include/quantizedperceptron.hpp"
+#include "include/trainingdata.hpp"
+
+namespace {
+constexpr size_t kInputs = 20;
+constexpr size_t kClasses = 3;
+
+// Byte inputs labelled by the closest of kClasses prototypes, with the
+// matching network inputs byte / 255
+struct DataSet {
+    std::vector<std::vector<uint8_t>> bytes;
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    std::vector<size_t> labels;
+};
+
+DataSet makeDataSet(size_t aCount, unsigned aSeed) {
+    std::mt19937 gen(aSeed);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    DataSet result;
+    for (size_t i = 0; i < aCount; ++i) {
+        std::vector<uint8_t> bytes(kInputs);
+        std::vector<double> input(kInputs);
+        for (size_t k = 0; k < kInputs; ++k) {
+            bytes[k] = static_cast<uint8_t>(dist(gen));
+            input[k] = bytes[k] / 255.0;
+        }
+
+        double best = -1.0;
+        size_t label = 0;
+        for (size_t c = 0; c < kClasses; ++c) {
+            double score = 0.0;
+            for (size_t k = c; k < kInputs; k += kClasses) {
+                score += input[k];
+            }
+            if (score > best) {
+                best = score;
+                label = c;
+            }
+        }
+
+        std::vector<double> target(kClasses, 0.0);
+        target[label] = 1.0;
+        result.bytes.push_back(std::move(bytes));
+        result.inputs.push_back(std::move(input));
+        result.targets.push_back(std::move(target));
+        result.labels.push_back(label);
+    }
+
+    return result;
+}
+
+template <typename T>
+size_t argmax(const std::vector<T>& aValues) {
+    return std::distance(aValues.begin(),
+                         std::max_element(aValues.begin(), aValues.end()));
+}
+}  // namespace
+
+TEST(QuantizedPerceptronTest, CloseToDoubleOutputs) {
+    for (auto function : {Neuron::ActivationFunction::SIGMOID,
+                          Neuron::ActivationFunction::RELU}) {
+        const Perceptron network({kInputs, 16, 8, kClasses}, function, 3);
+        const DataSet data = makeDataSet(50, 1);
+        const VectorTrainingData calibration(data.inputs, data.targets);
+
+        QuantizedPerceptron quantized;
+        ASSERT_TRUE(quantized.quantize(network, calibration,
+                                       data.bytes.size()));
+        ASSERT_TRUE(quantized.isConfigured());
+        EXPECT_EQ(quantized.inputSize(), network.inputSize());
+        EXPECT_EQ(quantized.outputSize(), network.outputSize());
+
+        std::vector<std::vector<double>> expected(data.bytes.size());
+        std::vector<std::vector<float>> actual(data.bytes.size());
+        double range = 0.0;
+        for (size_t i = 0; i < data.bytes.size(); ++i) {
+            ASSERT_TRUE(network.infer(data.inputs[i], expected[i]));
+            ASSERT_TRUE(quantized.infer(data.bytes[i], actual[i]));
+            ASSERT_EQ(actual[i].size(), expected[i].size());
+            for (double value : expected[i]) {
+                range = std::max(range, std::fabs(value));
+            }
+        }
+
+        // Every layer rounds to 1/255 of its range, the errors add up
+        // to a few percent of the output range
+        for (size_t i = 0; i < expected.size(); ++i) {
+            for (size_t j = 0; j < expected[i].size(); ++j) {
+                EXPECT_NEAR(actual[i][j], expected[i][j], 0.03 * range);
+            }
+        }
+    }
+}
+
+TEST(QuantizedPerceptronTest, ForwardBatchMatchesInfer) {
+    const Perceptron network({kInputs, 12, kClasses},
+                             Neuron::ActivationFunction::RELU, 5);
+    const DataSet data = makeDataSet(9, 2);
+    const VectorTrainingData calibration(data.inputs, data.targets);
+
+    QuantizedPerceptron quantized;
+    ASSERT_TRUE(quantized.quantize(network, calibration, data.bytes.size()));
+
+    std::vector<uint8_t> batch;
+    for (const auto& bytes : data.bytes) {
+        batch.insert(batch.end(), bytes.begin(), bytes.end());
+    }
+    const auto outputs = quantized.forwardBatch(batch, data.bytes.size());
+    ASSERT_EQ(outputs.size(), data.bytes.size());
+
+    // Integer sums are exact, so both paths agree bit for bit
+    std::vector<float> output;
+    for (size_t i = 0; i < data.bytes.size(); ++i) {
+        ASSERT_TRUE(quantized.infer(data.bytes[i], output));
+        EXPECT_EQ(outputs[i], output);
+    }
+}
+
+TEST(QuantizedPerceptronTest, AccuracyMatchesDoubleEngine) {
+    const DataSet train = makeDataSet(600, 7);
+    const DataSet test = makeDataSet(300, 8);
+
+    TrainingOptions options;
+    options.epochs = 20;
+    options.learningRate = 0.01;
+    options.batchSize = 16;
+    options.optimizer = OptimizerType::ADAM;
+
+    Perceptron network({kInputs, 16, kClasses},
+                       Neuron::ActivationFunction::SIGMOID, 11);
+    network.train(train.inputs, train.targets, options);
+
+    const VectorTrainingData calibration(train.inputs, train.targets);
+    QuantizedPerceptron quantized;
+    ASSERT_TRUE(quantized.quantize(network, calibration, 100));
+
+    size_t doubleCorrect = 0;
+    size_t int8Correct = 0;
+    std::vector<double> expected;
+    std::vector<float> actual;
+    for (size_t i = 0; i < test.bytes.size(); ++i) {
+        ASSERT_TRUE(network.infer(test.inputs[i], expected));
+        ASSERT_TRUE(quantized.infer(test.bytes[i], actual));
+
+        doubleCorrect += argmax(expected) == test.labels[i];
+        int8Correct += argmax(actual) == test.labels[i];
+    }
+
+    EXPECT_GT(doubleCorrect, test.bytes.size() * 8 / 10);
+    EXPECT_LE(std::abs(static_cast<long>(doubleCorrect) -
+                       static_cast<long>(int8Correct)), 6);
+}
+
+TEST(QuantizedPerceptronTest, RejectsBadCalibration) {
+    const Perceptron network({kInputs, 4, kClasses},
+                             Neuron::ActivationFunction::SIGMOID, 1);
+    const DataSet data = makeDataSet(10, 3);
+    const VectorTrainingData calibration(data.inputs, data.targets);
+
+    QuantizedPerceptron quantized;
+    EXPECT_FALSE(quantized.quantize(network, calibration, 0));
+    EXPECT_FALSE(quantized.quantize(network, calibration, 11));
+    EXPECT_FALSE(quantized.quantize(Perceptron(), calibration, 10));
+
+    const Perceptron wider({kInputs + 1, 4, kClasses},
+                           Neuron::ActivationFunction::SIGMOID, 1);
+    EXPECT_FALSE(quantized.quantize(wider, calibration, 10));
+    EXPECT_FALSE(quantized.isConfigured());
+}
+
+TEST(QuantizedPerceptronTest, NotConfigured) {
+    const QuantizedPerceptron network;
+    std::vector<float> output;
+
+    EXPECT_FALSE(network.isConfigured());
+    EXPECT_FALSE(network.infer(std::vector<uint8_t>(4), output));
+    EXPECT_TRUE(network.forwardBatch(std::vector<uint8_t>(4), 1).empty());
+}
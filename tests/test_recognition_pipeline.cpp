@@ -0,0 +1,179 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "include/boundedqueue.hpp"
+#include "include/mnistcsvreader.hpp"
+#include "include/recognitionpipeline.hpp"
+
+namespace {
+using Entries = RecognitionPipeline::Entries;
+using Predictions = RecognitionPipeline::Predictions;
+
+// A header, then aCount lines whose label is i % 10 and whose first pixel
+// is i % 256
+std::string makeCsv(size_t aCount) {
+    std::ostringstream csv;
+    csv << "label,pixels\n";
+    for (size_t i = 0; i < aCount; ++i) {
+        csv << i % 10;
+        for (size_t j = 0; j < MnistCsvDataSet::kMnistImageSize; ++j) {
+            csv << ',' << (j == 0 ? i % 256 : 0);
+        }
+        csv << '\n';
+    }
+    return csv.str();
+}
+
+// "Recognizes" the first pixel, which gives every entry its own answer
+void firstPixel(const Entries& aEntries, Predictions& aPredictions) {
+    for (size_t i = 0; i < aEntries.size(); ++i) {
+        aPredictions[i] = aEntries[i].second[0];
+    }
+}
+}  // namespace
+
+TEST(BoundedQueueTest, KeepsOrderAndDrainsAfterClose) {
+    BoundedQueue<int> queue(3);
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    queue.close();
+
+    EXPECT_FALSE(queue.push(3));
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_EQ(queue.pop(), 2);
+    EXPECT_EQ(queue.pop(), std::nullopt);
+}
+
+TEST(BoundedQueueTest, FullQueueBlocksProducer) {
+    BoundedQueue<int> queue(1);
+    ASSERT_TRUE(queue.push(1));
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] {
+        queue.push(2);
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(pushed);
+    EXPECT_EQ(queue.pop(), 1);
+
+    producer.join();
+    EXPECT_TRUE(pushed);
+    EXPECT_EQ(queue.pop(), 2);
+}
+
+TEST(RecognitionPipelineTest, ResultsKeepStreamOrder) {
+    constexpr size_t kLines = 1000;
+    std::istringstream input(makeCsv(kLines));
+    MnistCsvReader reader(input);
+
+    RecognitionPipeline pipeline(4, 7);
+    std::vector<size_t> labels;
+    std::vector<size_t> predictions;
+    ASSERT_TRUE(pipeline.run(reader,
+        [](const Entries& aEntries, Predictions& aPredictions) {
+            // Uneven work, so batches finish out of order
+            if (aEntries.front().second[0] % 3 == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            firstPixel(aEntries, aPredictions);
+        },
+        [&](const Entries& aEntries, const Predictions& aPredictions) {
+            for (size_t i = 0; i < aEntries.size(); ++i) {
+                labels.push_back(aEntries[i].first);
+                predictions.push_back(aPredictions[i]);
+            }
+        }));
+
+    EXPECT_EQ(pipeline.processed(), kLines);
+    ASSERT_EQ(predictions.size(), kLines);
+    for (size_t i = 0; i < kLines; ++i) {
+        EXPECT_EQ(labels[i], i % 10);
+        EXPECT_EQ(predictions[i], i % 256);
+    }
+}
+
+TEST(RecognitionPipelineTest, StopsAtFirstBadLine) {
+    const std::string tail = makeCsv(5);
+    std::string csv = makeCsv(20);
+    csv += "12,0\n";
+    csv += tail.substr(tail.find('\n') + 1);
+    std::istringstream input(csv);
+    MnistCsvReader reader(input);
+
+    RecognitionPipeline pipeline(2, 8);
+    size_t written = 0;
+    EXPECT_FALSE(pipeline.run(reader, firstPixel,
+        [&](const Entries& aEntries, const Predictions&) {
+            written += aEntries.size();
+        }));
+
+    // Header is line 1, the bad line the 22nd
+    EXPECT_EQ(pipeline.lastError(), "Line 22: Invalid label value: 12");
+    EXPECT_EQ(written, 20u);
+    EXPECT_EQ(pipeline.processed(), 20u);
+}
+
+TEST(RecognitionPipelineTest, BatchesInFlightAreBounded) {
+    std::istringstream input(makeCsv(2000));
+    MnistCsvReader reader(input);
+
+    // The sink is slow, so only the bounded queues stop the reader
+    RecognitionPipeline pipeline(2, 10);
+    std::atomic<size_t> classified{0};
+    size_t written = 0;
+    size_t maxAhead = 0;
+    ASSERT_TRUE(pipeline.run(reader,
+        [&](const Entries& aEntries, Predictions& aPredictions) {
+            firstPixel(aEntries, aPredictions);
+            classified += aEntries.size();
+        },
+        [&](const Entries& aEntries, const Predictions&) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            maxAhead = std::max(maxAhead, classified.load() - written);
+            written += aEntries.size();
+        }));
+
+    EXPECT_EQ(written, 2000u);
+    // Two batches per worker plus one
+    EXPECT_LE(maxAhead, (2 * 2 + 1) * 10u);
+}
+
+TEST(RecognitionPipelineTest, ClassifierErrorsAreRethrown) {
+    std::istringstream input(makeCsv(500));
+    MnistCsvReader reader(input);
+
+    RecognitionPipeline pipeline(3, 16);
+    EXPECT_THROW(pipeline.run(reader,
+        [](const Entries& aEntries, Predictions&) {
+            if (aEntries.front().second[0] >= 100) {
+                throw std::runtime_error("classifier failed");
+            }
+        },
+        [](const Entries&, const Predictions&) {}),
+        std::runtime_error);
+}
+
+TEST(RecognitionPipelineTest, EmptyInput) {
+    for (const std::string csv : {"", "label,pixels\n"}) {
+        std::istringstream input(csv);
+        MnistCsvReader reader(input);
+        RecognitionPipeline pipeline(0, 0);
+        EXPECT_GE(pipeline.threads(), 1u);
+        EXPECT_EQ(pipeline.batchSize(), 1u);
+
+        EXPECT_TRUE(pipeline.run(reader, firstPixel,
+            [](const Entries&, const Predictions&) { FAIL(); }));
+        EXPECT_EQ(pipeline.processed(), 0u);
+    }
+}
@@ -0,0 +1,320 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <future>  // NOLINT(build/c++11)
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "include/microbatcher.hpp"
+#include "include/recognitionserver.hpp"
+
+namespace {
+using Image = MicroBatcher::Image;
+using Scores = MicroBatcher::Scores;
+using namespace std::chrono_literals;  // NOLINT(build/namespaces)
+
+constexpr size_t kImageSize = MnistCsvDataSet::kMnistImageSize;
+constexpr size_t kClasses = 10;
+constexpr char kSocketPath[] = "temp_recognition_server.sock";
+
+// Scores are the first pixels, so every answer can be checked
+std::vector<Scores> firstPixels(const std::vector<Image>& aImages) {
+    std::vector<Scores> scores;
+    for (const auto& image : aImages) {
+        scores.emplace_back(image.begin(), image.begin() + kClasses);
+    }
+    return scores;
+}
+
+// Its first pixels are 0 apart from aDigit, which gets aValue
+Image makeImage(size_t aDigit, uint8_t aValue = 200) {
+    Image image{};
+    image[aDigit] = aValue;
+    return image;
+}
+
+std::string csvLine(const Image& aImage, bool aWithLabel) {
+    std::ostringstream line;
+    if (aWithLabel) {
+        line << "7,";
+    }
+    for (size_t i = 0; i < kImageSize; ++i) {
+        line << (i ? "," : "") << static_cast<int>(aImage[i]);
+    }
+    line << '\n';
+    return line.str();
+}
+
+class Client {
+ public:
+    static Client connectUnix(const std::string& aPath) {
+        Client client(::socket(AF_UNIX, SOCK_STREAM, 0));
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, aPath.c_str(),
+                     sizeof(address.sun_path) - 1);
+        client.connect(reinterpret_cast<sockaddr*>(&address),
+                       sizeof(address));
+        return client;
+    }
+
+    static Client connectTcp(uint16_t aPort) {
+        Client client(::socket(AF_INET, SOCK_STREAM, 0));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(aPort);
+        client.connect(reinterpret_cast<sockaddr*>(&address),
+                       sizeof(address));
+        return client;
+    }
+
+    Client(Client&& aOther) noexcept : m_socket(aOther.m_socket) {
+        aOther.m_socket = -1;
+    }
+
+    ~Client() {
+        if (m_socket >= 0) {
+            ::close(m_socket);
+        }
+    }
+
+    void send(const std::string& aData) {
+        ASSERT_EQ(::send(m_socket, aData.data(), aData.size(), 0),
+                  static_cast<ssize_t>(aData.size()));
+    }
+
+    // Exactly aSize bytes, fewer if the server closed the connection
+    std::string receive(size_t aSize) {
+        std::string data(aSize, '\0');
+        size_t received = 0;
+        while (received < aSize) {
+            const ssize_t bytes = ::recv(m_socket, data.data() + received,
+                                         aSize - received, 0);
+            if (bytes <= 0) {
+                break;
+            }
+            received += static_cast<size_t>(bytes);
+        }
+        data.resize(received);
+        return data;
+    }
+
+    std::string receiveLine() {
+        std::string line;
+        char c = 0;
+        while (::recv(m_socket, &c, 1, 0) == 1 && c != '\n') {
+            line += c;
+        }
+        return line;
+    }
+
+ private:
+    explicit Client(int aSocket) : m_socket(aSocket) {}
+
+    void connect(const sockaddr* aAddress, socklen_t aLength) {
+        if (::connect(m_socket, aAddress, aLength) != 0) {
+            throw std::runtime_error("Unable to connect");
+        }
+    }
+
+    int m_socket;
+};
+
+// Runs a server in the background for the lifetime of the object
+class RunningServer {
+ public:
+    RunningServer(MicroBatcher& aBatcher,  // NOLINT(runtime/references)
+                  RecognitionServer::Format aFormat, bool aUnix)
+        : m_server(aBatcher, aFormat) {
+        m_isListening = aUnix ? m_server.listenUnix(kSocketPath)
+                              : m_server.listenTcp(0);
+        if (m_isListening) {
+            m_result = std::async(std::launch::async,
+                                  [this] { return m_server.serve(); });
+        }
+    }
+
+    ~RunningServer() {
+        stop();
+    }
+
+    bool stop() {
+        if (!m_result.valid()) {
+            return false;
+        }
+        m_server.stop();
+        return m_result.get();
+    }
+
+    bool isListening() const { return m_isListening; }
+    RecognitionServer& server() { return m_server; }
+
+ private:
+    RecognitionServer m_server;
+    bool m_isListening = false;
+    std::future<bool> m_result;
+};
+}  // namespace
+
+TEST(MicroBatcherTest, FullBatchDoesNotWaitForBudget) {
+    MicroBatcher batcher(firstPixels, 4, 10s);
+
+    std::vector<std::future<Scores>> results;
+    for (size_t i = 0; i < 4; ++i) {
+        results.push_back(batcher.submit(makeImage(i)));
+    }
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results[i].wait_for(5s), std::future_status::ready);
+        EXPECT_EQ(results[i].get()[i], 200.0f);
+    }
+    EXPECT_EQ(batcher.batches(), 1u);
+    EXPECT_EQ(batcher.images(), 4u);
+}
+
+TEST(MicroBatcherTest, PartialBatchWaitsForBudget) {
+    MicroBatcher batcher(firstPixels, 64, 30ms);
+
+    const auto start = std::chrono::steady_clock::now();
+    const Scores scores = batcher.submit(makeImage(3)).get();
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 30ms);
+    EXPECT_EQ(scores[3], 200.0f);
+    EXPECT_EQ(batcher.batches(), 1u);
+}
+
+TEST(MicroBatcherTest, ConcurrentRequestsShareBatches) {
+    constexpr size_t kThreads = 8;
+    constexpr size_t kRequests = 40;
+    MicroBatcher batcher(firstPixels, kThreads, 2ms, 2);
+
+    std::vector<std::thread> threads;
+    std::atomic<size_t> wrong{0};
+    for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < kRequests; ++i) {
+                const size_t digit = (t + i) % kClasses;
+                const Scores scores = batcher.submit(makeImage(digit)).get();
+                wrong += scores[digit] != 200.0f;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(wrong, 0u);
+    EXPECT_EQ(batcher.images(), kThreads * kRequests);
+    EXPECT_LT(batcher.batches(), batcher.images());
+}
+
+TEST(MicroBatcherTest, ScorerErrorsFailTheBatch) {
+    MicroBatcher batcher([](const std::vector<Image>&) -> std::vector<Scores> {
+        throw std::runtime_error("scorer failed");
+    }, 2, 1s);
+
+    auto first = batcher.submit(makeImage(0));
+    auto second = batcher.submit(makeImage(1));
+    EXPECT_THROW(first.get(), std::runtime_error);
+    EXPECT_THROW(second.get(), std::runtime_error);
+}
+
+TEST(RecognitionServerTest, CsvOverUnixSocket) {
+    MicroBatcher batcher(firstPixels, 16, 1ms);
+    RunningServer running(batcher, RecognitionServer::Format::CSV, true);
+    ASSERT_TRUE(running.isListening()) << running.server().lastError();
+
+    Client client = Client::connectUnix(kSocketPath);
+    // Pixels only, a MNIST CSV line and a bad line, sent at once
+    client.send(csvLine(makeImage(4), false) +
+                csvLine(makeImage(9, 255), true) + "1,2,3\r\n");
+
+    EXPECT_EQ(client.receiveLine(), "4,0,0,0,0,200,0,0,0,0,0");
+    EXPECT_EQ(client.receiveLine(), "9,0,0,0,0,0,0,0,0,0,255");
+    EXPECT_EQ(client.receiveLine(),
+              "error: Invalid pixel count: expected 784, got 2");
+
+    // The connection stays usable after a bad request
+    client.send(csvLine(makeImage(2), false));
+    EXPECT_EQ(client.receiveLine(), "2,0,0,200,0,0,0,0,0,0,0");
+
+    EXPECT_TRUE(running.stop());
+    EXPECT_EQ(running.server().connections(), 1u);
+}
+
+TEST(RecognitionServerTest, RawOverTcp) {
+    MicroBatcher batcher(firstPixels, 16, 1ms);
+    RunningServer running(batcher, RecognitionServer::Format::RAW, false);
+    ASSERT_TRUE(running.isListening()) << running.server().lastError();
+    ASSERT_NE(running.server().port(), 0);
+
+    Client client = Client::connectTcp(running.server().port());
+    std::string request;
+    for (size_t digit : {1, 5, 8}) {
+        const Image image = makeImage(digit);
+        request.append(image.begin(), image.end());
+    }
+    // Requests may arrive split anywhere
+    client.send(request.substr(0, 1000));
+    client.send(request.substr(1000));
+
+    const std::string reply = client.receive(3 * kClasses * sizeof(float));
+    ASSERT_EQ(reply.size(), 3 * kClasses * sizeof(float));
+    std::vector<float> scores(3 * kClasses);
+    std::memcpy(scores.data(), reply.data(), reply.size());
+    EXPECT_EQ(scores[1], 200.0f);
+    EXPECT_EQ(scores[kClasses + 5], 200.0f);
+    EXPECT_EQ(scores[2 * kClasses + 8], 200.0f);
+    EXPECT_EQ(scores[0], 0.0f);
+}
+
+TEST(RecognitionServerTest, StopClosesOpenConnections) {
+    MicroBatcher batcher(firstPixels, 16, 1ms);
+    RunningServer running(batcher, RecognitionServer::Format::RAW, true);
+    ASSERT_TRUE(running.isListening()) << running.server().lastError();
+
+    Client client = Client::connectUnix(kSocketPath);
+    const Image image = makeImage(0);
+    client.send(std::string(image.begin(), image.end()));
+    EXPECT_EQ(client.receive(kClasses * sizeof(float)).size(),
+              kClasses * sizeof(float));
+
+    EXPECT_TRUE(running.stop());
+    EXPECT_TRUE(client.receive(1).empty());
+}
+
+TEST(RecognitionServerTest, KeepsOtherFilesAndLiveSockets) {
+    MicroBatcher batcher(firstPixels, 16, 1ms);
+    {
+        std::ofstream(kSocketPath) << "not a socket";
+        RecognitionServer server(batcher, RecognitionServer::Format::CSV);
+        EXPECT_FALSE(server.listenUnix(kSocketPath));
+        EXPECT_EQ(server.lastError(),
+                  std::string("File exists and is not a socket: ") +
+                      kSocketPath);
+        std::remove(kSocketPath);
+    }
+
+    RunningServer running(batcher, RecognitionServer::Format::CSV, true);
+    ASSERT_TRUE(running.isListening());
+    RecognitionServer second(batcher, RecognitionServer::Format::CSV);
+    EXPECT_FALSE(second.listenUnix(kSocketPath));
+    EXPECT_EQ(second.lastError(),
+              std::string("Socket is in use: ") + kSocketPath);
+}
@@ -0,0 +1,176 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "include/mnistcsvdataset.hpp"
+#include "include/syntheticmnist.hpp"
+
+namespace {
+using Entry = MnistCsvDataSet::Entry_t;
+using syntheticmnist::Defect;
+
+constexpr char kCsvPath[] = "temp_synthetic_mnist.csv";
+
+std::vector<std::string> lines(const syntheticmnist::Options& aOptions) {
+    std::ostringstream output;
+    EXPECT_TRUE(syntheticmnist::writeCsv(output, aOptions));
+
+    std::vector<std::string> result;
+    std::istringstream input(output.str());
+    for (std::string line; std::getline(input, line);) {
+        result.push_back(line);
+    }
+    return result;
+}
+
+class SyntheticMnistTest : public ::testing::Test {
+ protected:
+    void TearDown() override {
+        std::remove(kCsvPath);
+        std::remove(MnistCsvDataSet::cachePath(kCsvPath).c_str());
+    }
+
+    static void expectRows(const MnistCsvDataSet& aDataSet,
+                           const syntheticmnist::Options& aOptions) {
+        ASSERT_EQ(aDataSet.size(), aOptions.rows);
+        for (size_t i = 0; i < aOptions.rows; ++i) {
+            Entry expected;
+            syntheticmnist::entry(aOptions.seed, i, expected);
+            ASSERT_EQ(aDataSet[i], expected) << "Row " << i;
+        }
+    }
+};
+}  // namespace
+
+TEST_F(SyntheticMnistTest, RowsDependOnSeedAndIndexOnly) {
+    Entry first;
+    Entry again;
+    syntheticmnist::entry(7, 123, first);
+    syntheticmnist::entry(7, 123, again);
+    EXPECT_EQ(first, again);
+
+    Entry other;
+    syntheticmnist::entry(8, 123, other);
+    EXPECT_NE(first, other);
+    syntheticmnist::entry(7, 124, other);
+    EXPECT_NE(first, other);
+
+    std::set<int> labels;
+    for (size_t i = 0; i < 200; ++i) {
+        syntheticmnist::entry(7, i, other);
+        labels.insert(other.first);
+
+        size_t ink = 0;
+        for (auto pixel : other.second) {
+            ink += pixel != 0;
+        }
+        EXPECT_GT(ink, 20u);
+        EXPECT_LT(ink, MnistCsvDataSet::kMnistImageSize / 4);
+    }
+    EXPECT_EQ(labels.size(), 10u);
+}
+
+TEST_F(SyntheticMnistTest, SameSeedWritesSameFile) {
+    syntheticmnist::Options options;
+    options.rows = 50;
+    options.seed = 3;
+
+    const auto written = lines(options);
+    ASSERT_EQ(written.size(), options.rows + 1);
+    EXPECT_EQ(written.front().substr(0, 14), "label,1x1,1x2,");
+    EXPECT_EQ(written.front().substr(written.front().size() - 6), ",28x28");
+    EXPECT_EQ(lines(options), written);
+
+    options.seed = 4;
+    EXPECT_NE(lines(options), written);
+}
+
+TEST_F(SyntheticMnistTest, CsvLoadsAsTheRows) {
+    syntheticmnist::Options options;
+    options.rows = 300;
+    options.seed = 11;
+    ASSERT_TRUE(syntheticmnist::writeCsv(kCsvPath, options));
+
+    const MnistCsvDataSet dataset(kCsvPath, 2);
+    ASSERT_TRUE(dataset.isLoaded()) << dataset.lastError();
+    expectRows(dataset, options);
+}
+
+TEST_F(SyntheticMnistTest, CacheIsMappedInsteadOfTheCsv) {
+    syntheticmnist::Options options;
+    options.rows = 300;
+    options.seed = 12;
+    ASSERT_TRUE(syntheticmnist::writeCsv(kCsvPath, options));
+    ASSERT_TRUE(syntheticmnist::writeCache(kCsvPath, options));
+
+    const MnistCsvDataSet dataset(kCsvPath, 1, true);
+    ASSERT_TRUE(dataset.isLoaded()) << dataset.lastError();
+    EXPECT_TRUE(dataset.isCached());
+    expectRows(dataset, options);
+}
+
+TEST_F(SyntheticMnistTest, EveryDefectFailsParsing) {
+    syntheticmnist::Options options;
+    options.rows = 200;
+    options.malformedRate = 1.0;
+
+    const auto written = lines(options);
+    ASSERT_EQ(written.size(), options.rows + 1);
+
+    std::set<Defect> defects;
+    for (size_t i = 0; i < options.rows; ++i) {
+        const Defect defect = syntheticmnist::defect(options, i);
+        ASSERT_NE(defect, Defect::NONE);
+        defects.insert(defect);
+
+        const std::string& line = written[i + 1];
+        Entry entry;
+        std::string error;
+        EXPECT_FALSE(MnistCsvDataSet::parseLine(
+            line.data(), line.data() + line.size(), entry, error))
+            << "Row " << i;
+        EXPECT_FALSE(error.empty());
+    }
+    EXPECT_EQ(defects.size(), 6u);
+}
+
+TEST_F(SyntheticMnistTest, MalformedRowsLeaveTheOthersAlone) {
+    syntheticmnist::Options clean;
+    clean.rows = 400;
+    syntheticmnist::Options broken = clean;
+    broken.malformedRate = 0.05;
+
+    const auto cleanLines = lines(clean);
+    const auto brokenLines = lines(broken);
+    ASSERT_EQ(brokenLines.size(), cleanLines.size());
+
+    size_t malformed = 0;
+    size_t firstMalformed = broken.rows;
+    for (size_t i = 0; i < broken.rows; ++i) {
+        if (syntheticmnist::defect(broken, i) == Defect::NONE) {
+            EXPECT_EQ(brokenLines[i + 1], cleanLines[i + 1]);
+        } else {
+            firstMalformed = std::min(firstMalformed, i);
+            ++malformed;
+        }
+    }
+    EXPECT_GT(malformed, 5u);
+    EXPECT_LT(malformed, 40u);
+
+    // Loading stops at the first malformed row, the header being line 1
+    ASSERT_TRUE(syntheticmnist::writeCsv(kCsvPath, broken));
+    const MnistCsvDataSet dataset(kCsvPath, 2);
+    EXPECT_FALSE(dataset.isLoaded());
+    EXPECT_EQ(dataset.lastError().rfind(
+                  "Line " + std::to_string(firstMalformed + 2) + ": ", 0),
+              0u) << dataset.lastError();
+
+    EXPECT_FALSE(syntheticmnist::writeCache(kCsvPath, broken));
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2025 Vitalii Shkibtan. All rights reserved.
+
+// Writes synthetic data sets in the MNIST CSV format, see
+// lib/include/syntheticmnist.hpp
+
+#include <boost/program_options.hpp>
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <exception>
+#include <filesystem>  // NOLINT(build/c++17)
+#include <iostream>
+#include <string>
+
+#include "include/mnistcsvreader.hpp"
+#include "include/syntheticmnist.hpp"
+
+namespace po = boost::program_options;
+
+
+int main(int argc, char* argv[]) {
+    syntheticmnist::Options options;
+    std::string output;
+
+    po::options_description description("mnistgen options");
+    description.add_options()
+        ("help,h", "Show help message")
+        ("output,o", po::value<std::string>(&output)->required(),
+            "CSV file to write, - for the standard output")
+        ("rows,n", po::value<size_t>(&options.rows)
+            ->default_value(options.rows), "Number of rows")
+        ("seed,s", po::value<uint32_t>(&options.seed)
+            ->default_value(options.seed),
+            "Seed; the same seed always writes the same rows")
+        ("malformed-rate", po::value<double>(&options.malformedRate)
+            ->default_value(options.malformedRate),
+            "Share of the rows, from 0 to 1, written malformed to exercise "
+            "the error paths of the loaders")
+        ("cache", "Also write the binary cache the data set loads instead "
+            "of the CSV file");
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, description), vm);
+        if (vm.count("help")) {
+            std::cout << description << std::endl;
+            return 0;
+        }
+        po::notify(vm);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n" << description << std::endl;
+        return 1;
+    }
+
+    if (options.malformedRate < 0.0 || options.malformedRate > 1.0) {
+        std::cerr << "The malformed rate must be from 0 to 1" << std::endl;
+        return 1;
+    }
+
+    const bool toStandardOutput = output == MnistCsvReader::kStandardInput;
+    const bool withCache = vm.count("cache") != 0;
+    if (withCache && (toStandardOutput || options.malformedRate > 0.0)) {
+        std::cerr << "Only data sets without malformed rows written to a "
+                     "file can be cached" << std::endl;
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (toStandardOutput) {
+        std::ios::sync_with_stdio(false);
+        if (!syntheticmnist::writeCsv(std::cout, options)) {
+            return 1;
+        }
+        std::cout.flush();
+        return std::cout ? 0 : 1;
+    }
+
+    if (!syntheticmnist::writeCsv(output, options) ||
+        (withCache && !syntheticmnist::writeCache(output, options))) {
+        return 1;
+    }
+
+    const std::chrono::duration<double> seconds =
+        std::chrono::steady_clock::now() - start;
+    std::cout << "Wrote " << options.rows << " rows ("
+              << std::filesystem::file_size(output) << " bytes) to "
+              << output << " in " << seconds.count() << " s" << std::endl;
+    return 0;
+}